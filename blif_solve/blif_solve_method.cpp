@@ -30,6 +30,7 @@ SOFTWARE.
 #include <blif_solve_lib/cnf_dump.h>
 
 // FactorGraph includes
+#include <dd/and_exists_schedule.h>
 #include <dd/dd.h>
 #include <factor_graph/factor_graph.h>
 
@@ -40,6 +41,7 @@ SOFTWARE.
 #include <random>
 #include <algorithm>
 #include <sstream>
+#include <stdexcept>
 
 namespace {
 
@@ -49,13 +51,17 @@ namespace {
   // ClippingAndAbstract
   // An implementation of BlifSolveMethod
   // Computes an under approximation using cudd's Clip logic
+  // With a result size or live node budget, the clipping depth
+  // is deepened from maxDepth while the budget allows it.
   class ClippingAndAbstract:
     public BlifSolveMethod
   {
     public:
-      ClippingAndAbstract(int maxDepth, bool isOverApprox) :
+      ClippingAndAbstract(int maxDepth, bool isOverApprox, int maxResultSize, long nodeLimit) :
         m_maxDepth(maxDepth),
-        m_isOverApprox(isOverApprox)
+        m_isOverApprox(isOverApprox),
+        m_maxResultSize(maxResultSize),
+        m_nodeLimit(nodeLimit)
     { }
 
       bdd_ptr_set solve(BlifFactors const & blifFactors) const override
@@ -65,7 +71,9 @@ namespace {
         bdd_ptr_set funcSet(funcs->cbegin(), funcs->cend());
         auto ddm = blifFactors.getDdManager();
         auto cube = blifFactors.getPiVars();
-        auto result = bdd_clipping_and_exists_multi(ddm, funcSet, cube, m_maxDepth, direction);
+        auto result = (m_maxResultSize > 0 || m_nodeLimit > 0)
+          ? bdd_clipping_and_exists_multi_adaptive(ddm, funcSet, cube, m_maxResultSize, m_nodeLimit, m_maxDepth, direction)
+          : bdd_clipping_and_exists_multi(ddm, funcSet, cube, m_maxDepth, direction);
         bdd_ptr_set resultSet;
         resultSet.insert(result);
         blif_solve_log_bdd(INFO, "Clipping returned bdd", ddm, result);
@@ -75,6 +83,8 @@ namespace {
     private:
       int m_maxDepth;
       bool m_isOverApprox;
+      int m_maxResultSize;
+      long m_nodeLimit;
   }; // end class ClippingAndAbstract
 
   // ***** Class *****
@@ -373,30 +383,34 @@ namespace {
   // ***** Class *****
   // ExactAndAccumulate
   // An implementation for BlifSolveMethod
-  // Uses cudd to conjoin all the factors and then
-  // quantify out the variables
+  // Uses cudd to conjoin all the factors and
+  // quantify out the variables, following an
+  // early quantification schedule
   // *****************
   class ExactAndAccumulate: public BlifSolveMethod
   {
     public:
+      ExactAndAccumulate(int maxClusterSize):
+        m_maxClusterSize(maxClusterSize)
+      { }
+
       bdd_ptr_set solve(BlifFactors const & blif_factors) const override 
       {
         auto manager = blif_factors.getDdManager();
-        auto func = bdd_one(manager);
         bdd_ptr_set result;
-        {
-          auto factors = blif_factors.getFactors();
-          for (auto fi = factors->cbegin(); fi != factors->cend(); ++fi)
-            bdd_and_accumulate(manager, &func, *fi);
-          blif_solve_log_bdd(DEBUG, "Conjunction of factors in partition", manager, func);
-          auto piVars = blif_factors.getPiVars();
-          auto forsome = bdd_forsome(manager, func, piVars);
-          blif_solve_log_bdd(DEBUG, "Quantified result from partition", manager, forsome);
-          result.insert(forsome);
-        }
-        bdd_free(manager, func);
+        auto factors = blif_factors.getFactors();
+        auto piVars = blif_factors.getPiVars();
+        dd::AndExistsScheduleStats stats;
+        auto forsome = dd::andExistsScheduled(manager, *factors, piVars, m_maxClusterSize, &stats);
+        blif_solve_log(INFO, "Conjoined " << factors->size() << " factors in "
+            << stats.numClusters << " clusters, peak bdd size " << stats.peakBddSize);
+        blif_solve_log_bdd(DEBUG, "Quantified result from partition", manager, forsome);
+        result.insert(forsome);
         return result;
       }
+
+    private:
+      int m_maxClusterSize;
   }; // end class ExactAndAccumulate
 
 
@@ -410,13 +424,24 @@ namespace {
   //   to conjoin all the factors
   //   and abstract away all primary input variables
   //   in a single pass
+  // If a time or node limit is given, the single pass
+  //   is only attempted within that budget, and the
+  //   early quantification schedule is used otherwise
+  // The budgeted pass does not decompose the factors into
+  //   independent components, so decomposeComponents
+  //   must not be combined with a limit (see CommandLineOptions)
   // *****************
   class ExactAndAbstractMulti
     : public BlifSolveMethod
   {
     public:
-      ExactAndAbstractMulti(int cacheSize):
-        m_cacheSize(cacheSize)
+      ExactAndAbstractMulti(int cacheSize, bool decomposeComponents,
+                            double timeLimit, long nodeLimit, int maxClusterSize):
+        m_cacheSize(cacheSize),
+        m_decomposeComponents(decomposeComponents),
+        m_timeLimit(timeLimit),
+        m_nodeLimit(nodeLimit),
+        m_maxClusterSize(maxClusterSize)
       { }
 
       bdd_ptr_set solve(BlifFactors const & blif_factors) const override
@@ -426,12 +451,31 @@ namespace {
         bdd_ptr_set factor_set(factors->cbegin(), factors->cend());
         auto cube = blif_factors.getPiVars();
         bdd_ptr_set result;
-        result.insert(bdd_and_exists_multi(manager, factor_set, cube, m_cacheSize));
+        if (m_timeLimit <= 0 && m_nodeLimit <= 0)
+        {
+          result.insert(bdd_and_exists_multi(manager, factor_set, cube, m_cacheSize, m_decomposeComponents));
+          return result;
+        }
+
+        auto start = now();
+        auto budgeted = bdd_and_exists_multi_budgeted(manager, factor_set, cube, m_cacheSize, m_timeLimit, m_nodeLimit);
+        if (budgeted != NULL)
+          result.insert(budgeted);
+        else
+        {
+          blif_solve_log(WARNING, "ExactAndAbstractMulti exceeded its budget after " << duration(start)
+                                  << " sec, falling back to the early quantification schedule");
+          result.insert(dd::andExistsScheduled(manager, *factors, cube, m_maxClusterSize));
+        }
         return result;
       }
 
     private:
       int m_cacheSize;
+      bool m_decomposeComponents;
+      double m_timeLimit;
+      long m_nodeLimit;
+      int m_maxClusterSize;
   };
 
 
@@ -478,14 +522,21 @@ namespace {
 namespace blif_solve
 {
 
-  BlifSolveMethodCptr BlifSolveMethod::createExactAndAccumulate()
+  BlifSolveMethodCptr BlifSolveMethod::createExactAndAccumulate(int maxClusterSize)
   {
-    return std::make_shared<ExactAndAccumulate>();
+    return std::make_shared<ExactAndAccumulate>(maxClusterSize);
   }
 
-  BlifSolveMethodCptr BlifSolveMethod::createExactAndAbstractMulti(int cacheSize)
+  BlifSolveMethodCptr BlifSolveMethod::createExactAndAbstractMulti(
+      int cacheSize,
+      bool decomposeComponents,
+      double timeLimit,
+      long nodeLimit,
+      int maxClusterSize)
   {
-    return std::make_shared<ExactAndAbstractMulti>(cacheSize);
+    if (decomposeComponents && (timeLimit > 0 || nodeLimit > 0))
+      throw std::invalid_argument("ExactAndAbstractMulti cannot decompose components within a time or node limit");
+    return std::make_shared<ExactAndAbstractMulti>(cacheSize, decomposeComponents, timeLimit, nodeLimit, maxClusterSize);
   }
 
   BlifSolveMethodCptr BlifSolveMethod::createFactorGraphApprox(
@@ -512,9 +563,12 @@ namespace blif_solve
     return std::make_shared<False>();
   }
 
-  BlifSolveMethodCptr BlifSolveMethod::createClippingAndAbstract(int clippingDepth, bool isClippingOverApproximated)
+  BlifSolveMethodCptr BlifSolveMethod::createClippingAndAbstract(int clippingDepth,
+                                                                bool isClippingOverApproximated,
+                                                                int clippingMaxSize,
+                                                                long clippingNodeLimit)
   {
-    return std::make_shared<ClippingAndAbstract>(clippingDepth, isClippingOverApproximated);
+    return std::make_shared<ClippingAndAbstract>(clippingDepth, isClippingOverApproximated, clippingMaxSize, clippingNodeLimit);
   }
 
 
@@ -37,8 +37,12 @@ namespace blif_solve {
 
       virtual bdd_ptr_set solve(BlifFactors const & blifFactors) const = 0;
 
-      static Cptr createExactAndAccumulate();
-      static Cptr createExactAndAbstractMulti(int cacheSize);
+      static Cptr createExactAndAccumulate(int maxClusterSize);
+      static Cptr createExactAndAbstractMulti(int cacheSize,
+                                              bool decomposeComponents,
+                                              double timeLimit,
+                                              long nodeLimit,
+                                              int maxClusterSize);
       static Cptr createFactorGraphApprox(int largestSupportSet,
                                           int largestBddSize,
                                           int numConvergence,
@@ -46,7 +50,10 @@ namespace blif_solve {
       static Cptr createAcyclicViaForAll();
       static Cptr createTrue();
       static Cptr createFalse();
-      static Cptr createClippingAndAbstract(int clippingDepth, bool isClippingOverApproximated);
+      static Cptr createClippingAndAbstract(int clippingDepth,
+                                            bool isClippingOverApproximated,
+                                            int clippingMaxSize,
+                                            long clippingNodeLimit);
 
       virtual ~BlifSolveMethod() {}
 
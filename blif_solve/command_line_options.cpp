@@ -26,6 +26,10 @@ SOFTWARE.
 
 #include "command_line_options.h"
 
+#include <dd/and_exists_schedule.h>
+
+#include <stdexcept>
+
 namespace blif_solve {
 
   // *** Constructor ***
@@ -40,10 +44,21 @@ namespace blif_solve {
     largestBddSize(1*1000*1000*1000),
     numConvergence(1),
     clippingDepth(100),
+    clippingMaxSize(0),
+    clippingNodeLimit(0),
     numLoVarsToQuantify(0),
     cacheSize(10*1000),
+    persistentMultiCache(false),
+    decomposeComponents(false),
+    multiTimeLimit(0),
+    multiNodeLimit(0),
+    maxClusterSize(dd::DefaultMaxClusterSize),
+    variableOrdering(dd::VariableOrdering::None),
+    managerOptions(),
+    numThreads(1),
     dotDumpPath(),
     mustCountSolutions(false),
+    countMethod("Exact"),
     blif_file_path()
   {
 
@@ -129,6 +144,20 @@ namespace blif_solve {
           usage("clipping depth missing after --clipping_depth flag");
         clippingDepth = std::atoi(argv[argi]);
       }
+      else if(arg == "--clipping_max_size")
+      {
+        ++argi;
+        if (argi >= argc)
+          usage("number missing after --clipping_max_size flag");
+        clippingMaxSize = std::atoi(argv[argi]);
+      }
+      else if(arg == "--clipping_node_limit")
+      {
+        ++argi;
+        if (argi >= argc)
+          usage("number missing after --clipping_node_limit flag");
+        clippingNodeLimit = std::atol(argv[argi]);
+      }
       else if(arg == "--num_lo_vars_to_quantify")
       {
         ++argi;
@@ -143,15 +172,108 @@ namespace blif_solve {
           usage("number missing after --cache_size");
         cacheSize = std::atoi(argv[argi]);
       }
+      else if (arg == "--multi_time_limit")
+      {
+        ++argi;
+        if (argi >= argc)
+          usage("number of seconds missing after --multi_time_limit");
+        multiTimeLimit = std::atof(argv[argi]);
+      }
+      else if (arg == "--multi_node_limit")
+      {
+        ++argi;
+        if (argi >= argc)
+          usage("number missing after --multi_node_limit");
+        multiNodeLimit = std::atol(argv[argi]);
+      }
+      else if (arg == "--max_cluster_size")
+      {
+        ++argi;
+        if (argi >= argc)
+          usage("number missing after --max_cluster_size");
+        maxClusterSize = std::atoi(argv[argi]);
+      }
+      else if (arg == "--variable_ordering")
+      {
+        ++argi;
+        if (argi >= argc)
+          usage("ordering missing after --variable_ordering");
+        try {
+          variableOrdering = dd::parseVariableOrdering(argv[argi]);
+        } catch (std::invalid_argument const & e) {
+          usage(e.what());
+        }
+      }
+      else if (arg == "--max_memory")
+      {
+        ++argi;
+        if (argi >= argc)
+          usage("memory size missing after --max_memory");
+        try {
+          managerOptions.maxMemory = dd::parseMemorySize(argv[argi]);
+        } catch (std::invalid_argument const & e) {
+          usage(e.what());
+        }
+      }
+      else if (arg == "--dynamic_reordering")
+      {
+        ++argi;
+        if (argi >= argc)
+          usage("reordering missing after --dynamic_reordering");
+        try {
+          managerOptions.reordering = dd::parseDynamicReordering(argv[argi]);
+        } catch (std::invalid_argument const & e) {
+          usage(e.what());
+        }
+      }
+      else if (arg == "--gc_policy")
+      {
+        ++argi;
+        if (argi >= argc)
+          usage("policy missing after --gc_policy");
+        try {
+          managerOptions.gcPolicy = dd::parseGcPolicy(argv[argi]);
+        } catch (std::invalid_argument const & e) {
+          usage(e.what());
+        }
+      }
+      else if (arg == "--threads")
+      {
+        ++argi;
+        if (argi >= argc)
+          usage("number missing after --threads");
+        numThreads = std::atoi(argv[argi]);
+        if (numThreads < 1)
+          usage("expecting a positive number of threads after --threads");
+      }
+      else if("--persistent_multi_cache" == arg)
+      {
+        persistentMultiCache = true;
+      }
+      else if("--decompose_components" == arg)
+      {
+        decomposeComponents = true;
+      }
       else if("--must_count_solutions" == arg)
       {
         mustCountSolutions = true;
       }
+      else if("--count_method" == arg)
+      {
+        ++argi;
+        if (argi >= argc)
+          usage("count method missing after --count_method flag");
+        countMethod = argv[argi];
+      }
       else blif_file_path = arg;
 
       if(blif_file_path.empty())
         usage("blif file path not provided");
     }
+
+    // the budgeted engine of ExactAndAbstractMulti does not decompose
+    if (decomposeComponents && (multiTimeLimit > 0 || multiNodeLimit > 0))
+      usage("--decompose_components cannot be combined with --multi_time_limit / --multi_node_limit");
   }
 
   // *** Function ******
@@ -180,10 +302,35 @@ namespace blif_solve {
               << "\t\t--verbosity v                : set verbosity level to v;\n"
               << "\t\t                               must be one of QUIET/ERROR/WARNING/INFO/DEBUG\n"
               << "\t\t--clipping_depth d           : set depth for clipping approximation\n"
+              << "\t\t--clipping_max_size n        : deepen clipping from d while the result has\n"
+              << "\t\t                               at most n nodes\n"
+              << "\t\t--clipping_node_limit n      : clip wherever the manager has more than n\n"
+              << "\t\t                               live nodes, instead of at depth d\n"
               << "\t\t--cache_size                 : set cache size for custom multi-bdd algorithms\n"
+              << "\t\t--persistent_multi_cache     : share the memo table of the multi-bdd algorithms\n"
+              << "\t\t                               across calls\n"
+              << "\t\t--decompose_components       : split factors into groups with disjoint supports\n"
+              << "\t\t                               in ExactAndAbstractMulti (not with the multi limits)\n"
+              << "\t\t--max_cluster_size           : largest cluster of factors (in bdd nodes) that\n"
+              << "\t\t                               ExactAndAccumulate conjoins before quantifying\n"
+              << "\t\t--variable_ordering o        : static variable order applied to the factors,\n"
+              << "\t\t                               one of none (default) / cluster / force\n"
+              << "\t\t--threads n                  : solve up to n partitions concurrently, largest first,\n"
+              << "\t\t                               each in a manager of its own (default 1)\n"
+              << "\t\t--max_memory m               : memory limit for cudd in bytes, with an optional\n"
+              << "\t\t                               K/M/G suffix (default 0, no limit)\n"
+              << "\t\t--dynamic_reordering r       : reordering done by cudd as the bdds grow, one of\n"
+              << "\t\t                               none (default) / sift / symmsift / groupsift\n"
+              << "\t\t--gc_policy p                : when cudd collects garbage instead of growing its\n"
+              << "\t\t                               tables, one of default / eager / lazy / off\n"
+              << "\t\t--multi_time_limit s         : give up ExactAndAbstractMulti after s seconds, and\n"
+              << "\t\t                               use the ExactAndAccumulate schedule instead\n"
+              << "\t\t--multi_node_limit n         : same, once the manager has more than n live nodes\n"
               << "\t\t--num_lo_vars_to_quantify    : number of lo vars to quantify\n"
               << "\t\t--dot_dump_path ddp          : path to dump dot files (for factor graph visualization\n"
               << "\t\t--must_count_solutions       : whether to count and print the number of solutions\n"
+              << "\t\t--count_method m             : how to count solutions, one of\n"
+              << "\t\t                               Exact (default) / Log (log2 estimate) / LongDouble\n"
               << "\tAvailable solve methods: ExactAndAccumulate/ExactAndAbstractMulti/FactorGraphApprox/\n"
               << "\t                         FactorGraphExact/AcyclicViaForAll/True/False/\n"
               << "\t                         ClippingOverApprox/ClippingUnderApprox"
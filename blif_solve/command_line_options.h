@@ -29,6 +29,8 @@ SOFTWARE.
 #include <string>
 #include <iostream>
 #include <blif_solve_lib/log.h>
+#include <dd/manager_factory.h>
+#include <dd/variable_order.h>
 
 namespace blif_solve {
   
@@ -53,16 +55,38 @@ namespace blif_solve {
     int numConvergence;
     // maximum depth to use while clipping
     int clippingDepth;
+    // result size and live node budget for clipping,
+    // non-positive for a fixed clipping depth
+    int clippingMaxSize;
+    long clippingNodeLimit;
     // number of latch output variables to existentially quantify
     int numLoVarsToQuantify;
     // cache size for multi-bdd algorithms
     int cacheSize;
+    // whether the multi-bdd algorithms share one memo table across calls
+    bool persistentMultiCache;
+    // whether ExactAndAbstractMulti splits factors into independent components
+    bool decomposeComponents;
+    // time (sec) and live node budget for ExactAndAbstractMulti,
+    // non-positive for no budget
+    double multiTimeLimit;
+    long multiNodeLimit;
+    // largest allowed cluster size (in bdd nodes) for ExactAndAccumulate
+    int maxClusterSize;
+    // static variable order applied after the factors are created
+    dd::VariableOrdering variableOrdering;
+    // memory limit, dynamic reordering and gc policy of the manager
+    dd::ManagerOptions managerOptions;
+    // number of partitions solved concurrently, each in a manager of its own
+    int numThreads;
 
     // path to dump dot files (for factor graph visualization)
     std::string dotDumpPath;
 
     // whether to count and print the number of solutions
     bool mustCountSolutions;
+    // how to count solutions: Exact/Log/LongDouble
+    std::string countMethod;
 
     std::string blif_file_path;
 
@@ -0,0 +1,189 @@
+/*
+
+Copyright 2019 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+// blif_solve includes
+#include "divide_and_conquer.h"
+
+// dd includes
+#include <dd/cuddAndAbsMulti.h>
+#include <dd/manager_factory.h>
+#include <dd/support_cache.h>
+#include <dd/thread_pool.h>
+#include <dd/variable_order.h>
+
+// std includes
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+  // ***** Class *****
+  // A manager of a worker thread of solveConcurrently,
+  //   with the variables in the given order, along with
+  //   the results of the partitions solved in it.
+  // Quits the manager on destruction, so that the workers
+  //   are released even if solving or transferring throws.
+  // *****************
+  class Worker
+  {
+    public:
+      Worker(blif_solve::CommandLineOptions const & clo, std::vector<int> const & variableOrder) :
+        manager(dd::createManager(clo.managerOptions)),
+        results(),
+        m_supportCacheScope()
+      {
+        try {
+          dd::applyVariableOrder(manager, variableOrder);
+          if (clo.persistentMultiCache && !Cudd_MultiCacheEnable(manager, clo.cacheSize))
+            throw std::runtime_error("Could not enable the persistent multi cache");
+          m_supportCacheScope = std::make_unique<dd::SupportCacheScope>(manager);
+        } catch (...) {
+          Cudd_MultiCacheDisable(manager);
+          Cudd_Quit(manager);
+          throw;
+        }
+      }
+
+      ~Worker()
+      {
+        for (auto r: results)
+          bdd_free(manager, r);
+        m_supportCacheScope.reset();
+        Cudd_MultiCacheDisable(manager);
+        Cudd_Quit(manager);
+      }
+
+      Worker(Worker const &) = delete;
+      Worker & operator=(Worker const &) = delete;
+
+      DdManager * const manager;
+      std::vector<bdd_ptr> results;
+
+    private:
+      std::unique_ptr<dd::SupportCacheScope> m_supportCacheScope;
+  };
+
+} // end anonymous namespace
+
+namespace blif_solve {
+
+  // ***** Function *****
+  // solves the partitions one after the other,
+  //   or concurrently with --threads (see solveConcurrently)
+  // ********************
+  bdd_ptr_set divideAndConquer(BlifFactors::PtrVec const & partitions,
+                               BlifSolveMethod::Cptr const & method,
+                               CommandLineOptions const & clo)
+  {
+    blif_solve_log(INFO, "processing " << partitions.size() << " partitions");
+    if (clo.numThreads > 1 && partitions.size() > 1)
+      return solveConcurrently(partitions, method, clo);
+    bdd_ptr_set result;
+    for (auto partition: partitions)
+    {
+      bdd_ptr_set subresult = method->solve(*partition);
+      result.insert(subresult.begin(), subresult.end());
+    }
+    return result;
+  }
+
+
+
+  // ***** Function *****
+  // Hands the partitions out to clo.numThreads workers, largest first
+  //   (see the declaration for details)
+  // ********************
+  bdd_ptr_set solveConcurrently(BlifFactors::PtrVec const & partitions,
+                                BlifSolveMethod::Cptr const & method,
+                                CommandLineOptions const & clo)
+  {
+    auto start = now();
+    DdManager * mainManager = partitions.front()->getDdManager();
+
+    // largest first, so that the small partitions fill in at the end
+    std::vector<std::pair<size_t, size_t> > sizeAndIndex;
+    for (size_t i = 0; i < partitions.size(); ++i)
+      sizeAndIndex.emplace_back(dd::sharedSize(*partitions[i]->getFactors()), i);
+    std::stable_sort(sizeAndIndex.begin(), sizeAndIndex.end(),
+                     [](std::pair<size_t, size_t> const & a, std::pair<size_t, size_t> const & b) { return a.first > b.first; });
+
+    // declared before the pool, so that the pool is joined before the workers quit
+    std::vector<std::unique_ptr<Worker> > workers;
+    auto variableOrder = dd::currentVariableOrder(mainManager);
+    size_t numWorkers = std::min(size_t(clo.numThreads), partitions.size());
+    for (size_t i = 0; i < numWorkers; ++i)
+      workers.push_back(std::make_unique<Worker>(clo, variableOrder));
+
+    // solve
+    std::atomic<size_t> next(0);
+    {
+      parakram::ThreadPool pool(static_cast<int>(workers.size()));
+      std::vector<std::future<void> > done;
+      for (auto & worker: workers)
+      {
+        done.push_back(pool.submit([&, w = worker.get()]() {
+          for (size_t i = next++; i < sizeAndIndex.size(); i = next++)
+          {
+            auto partition = partitions[sizeAndIndex[i].second]->transferTo(w->manager);
+            auto subresult = method->solve(*partition);
+            w->results.insert(w->results.end(), subresult.begin(), subresult.end());
+          }
+        }));
+      }
+      for (auto & d: done)
+        d.get();
+    }
+
+    // copy the results back, the workers are released on return
+    bdd_ptr_set result;
+    try {
+      for (auto & worker: workers)
+      {
+        for (auto r: worker->results)
+        {
+          bdd_ptr copy = Cudd_bddTransfer(worker->manager, mainManager, r);
+          if (copy == NULL)
+            throw std::runtime_error("Could not transfer a partition result back to the main manager");
+          Cudd_Ref(copy);
+          if (!result.insert(copy).second)
+            bdd_free(mainManager, copy);
+        }
+      }
+    } catch (...) {
+      for (auto r: result)
+        bdd_free(mainManager, r);
+      throw;
+    }
+    blif_solve_log(DEBUG, "solved " << partitions.size() << " partitions on "
+                          << workers.size() << " threads in " << duration(start) << " sec");
+    return result;
+  }
+
+} // end namespace blif_solve
@@ -0,0 +1,56 @@
+/*
+
+Copyright 2019 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#pragma once
+
+#include "blif_solve_method.h"
+#include "command_line_options.h"
+
+#include <dd/dd.h>
+
+namespace blif_solve {
+
+  // ***** Function *****
+  // solves the partitions one after the other,
+  //   or concurrently with --threads (see solveConcurrently)
+  // ********************
+  bdd_ptr_set divideAndConquer(BlifFactors::PtrVec const & partitions,
+                               BlifSolveMethod::Cptr const & method,
+                               CommandLineOptions const & clo);
+
+  // ***** Function *****
+  // Hands the partitions out to clo.numThreads workers, largest first,
+  //   each worker having a manager of its own with the variables in the
+  //   same order as the main manager.
+  // The workers copy their partitions in with Cudd_bddTransfer, which only
+  //   reads the main manager (and nothing else touches it meanwhile),
+  //   and the results are copied back once all the workers are done.
+  // The worker managers are released whether or not a worker throws.
+  // ********************
+  bdd_ptr_set solveConcurrently(BlifFactors::PtrVec const & partitions,
+                                BlifSolveMethod::Cptr const & method,
+                                CommandLineOptions const & clo);
+
+} // end namespace blif_solve
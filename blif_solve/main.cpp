@@ -28,12 +28,18 @@ SOFTWARE.
 // std includes
 #include <iostream>
 #include <memory>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 
 // dd includes
+#include <dd/cuddAndAbsMulti.h>
 #include <dd/dd.h>
+#include <dd/manager_factory.h>
+#include <dd/multi_cache_scope.h>
 #include <dd/ntr.h>
+#include <dd/support_cache.h>
+#include <dd/variable_order.h>
 
 // factor_graph includes
 #include <factor_graph/srt.h>
@@ -48,17 +54,17 @@ SOFTWARE.
 
 // blif_solve includes
 #include "command_line_options.h"
+#include "divide_and_conquer.h"
 
 
 // function declarations
 int                             main                 (int argc, char ** argv);
 blif_solve::BlifSolveMethodCptr createBlifSolveMethod(std::string const & bsmStr,
                                                       blif_solve::CommandLineOptions const & clo);
-long double                     getNumSolutions      (DdManager * ddm,
+std::string                     getNumSolutions      (DdManager * ddm,
                                                       bdd_ptr_set const & bdd,
-                                                      int numVars);
-bdd_ptr_set                     divideAndConquer     (blif_solve::BlifFactors::PtrVec const & partitions,
-                                                      blif_solve::BlifSolveMethod::Cptr const & method);
+                                                      int numVars,
+                                                      std::string const & countMethod);
 
 
 using blif_solve::now;
@@ -89,6 +95,11 @@ int main(int argc, char ** argv)
     
     // init cudd
     auto srt = std::make_shared<SRT>();
+    dd::configureManager(srt->ddm, clo->managerOptions);
+    std::unique_ptr<dd::PersistentMultiCacheScope> multiCacheScope;
+    if (clo->persistentMultiCache)
+      multiCacheScope = std::make_unique<dd::PersistentMultiCacheScope>(srt->ddm, clo->cacheSize);
+    dd::SupportCacheScope supportCacheScope(srt->ddm);
     
    
 
@@ -98,6 +109,7 @@ int main(int argc, char ** argv)
     blif_solve_log(DEBUG, "parsed blif file in " << duration(start) << " sec");
     start = now();
     blifFactors->createBdds();
+    blifFactors->orderVariables(clo->variableOrdering);
     int const numPiVars = Cudd_SupportSize(blifFactors->getDdManager(), blifFactors->getPiVars());
     int const numNonPiVars = blifFactors->getNonPiVars()->size();
     blif_solve_log(INFO, "created " << blifFactors->getFactors()->size() << " factors with "
@@ -115,13 +127,13 @@ int main(int argc, char ** argv)
       blif_solve_log(INFO, "Executing over approximating method " << clo->overApproximatingMethod);
       start = now();
       auto upperMethod = createBlifSolveMethod(clo->overApproximatingMethod, *clo);
-      upperLimit = divideAndConquer(partitions, upperMethod);
+      upperLimit = blif_solve::divideAndConquer(partitions, upperMethod, *clo);
       blif_solve_log(INFO, "Finished over approximating method " 
                            << clo->overApproximatingMethod << " in " 
                            << duration(start) << " sec");
       if(clo->mustCountSolutions)
         blif_solve_log(INFO, "Over approximating method " << clo->overApproximatingMethod
-                             << " finished with " << getNumSolutions(srt->ddm, upperLimit, numNonPiVars)
+                             << " finished with " << getNumSolutions(srt->ddm, upperLimit, numNonPiVars, clo->countMethod)
                              << " solutions.");
     }
 
@@ -134,12 +146,12 @@ int main(int argc, char ** argv)
       blif_solve_log(INFO, "Executing under approximating method " << clo->underApproximatingMethod);
       start = now();
       auto lowerMethod = createBlifSolveMethod(clo->underApproximatingMethod, *clo);
-      lowerLimit = divideAndConquer(partitions, lowerMethod);
+      lowerLimit = blif_solve::divideAndConquer(partitions, lowerMethod, *clo);
       blif_solve_log(INFO, "Finished under approximating method " << clo->underApproximatingMethod
                            << " in " << duration(start) << " sec");
       if (clo->mustCountSolutions)
         blif_solve_log(INFO, "Under approximating method " << clo->underApproximatingMethod
-                             << " finished with " << getNumSolutions(srt->ddm, lowerLimit, numNonPiVars)
+                             << " finished with " << getNumSolutions(srt->ddm, lowerLimit, numNonPiVars, clo->countMethod)
                              << " solutions.");
     }
 
@@ -165,6 +177,21 @@ int main(int argc, char ** argv)
       bdd_free(blifFactors->getDdManager(), *uli);
     for (auto lli = lowerLimit.cbegin(); lli != lowerLimit.cend(); ++lli)
       bdd_free(blifFactors->getDdManager(), *lli);
+
+    // report the persistent multi cache
+    Cudd_MultiCacheStats cacheStats;
+    if (Cudd_MultiCacheReadStats(srt->ddm, &cacheStats))
+      blif_solve_log(INFO, "Persistent multi cache: "
+                           << cacheStats.andHits << " hits / " << cacheStats.andLookups << " lookups (and), "
+                           << cacheStats.countHits << " hits / " << cacheStats.countLookups << " lookups (count), "
+                           << cacheStats.hookFlushes << " flushes on gc/reordering");
+    dd::SupportCacheStats supportStats;
+    if (dd::readSupportCacheStats(srt->ddm, &supportStats))
+      blif_solve_log(DEBUG, "Support cache: "
+                            << supportStats.hits << " hits / " << supportStats.lookups << " lookups, "
+                            << supportStats.hookFlushes << " flushes on gc/reordering, "
+                            << supportStats.fullFlushes << " flushes on reaching capacity");
+    blif_solve_log(INFO, "Cudd: " << dd::readManagerStats(srt->ddm));
    
   } catch (std::exception const & e)
   {
@@ -188,9 +215,14 @@ int main(int argc, char ** argv)
 blif_solve::BlifSolveMethodCptr createBlifSolveMethod(std::string const & bsmStr, blif_solve::CommandLineOptions const & clo)
 {
   if ("ExactAndAccumulate" == bsmStr)
-    return blif_solve::BlifSolveMethod::createExactAndAccumulate();
+    return blif_solve::BlifSolveMethod::createExactAndAccumulate(clo.maxClusterSize);
   else if ("ExactAndAbstractMulti" == bsmStr)
-    return blif_solve::BlifSolveMethod::createExactAndAbstractMulti(clo.cacheSize);
+    return blif_solve::BlifSolveMethod::createExactAndAbstractMulti(
+        clo.cacheSize,
+        clo.decomposeComponents,
+        clo.multiTimeLimit,
+        clo.multiNodeLimit,
+        clo.maxClusterSize);
   else if ("FactorGraphApprox" == bsmStr)
     return blif_solve::BlifSolveMethod::createFactorGraphApprox(
         clo.largestSupportSet,
@@ -204,9 +236,9 @@ blif_solve::BlifSolveMethodCptr createBlifSolveMethod(std::string const & bsmStr
   else if ("False" == bsmStr)
     return blif_solve::BlifSolveMethod::createFalse();
   else if ("ClippingOverApprox" == bsmStr)
-    return blif_solve::BlifSolveMethod::createClippingAndAbstract(clo.clippingDepth, true);
+    return blif_solve::BlifSolveMethod::createClippingAndAbstract(clo.clippingDepth, true, clo.clippingMaxSize, clo.clippingNodeLimit);
   else if ("ClippingUnderApprox" == bsmStr)
-    return blif_solve::BlifSolveMethod::createClippingAndAbstract(clo.clippingDepth, false);
+    return blif_solve::BlifSolveMethod::createClippingAndAbstract(clo.clippingDepth, false, clo.clippingMaxSize, clo.clippingNodeLimit);
   else if (bsmStr == "FactorGraphExact")
     throw std::runtime_error("BlifSolveMethod for '" + bsmStr + "' not yet implemented.");
   else
@@ -216,22 +248,17 @@ blif_solve::BlifSolveMethodCptr createBlifSolveMethod(std::string const & bsmStr
 }
 
 
-long double getNumSolutions(DdManager * manager, bdd_ptr_set const & bdds, int numVars)
-{
-  auto numSln = bdd_count_minterm_multi(manager, bdds, numVars, 100*1000);
-  return numSln;
-}
-
-
-bdd_ptr_set divideAndConquer(blif_solve::BlifFactors::PtrVec const & partitions,
-                             blif_solve::BlifSolveMethod::Cptr const & method)
+std::string getNumSolutions(DdManager * manager, bdd_ptr_set const & bdds, int numVars, std::string const & countMethod)
 {
-  bdd_ptr_set result;
-  blif_solve_log(INFO, "processing " << partitions.size() << " partitions");
-  for (auto partition: partitions)
-  {
-    bdd_ptr_set subresult = method->solve(*partition);
-    result.insert(subresult.begin(), subresult.end());
-  }
-  return result;
+  std::stringstream result;
+  if ("Exact" == countMethod)
+    result << bdd_exact_count_minterm_multi(manager, bdds, numVars, 100*1000);
+  else if ("Log" == countMethod)
+    result << "2^" << bdd_log_count_minterm_multi(manager, bdds, numVars, 100*1000);
+  else if ("LongDouble" == countMethod)
+    result << bdd_count_minterm_multi(manager, bdds, numVars, 100*1000);
+  else
+    throw std::runtime_error("Invalid count method '" + countMethod + "', "
+        "expecting one of Exact/Log/LongDouble");
+  return result.str();
 }
@@ -27,6 +27,7 @@ SOFTWARE.
 
 #include <dd/disjoint_set.h>
 #include <dd/max_heap.h>
+#include <dd/support_cache.h>
 
 #include <list>
 #include <stdexcept>
@@ -48,6 +49,7 @@ namespace {
     DdManager * manager;
     bdd_ptr node;
     bdd_ptr supportSet;
+    dd::VarSet supportVarSet;
     std::list<AmNode *> neighbours;
     std::list<AmMerger *> mergers;
     std::string name;
@@ -56,7 +58,8 @@ namespace {
       type(v_type),
       manager(v_manager),
       node(bdd_dup(v_node)),
-      supportSet(v_type == Func ? bdd_support(v_manager, v_node) : v_node),
+      supportSet(v_type == Func ? dd::supportCube(v_manager, v_node) : v_node),
+      supportVarSet(dd::VarSet::fromCube(v_manager, supportSet)),
       neighbours(),
       mergers(),
       name(v_name)
@@ -64,11 +67,7 @@ namespace {
 
     bool isConnectedTo(const AmNode & that) const
     {
-      bdd_ptr supportSetIntersection = bdd_cube_intersection(manager, this->supportSet, that.supportSet);
-      bool result = !bdd_is_one(manager,supportSetIntersection);
-      bdd_free(manager, supportSetIntersection);
-      return result;
-
+      return supportVarSet.intersects(that.supportVarSet);
     }
 
     ~AmNode()
@@ -159,10 +158,9 @@ namespace {
 #endif
       return std::optional<double>();
     }
-    auto manager = f1->manager;
-    auto combinedSupportSet = bdd_cube_union(manager, f1->supportSet, f2->supportSet);
-    int unionSize = bdd_size(combinedSupportSet);
-    bdd_free(manager, combinedSupportSet);
+    // sizes are in bdd nodes of the support cubes,
+    // i.e. the number of variables plus one for the constant node
+    int unionSize = f1->supportVarSet.unionSize(f2->supportVarSet) + 1;
     if (unionSize > largestSupportSet)
     {
 #ifdef DEBUG_MERGE
@@ -173,11 +171,9 @@ namespace {
 #ifdef DEBUG_MERGE
     std::cout << "merging " << f1 << " and " << f2 << std::endl;
 #endif
-    auto commonSupportSet = bdd_cube_intersection(manager, f1->supportSet, f2->supportSet);
-    double commonSize = bdd_size(commonSupportSet);
-    bdd_free(manager, commonSupportSet);
-    double f1Size = bdd_size(f1->supportSet);
-    double f2Size = bdd_size(f2->supportSet);
+    double commonSize = f1->supportVarSet.intersectionSize(f2->supportVarSet) + 1;
+    double f1Size = f1->supportVarSet.size() + 1;
+    double f2Size = f2->supportVarSet.size() + 1;
     return commonSize / std::min(f1Size, f2Size) + hint;
   }
 
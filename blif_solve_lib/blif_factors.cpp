@@ -31,6 +31,7 @@ SOFTWARE.
 #include <cuddInt.h>
 
 #include <set>
+#include <stdexcept>
 
 // local function definitions
 namespace {
@@ -285,6 +286,21 @@ namespace blif_solve {
 
 
 
+  void BlifFactors::orderVariables(dd::VariableOrdering ordering)
+  {
+    if (!m_factors)
+      throw std::logic_error("BlifFactors::orderVariables called before BlifFactors::createBdds");
+    if (ordering == dd::VariableOrdering::None)
+      return;
+    size_t const nodesBefore = dd::sharedSize(*m_factors);
+    auto stats = dd::orderVariables(m_ddm, dd::VariableHypergraph::fromSupports(m_ddm, *m_factors), ordering);
+    blif_solve_log(INFO, "Applied " << dd::toString(ordering) << " variable order in " << stats.seconds << " sec: "
+                         << "factor span " << stats.spanBefore << " -> " << stats.spanAfter << ", "
+                         << "factor bdds " << nodesBefore << " -> " << dd::sharedSize(*m_factors) << " nodes");
+  }
+
+
+
   BlifFactors::PtrVec BlifFactors::partitionFactors() const
   {
     std::vector<std::vector<bdd_ptr>> partitions = bddPartition(m_ddm, *m_factors);
@@ -328,6 +344,26 @@ namespace blif_solve {
 
 
 
+  std::shared_ptr<BlifFactors> BlifFactors::transferTo(DdManager * destination) const
+  {
+    auto transfer = [&](bdd_ptr f) {
+      bdd_ptr result = Cudd_bddTransfer(m_ddm, destination, f);
+      if (result == NULL)
+        throw std::runtime_error("Could not transfer bdd to another manager");
+      Cudd_Ref(result);
+      return result;
+    };
+    auto factors = std::make_shared<std::vector<bdd_ptr> >();
+    for (auto factor: *m_factors)
+      factors->push_back(transfer(factor));
+    auto nonPiVars = std::make_shared<std::vector<bdd_ptr> >();
+    for (auto nonPiVar: *m_nonPiVars)
+      nonPiVars->push_back(transfer(nonPiVar));
+    return std::shared_ptr<BlifFactors>(new BlifFactors(NULL, destination, factors, transfer(m_piVars), nonPiVars));
+  }
+
+
+
 
   // accessors
   BlifFactors::FactorVec BlifFactors::getFactors() const
@@ -28,6 +28,7 @@ SOFTWARE.
 
 #include <dd/bnet.h>
 #include <dd/dd.h>
+#include <dd/variable_order.h>
 
 #include <vector>
 #include <string>
@@ -60,11 +61,28 @@ namespace blif_solve {
       //   accessor methods in this class.
       void createBdds();
 
+      // ****** Function ******
+      // shuffle the variables of the manager into a static order
+      //   computed from the supports of the factors,
+      //   and log the resulting change in the factor bdd sizes
+      // Pre-requisite: createBdds() must be called
+      void orderVariables(dd::VariableOrdering ordering);
+
       // ****** Function ******
       // partitions this problem into many disconnected
       //   sub-problems
       PtrVec partitionFactors() const;
 
+      // ****** Function ******
+      // copy the factors, pi variables and non-pi variables
+      //   into another manager (see Cudd_bddTransfer),
+      //   so that the copy can be solved on another thread
+      // Pre-requisite: the destination must have the variables
+      //   of this manager, in the same order (see dd::applyVariableOrder)
+      // Note: only reads this manager, so several threads can
+      //   transfer from it at once, as long as nothing modifies it
+      std::shared_ptr<BlifFactors> transferTo(DdManager * destination) const;
+
       // ****** Accessor Function ******
       // return the factors described in the circuit
       // Pre-requisite: createBdds() must be called
@@ -53,11 +53,7 @@ int main(int argc, char const * const * const argv)
 
   // parse input file
   std::string inputFile = argv[1];
-  std::shared_ptr<dd::Qdimacs> qdimacs;
-  {
-    std::ifstream inputReader(inputFile);
-    qdimacs = dd::Qdimacs::parseQdimacs(inputReader);
-  }
+  std::shared_ptr<dd::Qdimacs> qdimacs = dd::Qdimacs::parseQdimacsFile(inputFile);
   
 
 
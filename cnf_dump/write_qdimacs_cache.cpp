@@ -0,0 +1,56 @@
+/*
+
+Copyright 2026 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+#include <dd/qdimacs.h>
+
+#include <iostream>
+#include <string>
+
+int main(int argc, char const * const * const argv)
+{
+  // check cli usage
+  if (argc < 2)
+  {
+    std::cout << "Program to write the binary sidecar cache of qdimacs files.\n"
+      << "The cache of <file> is written to <file>" << dd::FlatQdimacs::cachePath("") << ",\n"
+      << "  and is picked up by every tool that reads <file>\n"
+      << "  for as long as <file> is not modified.\n"
+      << "Usage:\n\t" << argv[0] << " <input qdimacs file> [<input qdimacs file> ...]"
+      << std::endl;
+    return 0;
+  }
+
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string inputFile = argv[i];
+    auto qdimacs = dd::FlatQdimacs::parseFileAndWriteCache(inputFile);
+    std::cout << "Wrote " << dd::FlatQdimacs::cachePath(inputFile) << " ("
+      << qdimacs->numClauses() << " clauses, " << qdimacs->literals.size() << " literals)" << std::endl;
+  }
+
+  return 0;
+}
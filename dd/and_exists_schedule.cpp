@@ -0,0 +1,207 @@
+/*
+
+Copyright 2026 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "and_exists_schedule.h"
+#include "support_cache.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace {
+
+  // order in which the factors are to be conjoined:
+  // repeatedly pick the quantified variable that occurs in the fewest
+  // factors not yet scheduled, and schedule all of those factors
+  std::vector<int> scheduleFactors(
+      std::vector<std::vector<int> > const & quantifiedSupports,
+      std::vector<std::vector<int> > const & varToFactors)
+  {
+    auto numFactors = quantifiedSupports.size();
+    std::vector<int> order;
+    order.reserve(numFactors);
+    std::vector<char> isScheduled(numFactors, 0);
+    std::vector<char> isEliminated(varToFactors.size(), 0);
+    std::vector<int> numPending(varToFactors.size(), 0);
+
+    // min-heap on the number of pending factors;
+    // stale entries are skipped when popped
+    typedef std::pair<int, int> CountAndVar;
+    std::priority_queue<CountAndVar, std::vector<CountAndVar>, std::greater<CountAndVar> > heap;
+    for (size_t v = 0; v < varToFactors.size(); ++v)
+    {
+      numPending[v] = varToFactors[v].size();
+      if (numPending[v] > 0)
+        heap.push(CountAndVar(numPending[v], v));
+    }
+
+    while (!heap.empty())
+    {
+      auto top = heap.top();
+      heap.pop();
+      int v = top.second;
+      if (isEliminated[v] || top.first != numPending[v])
+        continue;
+      isEliminated[v] = 1;
+      for (auto fi: varToFactors[v])
+      {
+        if (isScheduled[fi])
+          continue;
+        isScheduled[fi] = 1;
+        order.push_back(fi);
+        for (auto u: quantifiedSupports[fi])
+        {
+          if (isEliminated[u])
+            continue;
+          --numPending[u];
+          heap.push(CountAndVar(numPending[u], u));
+        }
+      }
+    }
+
+    // factors without quantified variables go last
+    for (size_t fi = 0; fi < numFactors; ++fi)
+      if (!isScheduled[fi])
+        order.push_back(fi);
+    return order;
+  }
+
+} // end anonymous namespace
+
+
+
+namespace dd
+{
+
+  bdd_ptr andExistsScheduled(DdManager * manager,
+                             std::vector<bdd_ptr> const & factors,
+                             bdd_ptr cube,
+                             int maxClusterSize,
+                             AndExistsScheduleStats * stats)
+  {
+    // mark the quantified variables
+    std::vector<char> isQuantified(Cudd_ReadSize(manager), 0);
+    for (auto v: supportIndices(manager, cube))
+      isQuantified[v] = 1;
+
+    // quantified support of every factor, and the factors of every quantified variable
+    std::vector<std::vector<int> > quantifiedSupports(factors.size());
+    std::vector<std::vector<int> > varToFactors(isQuantified.size());
+    for (size_t fi = 0; fi < factors.size(); ++fi)
+    {
+      for (auto v: supportIndices(manager, factors[fi]))
+      {
+        if (!isQuantified[v])
+          continue;
+        quantifiedSupports[fi].push_back(v);
+        varToFactors[v].push_back(fi);
+      }
+    }
+
+    // order the factors, and find the position of the last occurrence of every variable
+    auto order = scheduleFactors(quantifiedSupports, varToFactors);
+    std::vector<int> lastPosition(isQuantified.size(), -1);
+    for (size_t pos = 0; pos < order.size(); ++pos)
+      for (auto v: quantifiedSupports[order[pos]])
+        lastPosition[v] = pos;
+    std::vector<std::vector<int> > varsDyingAt(order.size());
+    size_t numQuantified = 0;
+    for (size_t v = 0; v < lastPosition.size(); ++v)
+    {
+      if (lastPosition[v] < 0)
+        continue;
+      varsDyingAt[lastPosition[v]].push_back(v);
+      ++numQuantified;
+    }
+
+    // cluster consecutive factors, and conjoin the clusters
+    // into the result, quantifying variables as soon as they die
+    bdd_ptr result = bdd_one(manager);
+    bdd_ptr cluster = bdd_one(manager);
+    bdd_ptr clusterCube = bdd_one(manager);
+    size_t numClusters = 0;
+    int peakBddSize = 0;
+    auto flushCluster = [&]() {
+      auto temp = bdd_and_exists(manager, result, cluster, clusterCube);
+      bdd_free(manager, result);
+      result = temp;
+      peakBddSize = std::max(peakBddSize, bdd_size(result));
+      bdd_free(manager, cluster);
+      bdd_free(manager, clusterCube);
+      cluster = bdd_one(manager);
+      clusterCube = bdd_one(manager);
+      ++numClusters;
+    };
+    for (size_t pos = 0; pos < order.size() && !bdd_is_zero(manager, result); ++pos)
+    {
+      auto factor = factors[order[pos]];
+      if (!bdd_is_one(manager, cluster))
+      {
+        auto product = maxClusterSize > 0 ? bdd_and(manager, cluster, factor) : NULL;
+        if (product != NULL && bdd_size(product) <= maxClusterSize)
+        {
+          bdd_free(manager, cluster);
+          cluster = product;
+        }
+        else
+        {
+          if (product != NULL)
+            bdd_free(manager, product);
+          flushCluster();
+          bdd_free(manager, cluster);
+          cluster = bdd_dup(factor);
+        }
+      }
+      else
+      {
+        bdd_free(manager, cluster);
+        cluster = bdd_dup(factor);
+      }
+      peakBddSize = std::max(peakBddSize, bdd_size(cluster));
+      for (auto v: varsDyingAt[pos])
+      {
+        auto var = bdd_new_var_with_index(manager, v);
+        auto temp = bdd_cube_union(manager, clusterCube, var);
+        bdd_free(manager, clusterCube);
+        bdd_free(manager, var);
+        clusterCube = temp;
+      }
+    }
+    if (!bdd_is_one(manager, cluster) && !bdd_is_zero(manager, result))
+      flushCluster();
+    bdd_free(manager, cluster);
+    bdd_free(manager, clusterCube);
+
+    if (stats != nullptr)
+    {
+      stats->numClusters = numClusters;
+      stats->numQuantified = numQuantified;
+      stats->peakBddSize = peakBddSize;
+    }
+    return result;
+  }
+
+} // end namespace dd
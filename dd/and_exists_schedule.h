@@ -0,0 +1,66 @@
+/*
+
+Copyright 2026 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#pragma once
+
+#include "dd.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace dd
+{
+
+  // default cap on the number of bdd nodes in one cluster of factors
+  int const DefaultMaxClusterSize = 5000;
+
+
+
+  // statistics of one scheduled and-exists
+  struct AndExistsScheduleStats
+  {
+    size_t numClusters;    // number of clusters the factors were grouped into
+    size_t numQuantified;  // number of quantified variables found in the factors
+    int peakBddSize;       // largest intermediate product (in bdd nodes)
+  };
+
+
+
+  // Conjoins the factors and existentially quantifies the variables in cube,
+  // using an early quantification schedule in the style of IWLS95:
+  //  - factors are ordered by greedily eliminating the quantified variable
+  //    that occurs in the fewest factors not yet scheduled
+  //  - consecutive factors are clustered while the cluster has at most
+  //    maxClusterSize nodes (no clustering if maxClusterSize <= 0)
+  //  - clusters are conjoined one at a time, and every variable is
+  //    quantified as soon as no remaining cluster depends on it
+  // Returns a referenced bdd.
+  bdd_ptr andExistsScheduled(DdManager * manager,
+                             std::vector<bdd_ptr> const & factors,
+                             bdd_ptr cube,
+                             int maxClusterSize = DefaultMaxClusterSize,
+                             AndExistsScheduleStats * stats = nullptr);
+
+} // end namespace dd
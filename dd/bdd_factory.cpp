@@ -25,8 +25,12 @@ SOFTWARE.
 
 
 #include "bdd_factory.h"
+#include "support_cache.h"
 
+#include <functional>
+#include <queue>
 #include <stdexcept>
+#include <utility>
 
 namespace dd
 {
@@ -38,7 +42,10 @@ namespace dd
   ManagerWrapper::~ManagerWrapper()
   {
     if (manager)
+    {
+        disableSupportCache(manager);
         Cudd_Quit(manager);
+    }
   }
 
   BddWrapper::BddWrapper(bdd_ptr myBdd, DdManager * manager) :
@@ -51,38 +58,92 @@ namespace dd
     m_manager(that.m_manager)
   { }
 
+  BddWrapper::BddWrapper(BddWrapper && that) noexcept:
+    m_bdd(that.m_bdd),
+    m_manager(that.m_manager)
+  {
+    that.m_bdd = NULL;
+  }
+
   BddWrapper & BddWrapper::operator = (BddWrapper const & that)
   {
-    bdd_free(m_manager, m_bdd);
+    // dup first, in case that is this
+    bdd_ptr counted = bdd_dup(that.m_bdd);
+    if (m_bdd)
+      bdd_free(m_manager, m_bdd);
     m_manager = that.m_manager;
-    m_bdd = bdd_dup(that.m_bdd);
+    m_bdd = counted;
+    return *this;
+  }
+
+  BddWrapper & BddWrapper::operator = (BddWrapper && that) noexcept
+  {
+    if (this != &that)
+    {
+      if (m_bdd)
+        bdd_free(m_manager, m_bdd);
+      m_manager = that.m_manager;
+      m_bdd = that.m_bdd;
+      that.m_bdd = NULL;
+    }
     return *this;
   }
 
   BddWrapper::~BddWrapper()
   {
-    bdd_free(m_manager, m_bdd);
+    if (m_bdd)
+      bdd_free(m_manager, m_bdd);
+  }
+
+  void BddWrapper::reset(bdd_ptr countedBdd)
+  {
+    if (m_bdd)
+      bdd_free(m_manager, m_bdd);
+    m_bdd = countedBdd;
   }
 
-  BddWrapper BddWrapper::operator + (BddWrapper const & that) const
+  BddWrapper BddWrapper::operator + (BddWrapper const & that) const &
   {
     if (m_manager != that.m_manager)
       throw std::runtime_error("managers must match for bdd operations");
     return BddWrapper(bdd_or(m_manager, m_bdd, that.m_bdd), m_manager);
   }
 
-  BddWrapper BddWrapper::operator * (BddWrapper const & that) const
+  BddWrapper BddWrapper::operator + (BddWrapper const & that) &&
+  {
+    if (m_manager != that.m_manager)
+      throw std::runtime_error("managers must match for bdd operations");
+    reset(bdd_or(m_manager, m_bdd, that.m_bdd));
+    return std::move(*this);
+  }
+
+  BddWrapper BddWrapper::operator * (BddWrapper const & that) const &
   {
     if (m_manager != that.m_manager)
       throw std::runtime_error("managers must match for bdd operations");
     return BddWrapper(bdd_and(m_manager, m_bdd, that.m_bdd), m_manager);
   }
 
-  BddWrapper BddWrapper::operator - () const
+  BddWrapper BddWrapper::operator * (BddWrapper const & that) &&
+  {
+    if (m_manager != that.m_manager)
+      throw std::runtime_error("managers must match for bdd operations");
+    reset(bdd_and(m_manager, m_bdd, that.m_bdd));
+    return std::move(*this);
+  }
+
+  BddWrapper BddWrapper::operator - () const &
   {
     return BddWrapper(bdd_not(m_bdd), m_manager);
   }
 
+  BddWrapper BddWrapper::operator - () &&
+  {
+    // a bdd and its complement share the reference count
+    m_bdd = Cudd_Not(m_bdd);
+    return std::move(*this);
+  }
+
   bdd_ptr BddWrapper::operator ! () const
   {
     return m_bdd;
@@ -95,21 +156,14 @@ namespace dd
 
   BddWrapper BddWrapper::support() const
   {
-    return BddWrapper(bdd_support(m_manager, m_bdd), m_manager);
+    return BddWrapper(supportCube(m_manager, m_bdd), m_manager);
   }
 
   long double BddWrapper::countMinterms(int numVars) const
   {
     if (numVars <= 0)
     {
-      numVars = 0;
-      auto sup = support();
-      BddWrapper one(bdd_one(m_manager), m_manager);
-      while (sup != one)
-      {
-        ++numVars;
-        sup = sup.cubeDiff(sup.varWithLowestIndex());
-      }
+      numVars = supportIndices(m_manager, m_bdd).size();
     }
     return bdd_count_minterm(m_manager, m_bdd, numVars);
   }
@@ -119,21 +173,39 @@ namespace dd
     return BddWrapper(bdd_cube_intersection(m_manager, m_bdd, that.m_bdd), m_manager);
   }
 
-  BddWrapper BddWrapper::cubeUnion(const BddWrapper & that) const
+  BddWrapper BddWrapper::cubeUnion(const BddWrapper & that) const &
   {
     return BddWrapper(bdd_cube_union(m_manager, m_bdd, that.m_bdd), m_manager);
   }
 
-  BddWrapper BddWrapper::cubeDiff(const BddWrapper & that) const
+  BddWrapper BddWrapper::cubeUnion(const BddWrapper & that) &&
+  {
+    reset(bdd_cube_union(m_manager, m_bdd, that.m_bdd));
+    return std::move(*this);
+  }
+
+  BddWrapper BddWrapper::cubeDiff(const BddWrapper & that) const &
   {
     return BddWrapper(bdd_cube_diff(m_manager, m_bdd, that.m_bdd), m_manager);
   }
 
-  BddWrapper BddWrapper::existentialQuantification(const BddWrapper & variables) const
+  BddWrapper BddWrapper::cubeDiff(const BddWrapper & that) &&
+  {
+    reset(bdd_cube_diff(m_manager, m_bdd, that.m_bdd));
+    return std::move(*this);
+  }
+
+  BddWrapper BddWrapper::existentialQuantification(const BddWrapper & variables) const &
   {
     return BddWrapper(bdd_forsome(m_manager, m_bdd, variables.m_bdd), m_manager);
   }
 
+  BddWrapper BddWrapper::existentialQuantification(const BddWrapper & variables) &&
+  {
+    reset(bdd_forsome(m_manager, m_bdd, variables.m_bdd));
+    return std::move(*this);
+  }
+
   BddWrapper BddWrapper::universalQuantification(const BddWrapper & variables) const
   {
     return BddWrapper(bdd_forall(m_manager, m_bdd, variables.m_bdd), m_manager);
@@ -179,6 +251,13 @@ namespace dd
     return bdd_dup(m_bdd);
   }
 
+  bdd_ptr BddWrapper::release()
+  {
+    bdd_ptr result = m_bdd;
+    m_bdd = NULL;
+    return result;
+  }
+
   DdManager * BddWrapper::getManager() const
   {
     return m_manager;
@@ -192,8 +271,9 @@ namespace dd
   std::vector<BddWrapper> BddWrapper::fromVector(const std::vector<bdd_ptr> & bddVec, DdManager * manager)
   {
     std::vector<BddWrapper> result;
+    result.reserve(bddVec.size());
     for (auto p: bddVec)
-      result.push_back(BddWrapper(p, manager));
+      result.emplace_back(p, manager);
     return result;
   }
 
@@ -201,7 +281,7 @@ namespace dd
   {
     std::set<BddWrapper> result;
     for (auto p: bddSet)
-      result.insert(BddWrapper(p, manager));
+      result.emplace(p, manager);
     return result;
   }
 
@@ -229,17 +309,112 @@ namespace dd
       bdd_dup(p);
   }
 
-  BddVectorWrapper & BddVectorWrapper::operator = (BddVectorWrapper & that)
+  BddVectorWrapper::BddVectorWrapper(BddVectorWrapper && that) noexcept:
+    m_vector(std::move(that.m_vector)),
+    m_manager(that.m_manager)
   {
-    while(!m_vector.empty())
-    {
-      bdd_free(m_manager, m_vector.back());
-      m_vector.pop_back();
-    }
+    that.m_vector.clear();
+  }
+
+  BddVectorWrapper & BddVectorWrapper::operator = (const BddVectorWrapper & that)
+  {
+    if (this == &that)
+      return *this;
+    clear();
     m_manager = that.m_manager;
     for (auto p: that.m_vector)
       m_vector.push_back(bdd_dup(p));
     return *this;
   }
 
+  BddVectorWrapper & BddVectorWrapper::operator = (BddVectorWrapper && that) noexcept
+  {
+    if (this == &that)
+      return *this;
+    clear();
+    m_manager = that.m_manager;
+    m_vector.swap(that.m_vector);
+    return *this;
+  }
+
+  void BddVectorWrapper::clear()
+  {
+    for (auto p: m_vector)
+      bdd_free(m_manager, p);
+    m_vector.clear();
+  }
+
+
+
+
+
+
+  namespace {
+
+    // combines all the operands, smallest first,
+    // stopping early once the result is the absorbing constant
+    BddWrapper combineAll(DdManager * manager, std::vector<BddWrapper> operands, bool isConjunction)
+    {
+      BddWrapper identity(isConjunction ? bdd_one(manager) : bdd_zero(manager), manager);
+      if (operands.empty())
+        return identity;
+      BddWrapper absorbing = -identity;
+
+      typedef std::pair<int, size_t> SizeAndIndex;
+      std::priority_queue<SizeAndIndex, std::vector<SizeAndIndex>, std::greater<SizeAndIndex> > heap;
+      for (size_t i = 0; i < operands.size(); ++i)
+      {
+        if (operands[i] == absorbing)
+          return absorbing;
+        heap.emplace(bdd_size(operands[i].getUncountedBdd()), i);
+      }
+
+      // the result of combining two operands replaces the first of them
+      while (heap.size() > 1)
+      {
+        size_t first = heap.top().second;
+        heap.pop();
+        size_t second = heap.top().second;
+        heap.pop();
+        operands[first] = isConjunction
+          ? std::move(operands[first]) * operands[second]
+          : std::move(operands[first]) + operands[second];
+        BddWrapper consumed(std::move(operands[second]));
+        if (operands[first] == absorbing)
+          return absorbing;
+        heap.emplace(bdd_size(operands[first].getUncountedBdd()), first);
+      }
+      return std::move(operands[heap.top().second]);
+    }
+
+  } // end anonymous namespace
+
+
+
+  BddWrapper conjoinAll(DdManager * manager, std::vector<BddWrapper> operands)
+  {
+    return combineAll(manager, std::move(operands), true);
+  }
+
+  BddWrapper disjoinAll(DdManager * manager, std::vector<BddWrapper> operands)
+  {
+    return combineAll(manager, std::move(operands), false);
+  }
+
+  BddWrapper conjoinAndProject(DdManager * manager,
+                               std::vector<BddWrapper> const & operands,
+                               BddWrapper const & cube,
+                               int cacheSize)
+  {
+    bdd_ptr_set operandSet;
+    BddWrapper support(bdd_one(manager), manager);
+    for (const auto & operand: operands)
+    {
+      operandSet.insert(operand.getUncountedBdd());
+      support = std::move(support).cubeUnion(operand.support());
+    }
+    BddWrapper quantified = std::move(support).cubeDiff(cube);
+    return BddWrapper(bdd_and_exists_multi(manager, operandSet, quantified.getUncountedBdd(), cacheSize), manager);
+  }
+
 } // end namespace dd
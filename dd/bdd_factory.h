@@ -48,25 +48,35 @@ namespace dd
     public:
       BddWrapper(bdd_ptr elem_bdd, DdManager * manager);
       BddWrapper(BddWrapper const & that);
+      BddWrapper(BddWrapper && that) noexcept;
       BddWrapper & operator = (BddWrapper const & that);
+      BddWrapper & operator = (BddWrapper && that) noexcept;
 
       ~BddWrapper();
 
-      BddWrapper operator + (BddWrapper const & that) const;
-      BddWrapper operator * (BddWrapper const & that) const;
-      BddWrapper operator - () const;
+      // the rvalue overloads store the result in (and return)
+      // the expiring operand, instead of a new wrapper
+      BddWrapper operator + (BddWrapper const & that) const &;
+      BddWrapper operator + (BddWrapper const & that) &&;
+      BddWrapper operator * (BddWrapper const & that) const &;
+      BddWrapper operator * (BddWrapper const & that) &&;
+      BddWrapper operator - () const &;
+      BddWrapper operator - () &&;
 
       bdd_ptr operator ! () const;
       bdd_ptr operator * () const;
 
       BddWrapper cubeIntersection(const BddWrapper & that) const;
-      BddWrapper cubeUnion(const BddWrapper & that) const;
-      BddWrapper cubeDiff(const BddWrapper & that) const;
+      BddWrapper cubeUnion(const BddWrapper & that) const &;
+      BddWrapper cubeUnion(const BddWrapper & that) &&;
+      BddWrapper cubeDiff(const BddWrapper & that) const &;
+      BddWrapper cubeDiff(const BddWrapper & that) &&;
 
       BddWrapper support() const;
       long double countMinterms(int numVars = -1) const;
 
-      BddWrapper existentialQuantification(const BddWrapper & variables) const;
+      BddWrapper existentialQuantification(const BddWrapper & variables) const &;
+      BddWrapper existentialQuantification(const BddWrapper & variables) &&;
       BddWrapper universalQuantification(const BddWrapper & variables) const;
 
       BddWrapper varWithLowestIndex() const;
@@ -78,6 +88,8 @@ namespace dd
 
       bdd_ptr getUncountedBdd() const;
       bdd_ptr getCountedBdd() const;
+      // hands over the counted bdd, leaving the wrapper empty
+      bdd_ptr release();
       DdManager * getManager() const;
 
       static std::vector<BddWrapper> fromVector(const std::vector<bdd_ptr>& bddVec, DdManager * manager);
@@ -89,6 +101,10 @@ namespace dd
 
 
     private:
+      // replaces the bdd with a counted one, releasing the old one
+      void reset(bdd_ptr countedBdd);
+
+      // NULL once moved from
       bdd_ptr m_bdd;
       DdManager * m_manager;
 
@@ -103,7 +119,9 @@ namespace dd
       BddVectorWrapper(const std::vector<bdd_ptr> & bddVector,
                        DdManager * manager);
       BddVectorWrapper(const BddVectorWrapper& that);
-      BddVectorWrapper & operator = (BddVectorWrapper & that);
+      BddVectorWrapper(BddVectorWrapper && that) noexcept;
+      BddVectorWrapper & operator = (const BddVectorWrapper & that);
+      BddVectorWrapper & operator = (BddVectorWrapper && that) noexcept;
 
       std::vector<bdd_ptr> const & operator * () const { return m_vector; }
       std::vector<bdd_ptr>       & operator * ()       { return m_vector; }
@@ -112,20 +130,38 @@ namespace dd
       std::vector<bdd_ptr>       * operator -> ()       { return &m_vector; }
 
       void push_back (BddWrapper const & f) { m_vector.push_back (f.getCountedBdd()); }
+      void push_back (BddWrapper && f) { m_vector.push_back (f.release()); }
 
       BddWrapper get(size_t index) const { return {bdd_dup(m_vector[index]), m_manager}; }
       void set(size_t index, BddWrapper const & value) { bdd_free(m_manager, m_vector[index]); m_vector[index] = value.getCountedBdd(); }
+      void set(size_t index, BddWrapper && value) { bdd_free(m_manager, m_vector[index]); m_vector[index] = value.release(); }
 
-      ~BddVectorWrapper()
-      {
-        for (auto p: m_vector)
-          bdd_free(m_manager, p);
-      }
+      ~BddVectorWrapper() { clear(); }
 
     private:
+      void clear();
+
       std::vector<bdd_ptr> m_vector;
       DdManager * m_manager;
 
   }; // end of class BddVectorWrapper
 
+
+
+  // conjunction / disjunction of all the operands
+  // (one / zero if there are none), always combining the
+  // two smallest bdds first, so that intermediate results
+  // stay smaller than with a left fold
+  BddWrapper conjoinAll(DdManager * manager, std::vector<BddWrapper> operands);
+  BddWrapper disjoinAll(DdManager * manager, std::vector<BddWrapper> operands);
+
+  // conjunction of all the operands projected onto the
+  // variables in cube (all other variables are existentially
+  // quantified), in one pass of the multi-operand and-abstract
+  // engine, with a memo table capped at cacheSize (if positive)
+  BddWrapper conjoinAndProject(DdManager * manager,
+                               std::vector<BddWrapper> const & operands,
+                               BddWrapper const & cube,
+                               int cacheSize = 0);
+
 } // end namespace dd
@@ -24,71 +24,140 @@ SOFTWARE.
 
 #include "bdd_partition.h"
 #include "disjoint_set.h"
+#include "thread_pool.h"
 
-#include <unordered_map>
+#include <algorithm>
+#include <cstdlib>
+#include <future>
 
-std::vector<std::vector<bdd_ptr>> bddPartition(DdManager * manager, std::vector<bdd_ptr> const & inputBdds)
-{
-  typedef parakram::DisjointSet<bdd_ptr> FactorDs;
-  std::vector<std::vector<bdd_ptr>> result;
-  std::vector<FactorDs::Ptr> factorSets; // singleton sets of the factors
-  std::unordered_map<int, std::vector<int>> varToNeighborMap; // adjacency list for variable nodes
-  bdd_ptr one = bdd_one(manager);
 
-  // loop across factors
-  // to populate the singleton sets and adjacency lists
-  for (auto factor: inputBdds)
-  {
-    // make a singleton set with the factor
-    int id = factorSets.size();
-    factorSets.push_back(std::make_shared<FactorDs>(id, factor));
+namespace {
 
-    // loop across all the vars in the factor
-    auto vars = bdd_support(manager, factor);
-    while(vars != one)
-    {
-      // reduce the set of vars by one
-      auto nextVarIndex = bdd_get_lowest_index(manager, vars);
-      auto nextVar = bdd_new_var_with_index(manager, nextVarIndex);
-      auto reducedVars = bdd_cube_diff(manager, vars, nextVar);
-      bdd_free(manager, nextVar);
-      bdd_free(manager, vars);
-      vars = reducedVars;
-
-      // mark the current function as a neighbor of this var
-      varToNeighborMap[nextVarIndex].push_back(id);
-    } // end loop across vars in the factor
-    bdd_free(manager, vars);
-  } // end loop across factors
-  bdd_free(manager, one);
-
-
-  // loop across all variables to compute union of adjacent factor sets
-  for (auto varAndNeighbors: varToNeighborMap)
+  // below this many variable occurrences per thread, partitioning stays sequential
+  const size_t MinOccurrencesPerThread = size_t(1) << 16;
+
+  // unions the variables of each edge in [beginEdge, endEdge)
+  // of the CSR arrays, using the absolute value of each entry
+  void uniteEdges(const int * variables, const size_t * offsets,
+                  size_t beginEdge, size_t endEdge,
+                  parakram::FlatDisjointSet & variableSets)
   {
-    auto var = varAndNeighbors.first;
-    auto const & neighbors = varAndNeighbors.second;
-    auto firstFactorSet = factorSets[neighbors.front()];
-    for (auto neighborId: neighbors)
+    for (size_t e = beginEdge; e < endEdge; ++e)
     {
-      auto nextNeighborSet = factorSets[neighborId];
-      firstFactorSet->computeUnion(*nextNeighborSet);
+      auto begin = variables + offsets[e];
+      auto end = variables + offsets[e + 1];
+      if (begin == end)
+        continue;
+      auto first = parakram::FlatDisjointSet::Index(std::abs(*begin));
+      for (auto v = begin + 1; v != end; ++v)
+        variableSets.computeUnion(first, parakram::FlatDisjointSet::Index(std::abs(*v)));
     }
   }
 
-  // collect elements in partitions
-  std::vector<std::vector<bdd_ptr> > tempResult;
-  tempResult.resize(factorSets.size());
-  for (auto factorSet: factorSets)
+  // ***** Function *****
+  // Connected components of the edges of the CSR arrays.
+  // With several threads, each thread unites the variables of a slice of the
+  //   edges (with about the same number of occurrences) in its own
+  //   FlatDisjointSet, and the slices are merged by uniting every variable
+  //   with its representative in each slice.
+  // ********************
+  std::vector<std::vector<size_t>> partitionEdges(const int * variables, const size_t * offsets,
+                                                  size_t numEdges, int numThreads)
   {
-    auto parent = factorSet->find();
-    auto idx = parent->id();
-    tempResult[idx].push_back(factorSet->element());
+    size_t numOccurrences = offsets[numEdges];
+    int maxVariable = -1;
+    for (size_t i = 0; i < numOccurrences; ++i)
+      maxVariable = std::max(maxVariable, std::abs(variables[i]));
+    size_t numVariables = size_t(maxVariable + 1);
+
+    size_t numSlices = size_t(numThreads > 0 ? numThreads : parakram::ThreadPool::defaultNumThreads());
+    numSlices = std::max<size_t>(1, std::min(numSlices, numOccurrences / MinOccurrencesPerThread));
+
+    parakram::FlatDisjointSet variableSets(numVariables);
+    if (numSlices == 1)
+      uniteEdges(variables, offsets, 0, numEdges, variableSets);
+    else
+    {
+      std::vector<size_t> sliceEdges(numSlices + 1, numEdges);
+      sliceEdges[0] = 0;
+      for (size_t s = 1; s < numSlices; ++s)
+        sliceEdges[s] = size_t(std::lower_bound(offsets, offsets + numEdges, numOccurrences * s / numSlices) - offsets);
+      std::vector<parakram::FlatDisjointSet> sliceSets(numSlices, parakram::FlatDisjointSet(numVariables));
+      {
+        parakram::ThreadPool pool(static_cast<int>(numSlices));
+        std::vector<std::future<void> > done;
+        for (size_t s = 0; s < numSlices; ++s)
+          done.push_back(pool.submit([&, s]() {
+            uniteEdges(variables, offsets, sliceEdges[s], sliceEdges[s + 1], sliceSets[s]);
+          }));
+        for (auto & d: done)
+          d.get();
+      }
+      for (auto & sliceSet: sliceSets)
+        for (parakram::FlatDisjointSet::Index v = 0; v < numVariables; ++v)
+        {
+          auto root = sliceSet.find(v);
+          if (root != v)
+            variableSets.computeUnion(v, root);
+        }
+    }
+
+    // number the components in the order of their first edge
+    const size_t none = size_t(-1);
+    std::vector<size_t> componentOfRoot(numVariables, none);
+    std::vector<std::vector<size_t>> result;
+    for (size_t e = 0; e < numEdges; ++e)
+    {
+      if (offsets[e] == offsets[e + 1])
+      {
+        result.push_back(std::vector<size_t>(1, e));
+        continue;
+      }
+      auto root = variableSets.find(parakram::FlatDisjointSet::Index(std::abs(variables[offsets[e]])));
+      if (componentOfRoot[root] == none)
+      {
+        componentOfRoot[root] = result.size();
+        result.emplace_back();
+      }
+      result[componentOfRoot[root]].push_back(e);
+    }
+    return result;
   }
 
-  // get rid of empty partitions
-  for (auto r: tempResult)
-    if (!r.empty()) result.push_back(r);
+} // end anonymous namespace
+
+
 
+std::vector<std::vector<bdd_ptr>> bddPartition(DdManager * manager, std::vector<bdd_ptr> const & inputBdds, int numThreads)
+{
+  std::vector<std::vector<bdd_ptr>> result;
+  for (auto const & component: dd::partitionHypergraph(dd::VariableHypergraph::fromSupports(manager, inputBdds), numThreads))
+  {
+    result.emplace_back();
+    result.back().reserve(component.size());
+    for (auto f: component)
+      result.back().push_back(inputBdds[f]);
+  }
   return result;
 } // end bddPartition
+
+
+
+namespace dd {
+
+  std::vector<std::vector<size_t>> partitionHypergraph(const VariableHypergraph & hypergraph, int numThreads)
+  {
+    return partitionEdges(hypergraph.edgeVariables.data(), hypergraph.edgeOffsets.data(), hypergraph.numEdges(), numThreads);
+  }
+
+  std::vector<std::vector<size_t>> partitionClauses(const FlatQdimacs & qdimacs, int numThreads)
+  {
+    return partitionEdges(qdimacs.literals.data(), qdimacs.clauseOffsets.data(), qdimacs.numClauses(), numThreads);
+  }
+
+  std::vector<std::vector<size_t>> partitionClauses(const Qdimacs & qdimacs, int numThreads)
+  {
+    return partitionHypergraph(VariableHypergraph::fromClauses(qdimacs), numThreads);
+  }
+
+} // end namespace dd
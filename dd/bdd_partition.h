@@ -22,8 +22,36 @@ SOFTWARE.
 
 */
 
+#pragma once
+
 #include "dd.h"
+#include "qdimacs.h"
+#include "variable_order.h"
+
+#include <cstddef>
 #include <vector>
 
-std::vector<std::vector<bdd_ptr>> bddPartition(DdManager* manager, std::vector<bdd_ptr> const & inputBdds);
+// splits the bdds into groups with disjoint supports
+// (see dd::partitionHypergraph for numThreads)
+std::vector<std::vector<bdd_ptr>> bddPartition(DdManager* manager, std::vector<bdd_ptr> const & inputBdds, int numThreads = 0);
+
+namespace dd {
+
+  // ***** partitionHypergraph *****
+  // Connected components of the edges of a hypergraph,
+  //   two edges being connected if they share a variable.
+  // Each component lists its edges in increasing order, the components
+  //   are sorted by their first edge, and edges without variables
+  //   are components of their own.
+  // Works on variable indices only, with a FlatDisjointSet over the variables,
+  //   so it can run before any bdd is built.
+  // The edges are split across numThreads threads (<= 0 for one per hardware thread,
+  //   fewer for small inputs); the result does not depend on the number of threads.
+  std::vector<std::vector<size_t>> partitionHypergraph(const VariableHypergraph & hypergraph, int numThreads = 0);
+
+  // connected components of the clauses, as clause indices (see partitionHypergraph)
+  std::vector<std::vector<size_t>> partitionClauses(const FlatQdimacs & qdimacs, int numThreads = 0);
+  std::vector<std::vector<size_t>> partitionClauses(const Qdimacs & qdimacs, int numThreads = 0);
+
+} // end namespace dd
 
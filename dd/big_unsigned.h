@@ -0,0 +1,225 @@
+/*
+
+Copyright 2026 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace parakram {
+
+  // ***** BigUnsigned *****
+  // ******* class *******
+  // An arbitrary precision unsigned integer,
+  //   just big enough for exact model counting:
+  //   addition, shifts, comparison, and conversion
+  //   to decimal strings and (log2) floating point.
+  // Stored as little endian 32 bit limbs,
+  //   without leading zero limbs (zero has no limbs).
+  class BigUnsigned
+  {
+    public:
+      BigUnsigned(uint64_t value = 0)
+      {
+        for (; value != 0; value >>= 32)
+          m_limbs.push_back(static_cast<uint32_t>(value));
+      }
+
+      static BigUnsigned power2(size_t exponent)
+      {
+        BigUnsigned result(1);
+        result <<= exponent;
+        return result;
+      }
+
+      bool isZero() const { return m_limbs.empty(); }
+
+      // number of bits needed to write the number, 0 for zero
+      size_t numBits() const
+      {
+        if (m_limbs.empty())
+          return 0;
+        size_t bits = 32 * (m_limbs.size() - 1);
+        for (uint32_t top = m_limbs.back(); top != 0; top >>= 1)
+          ++bits;
+        return bits;
+      }
+
+      BigUnsigned & operator += (BigUnsigned const & that)
+      {
+        if (m_limbs.size() < that.m_limbs.size())
+          m_limbs.resize(that.m_limbs.size(), 0);
+        uint64_t carry = 0;
+        for (size_t i = 0; i < m_limbs.size(); ++i)
+        {
+          uint64_t sum = carry + m_limbs[i] + (i < that.m_limbs.size() ? that.m_limbs[i] : 0);
+          m_limbs[i] = static_cast<uint32_t>(sum);
+          carry = sum >> 32;
+          if (carry == 0 && i >= that.m_limbs.size())
+            break;
+        }
+        if (carry != 0)
+          m_limbs.push_back(static_cast<uint32_t>(carry));
+        return *this;
+      }
+
+      BigUnsigned & operator <<= (size_t bits)
+      {
+        if (m_limbs.empty() || bits == 0)
+          return *this;
+        size_t const limbShift = bits / 32;
+        unsigned const bitShift = bits % 32;
+        if (bitShift != 0)
+        {
+          uint32_t carry = 0;
+          for (auto & limb: m_limbs)
+          {
+            uint32_t next = limb >> (32 - bitShift);
+            limb = (limb << bitShift) | carry;
+            carry = next;
+          }
+          if (carry != 0)
+            m_limbs.push_back(carry);
+        }
+        m_limbs.insert(m_limbs.begin(), limbShift, 0);
+        return *this;
+      }
+
+      // shifts right, dropping the low bits
+      BigUnsigned & operator >>= (size_t bits)
+      {
+        size_t const limbShift = bits / 32;
+        unsigned const bitShift = bits % 32;
+        if (limbShift >= m_limbs.size())
+        {
+          m_limbs.clear();
+          return *this;
+        }
+        m_limbs.erase(m_limbs.begin(), m_limbs.begin() + limbShift);
+        if (bitShift != 0)
+        {
+          for (size_t i = 0; i < m_limbs.size(); ++i)
+          {
+            uint32_t high = i + 1 < m_limbs.size() ? m_limbs[i + 1] << (32 - bitShift) : 0;
+            m_limbs[i] = (m_limbs[i] >> bitShift) | high;
+          }
+        }
+        trim();
+        return *this;
+      }
+
+      BigUnsigned operator + (BigUnsigned const & that) const { BigUnsigned r(*this); r += that; return r; }
+      BigUnsigned operator << (size_t bits) const { BigUnsigned r(*this); r <<= bits; return r; }
+      BigUnsigned operator >> (size_t bits) const { BigUnsigned r(*this); r >>= bits; return r; }
+
+      bool operator == (BigUnsigned const & that) const { return m_limbs == that.m_limbs; }
+      bool operator != (BigUnsigned const & that) const { return m_limbs != that.m_limbs; }
+      bool operator < (BigUnsigned const & that) const
+      {
+        if (m_limbs.size() != that.m_limbs.size())
+          return m_limbs.size() < that.m_limbs.size();
+        for (size_t i = m_limbs.size(); i-- > 0; )
+          if (m_limbs[i] != that.m_limbs[i])
+            return m_limbs[i] < that.m_limbs[i];
+        return false;
+      }
+
+      // log2 of the number, -infinity for zero,
+      // computed from the top 64 bits so it never overflows
+      double log2() const
+      {
+        if (m_limbs.empty())
+          return -HUGE_VAL;
+        size_t const bits = numBits();
+        size_t const drop = bits > 64 ? bits - 64 : 0;
+        BigUnsigned top = *this >> drop;
+        uint64_t mantissa = 0;
+        for (size_t i = top.m_limbs.size(); i-- > 0; )
+          mantissa = (mantissa << 32) | top.m_limbs[i];
+        return std::log2(static_cast<double>(mantissa)) + static_cast<double>(drop);
+      }
+
+      // +infinity if the number is too large for a long double
+      long double toLongDouble() const
+      {
+        long double result = 0;
+        for (size_t i = m_limbs.size(); i-- > 0; )
+          result = result * 4294967296.0L + m_limbs[i];
+        return result;
+      }
+
+      // decimal representation
+      std::string toString() const
+      {
+        if (m_limbs.empty())
+          return "0";
+        // repeatedly divide by 10^9, collecting the remainders
+        std::vector<uint32_t> digits;
+        std::vector<uint32_t> rest(m_limbs);
+        while (!rest.empty())
+        {
+          uint64_t remainder = 0;
+          for (size_t i = rest.size(); i-- > 0; )
+          {
+            uint64_t current = (remainder << 32) | rest[i];
+            rest[i] = static_cast<uint32_t>(current / 1000000000u);
+            remainder = current % 1000000000u;
+          }
+          while (!rest.empty() && rest.back() == 0)
+            rest.pop_back();
+          digits.push_back(static_cast<uint32_t>(remainder));
+        }
+        std::string result = std::to_string(digits.back());
+        for (size_t i = digits.size() - 1; i-- > 0; )
+        {
+          std::string chunk = std::to_string(digits[i]);
+          result.append(9 - chunk.size(), '0');
+          result += chunk;
+        }
+        return result;
+      }
+
+    private:
+      void trim()
+      {
+        while (!m_limbs.empty() && m_limbs.back() == 0)
+          m_limbs.pop_back();
+      }
+
+      std::vector<uint32_t> m_limbs;
+  };
+
+  inline std::ostream & operator << (std::ostream & out, BigUnsigned const & value)
+  {
+    return out << value.toString();
+  }
+
+} // end namespace parakram
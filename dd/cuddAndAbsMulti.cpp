@@ -26,43 +26,389 @@ SOFTWARE.
 
 #include <stdexcept>
 #include "cuddAndAbsMulti.h"
-#include "lru_cache.h"
+#include "node_set_cache.h"
+#include "small_vector.h"
 #include <util.h>
 #include <cuddInt.h>
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 #include <float.h>
+#include <limits.h>
 
-// *********************************************
-// *** std hash definition for unordered_map ***
-// *********************************************
-namespace std {
-  template<> struct hash<std::set<DdNode *> >
+// **************************************
+// *** Internal function declarations ***
+// **************************************
+
+
+
+// ****************************************
+// *** Internal types for the and-multi ***
+// ****************************************
+namespace {
+
+  // A sorted set of bdd operands, stored inline for up to 16 operands.
+  typedef parakram::SmallVector<DdNode *, 16> NodeSet;
+
+  // ***** SupportSignature *****
+  // Cheap over-approximation of the support of a bdd:
+  // the deepest level in the bdd, and a 64 bit bloom filter
+  // of the variable indices.
+  struct SupportSignature
+  {
+    int top;
+    int bottom;
+    unsigned long long bloom;
+
+    // false only if the supports are guaranteed to be disjoint
+    bool intersects(SupportSignature const & that) const
+    {
+      return top <= that.bottom && that.top <= bottom && (bloom & that.bloom) != 0;
+    }
+  };
+
+  // ***** AndMultiFrame *****
+  // Scratch space for one recursion depth, reused by all
+  // the calls at that depth so that no allocations
+  // are needed once the buffers are warm.
+  struct AndMultiFrame
+  {
+    // the then/else operands
+    NodeSet tv, ev;
+    // operands grouped into components with disjoint supports
+    std::vector<NodeSet> components;
+    parakram::SmallVector<size_t, 16> componentOf;
+    parakram::SmallVector<SupportSignature, 16> componentSignatures;
+  };
+
+  typedef parakram::NodeSetCache<DdNode *, DdNode *> AndMultiCache;
+  typedef parakram::NodeSetCache<DdNode *, long double> CountMultiCache;
+  typedef parakram::NodeSetCache<DdNode *, double> LogCountMultiCache;
+  typedef parakram::NodeSetCache<DdNode *, parakram::BigUnsigned> ApaCountMultiCache;
+
+
+
+  // ***** PersistentMultiCache *****
+  // Memo tables of one manager that outlive the
+  // individual multi operations (see Cudd_MultiCacheEnable).
+  // They are flushed before every garbage collection and
+  // reordering, so they never refer to freed nodes.
+  struct PersistentMultiCache
+  {
+    AndMultiCache andCache;
+    CountMultiCache countCache;
+    unsigned long long numHookFlushes;
+
+    PersistentMultiCache(size_t numSlots) :
+      andCache(numSlots),
+      countCache(numSlots),
+      numHookFlushes(0)
+    { }
+  };
+
+  // registry of the persistent memo tables, one per manager
+  std::mutex persistentMultiCachesMutex;
+  std::unordered_map<DdManager *, std::unique_ptr<PersistentMultiCache> > persistentMultiCaches;
+
+  PersistentMultiCache * findPersistentMultiCache(DdManager * manager)
+  {
+    std::lock_guard<std::mutex> lock(persistentMultiCachesMutex);
+    auto it = persistentMultiCaches.find(manager);
+    return it == persistentMultiCaches.end() ? NULL : it->second.get();
+  }
+
+  // CUDD hook that flushes the persistent memo tables of a manager
+  int flushPersistentMultiCache(DdManager * manager, const char *, void *)
+  {
+    auto persistent = findPersistentMultiCache(manager);
+    if (persistent)
+    {
+      persistent->andCache.clear();
+      persistent->countCache.clear();
+      ++persistent->numHookFlushes;
+    }
+    return 1;
+  }
+
+
+
+  // ***** AndMultiState *****
+  // State shared by all the recursive calls of one
+  // Cudd_bddAndAbstractMulti / Cudd_bddAndMulti call.
+  struct AndMultiState
+  {
+    // memo table, keyed on the operands and the cube
+    // (DD_ONE for plain conjunctions),
+    // either the persistent one of the manager or a private one
+    std::unique_ptr<AndMultiCache> privateCache;
+    AndMultiCache * cache;
+    unsigned long long lookupsBefore;
+    unsigned long long hitsBefore;
+    std::deque<AndMultiFrame> frames;
+    // whether to split the operands into independent components,
+    // and the memo table of support signatures needed for it
+    bool decompose;
+    std::unique_ptr<parakram::NodeSetCache<DdNode *, SupportSignature> > signatures;
+    unsigned long long numRecursions;
+    unsigned long long numDecompositions;
+
+    AndMultiState(PersistentMultiCache * persistent, size_t numSlots, bool mustDecompose) :
+      privateCache(persistent ? NULL : new AndMultiCache(numSlots)),
+      cache(persistent ? &persistent->andCache : privateCache.get()),
+      lookupsBefore(cache->numLookups()),
+      hitsBefore(cache->numHits()),
+      frames(),
+      decompose(mustDecompose),
+      signatures(mustDecompose ? new parakram::NodeSetCache<DdNode *, SupportSignature>(numSlots) : NULL),
+      numRecursions(0),
+      numDecompositions(0)
+    { }
+
+    AndMultiFrame & frame(size_t depth)
+    {
+      while (frames.size() <= depth)
+        frames.emplace_back();
+      return frames[depth];
+    }
+
+    // cached result, or NULL;
+    // like the CUDD computed table, dead results are reclaimed
+    DdNode * lookup(DdManager * manager, NodeSet const & fSet, DdNode * tag)
+    {
+      auto cached = cache->tryGet(fSet.data(), fSet.size(), tag);
+      if (!cached.isPresent())
+        return NULL;
+      auto r = cached.get();
+      if (0 == Cudd_Regular(r)->ref)
+        cuddReclaim(manager, Cudd_Regular(r));
+      return r;
+    }
+
+    void insert(NodeSet const & fSet, DdNode * tag, DdNode * r)
+    {
+      cache->insert(fSet.data(), fSet.size(), tag, r);
+    }
+
+    // forget everything that depends on the variable order
+    void clear()
+    {
+      cache->clear();
+      if (signatures)
+        signatures->clear();
+    }
+
+    void fillStats(Cudd_MultiStats * stats) const
+    {
+      if (NULL == stats)
+        return;
+      stats->recursions = numRecursions;
+      stats->cacheLookups = cache->numLookups() - lookupsBefore;
+      stats->cacheHits = cache->numHits() - hitsBefore;
+      stats->cacheSlots = cache->numSlots();
+      stats->decompositions = numDecompositions;
+    }
+  };
+
+
+
+  // ***** CountMultiState *****
+  // State shared by all the recursive calls of one
+  // Cudd_LdblCountMintermMulti call.
+  struct CountMultiState
+  {
+    // memo table, keyed on the operands,
+    // with counts stored as fractions of the total
+    std::unique_ptr<CountMultiCache> privateCache;
+    CountMultiCache * cache;
+    std::deque<AndMultiFrame> frames;
+
+    CountMultiState(PersistentMultiCache * persistent, size_t numSlots) :
+      privateCache(persistent ? NULL : new CountMultiCache(numSlots)),
+      cache(persistent ? &persistent->countCache : privateCache.get()),
+      frames()
+    { }
+
+    AndMultiFrame & frame(size_t depth)
+    {
+      while (frames.size() <= depth)
+        frames.emplace_back();
+      return frames[depth];
+    }
+  };
+
+
+
+  // ***** PrivateCountMultiState *****
+  // State shared by all the recursive calls of one
+  // Cudd_LogCountMintermMulti / Cudd_ApaCountMintermMulti call,
+  // with a private memo table keyed on the operands.
+  template<typename TCache>
+  struct PrivateCountMultiState
   {
-    typedef set<DdNode *> argument_type;
-    typedef std::size_t result_type;
-    result_type operator()(const argument_type & bddset) const
+    TCache cache;
+    std::deque<AndMultiFrame> frames;
+
+    PrivateCountMultiState(size_t numSlots) :
+      cache(numSlots),
+      frames()
+    { }
+
+    AndMultiFrame & frame(size_t depth)
     {
-      result_type h = 0;
-      for (const auto bdd: bddset) {
-        result_type bh = (result_type)bdd;
-        h ^= bh + 0x9e3779b9 + (h << 6) + (h >> 2);
+      while (frames.size() <= depth)
+        frames.emplace_back();
+      return frames[depth];
+    }
+  };
+
+
+
+  // ***** AndAbstractTask *****
+  // One pending call of the iterative and-abstract engine,
+  // i.e., what would be one C stack frame of
+  // cuddBddAndAbstractMultiRecur.
+  struct AndAbstractTask
+  {
+    enum Phase { Start, AwaitThen, AwaitElse };
+
+    Phase phase;
+    NodeSet fSet;          // normalized operands
+    DdNode * cube;         // remaining cube, DD_ONE for plain conjunction
+    DdNode * childCube;    // cube for the then/else children
+    unsigned int index;    // variable to split on
+    bool quantify;         // whether the split variable is quantified
+    NodeSet tv, ev;        // then/else operands
+    bool evIsZero;
+    DdNode * t;            // referenced then result, while awaiting the else result
+  };
+
+
+
+  // ***** AndAbstractBudget *****
+  // Checks the time and node budget of the iterative engine.
+  struct AndAbstractBudget
+  {
+    bool hasDeadline;
+    std::chrono::steady_clock::time_point deadline;
+    unsigned long maxLiveNodes;
+
+    AndAbstractBudget(Cudd_MultiBudget const * budget) :
+      hasDeadline(budget != NULL && budget->timeLimit > 0),
+      deadline(std::chrono::steady_clock::now()
+               + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                   std::chrono::duration<double>(hasDeadline ? budget->timeLimit : 0))),
+      maxLiveNodes(budget == NULL ? 0 : budget->maxLiveNodes)
+    { }
+
+    Cudd_MultiStatus check(DdManager * manager) const
+    {
+      if (maxLiveNodes > 0 && Cudd_ReadKeys(manager) - Cudd_ReadDead(manager) > maxLiveNodes)
+        return CUDD_MULTI_NODES_EXCEEDED;
+      if (hasDeadline && std::chrono::steady_clock::now() > deadline)
+        return CUDD_MULTI_TIME_EXCEEDED;
+      return CUDD_MULTI_SUCCESS;
+    }
+  };
+
+
+
+  // ***** ClippingState *****
+  // State shared by all the recursive calls of one
+  // clipping conjunction: the live node budget, and
+  // why the result had to be clipped, if at all.
+  struct ClippingState
+  {
+    unsigned long maxLiveNodes;
+    bool clippedByDepth;
+    bool clippedByNodes;
+    unsigned long long numClips;
+
+    ClippingState(unsigned long liveNodeBudget) :
+      maxLiveNodes(liveNodeBudget),
+      clippedByDepth(false),
+      clippedByNodes(false),
+      numClips(0)
+    { }
+
+    // whether the recursion must clip here;
+    // clipping at any depth preserves the
+    // direction of the approximation
+    bool mustClip(DdManager * manager, int distance)
+    {
+      if (0 == distance)
+      {
+        clippedByDepth = true;
+        ++numClips;
+        return true;
       }
-      return h;
+      if (maxLiveNodes > 0 && Cudd_ReadKeys(manager) - Cudd_ReadDead(manager) > maxLiveNodes)
+      {
+        clippedByNodes = true;
+        ++numClips;
+        return true;
+      }
+      return false;
+    }
+
+    void reset()
+    {
+      clippedByDepth = false;
+      clippedByNodes = false;
+      numClips = 0;
     }
   };
-} // end namespace std
 
+} // end anonymous namespace
 
 
 
+// ***** Function *****
+// Sorts the operands, removes duplicates and constant ones.
+// Returns false if the conjunction is trivially zero.
+bool normalizeOperands(NodeSet & f, DdNode * one);
 
 
 
+// ***** Function *****
+// Collects the then/else cofactors of the operands
+// w.r.t. the variable with the given index.
+void splitOperands(
+    NodeSet const & f,
+    unsigned int index,
+    NodeSet & tv,
+    NodeSet & ev);
 
 
-// **************************************
-// *** Internal function declarations ***
-// **************************************
+
+// ***** Function *****
+// Number of memo table slots for one multi operation.
+size_t multiCacheSlots(DdManager * manager, int multiCacheCapacity);
+
+
+
+// ***** Function *****
+// Computes (and memoizes) the support signature of a bdd.
+SupportSignature supportSignature(
+    DdManager * manager,
+    DdNode * f,
+    AndMultiState & state);
+
+
+
+// ***** Function *****
+// Groups the operands into components with disjoint supports.
+// Returns the number of components; if more than one,
+// the components are stored in frame.components.
+size_t findComponents(
+    DdManager * manager,
+    NodeSet const & f,
+    AndMultiState & state,
+    AndMultiFrame & frame);
 
 
 
@@ -70,9 +416,10 @@ namespace std {
 // Recursive and-abstract implementation
 DdNode * cuddBddAndAbstractMultiRecur(
     DdManager * manager,
-    std::set<DdNode*> const & f,
+    NodeSet const & f,
     DdNode * cube,
-    parakram::LruCache<std::set<DdNode *>, DdNode*> & cache);
+    AndMultiState & state,
+    size_t depth);
 
 
 
@@ -80,8 +427,24 @@ DdNode * cuddBddAndAbstractMultiRecur(
 // Recursive "and" implementation
 DdNode * cuddBddAndMultiRecur(
     DdManager * manager,
-    std::set<DdNode *> const & f,
-    parakram::LruCache<std::set<DdNode *>, DdNode *> & cache);
+    NodeSet const & f,
+    AndMultiState & state,
+    size_t depth);
+
+
+
+// ***** Function *****
+// Iterative "and-abstract" implementation, with an explicit stack
+// and a time / node budget
+// fSet must be normalized (see normalizeOperands)
+DdNode * cuddBddAndAbstractMultiIter(
+    DdManager * manager,
+    NodeSet const & fSet,
+    DdNode * cube,
+    AndMultiState & state,
+    std::deque<AndAbstractTask> & stack,
+    AndAbstractBudget const & budget,
+    Cudd_MultiStatus & status);
 
 
 
@@ -92,7 +455,8 @@ DdNode * cuddBddClippingAndMultiRecur(
     DdManager * manager,
     std::set<DdNode *> const & f,
     int distance,
-    int direction);
+    int direction,
+    ClippingState & state);
 
 
 
@@ -104,17 +468,66 @@ DdNode * cuddBddClippingAndAbstractMultiRecur(
     std::set<DdNode *> const & f,
     DdNode * cube,
     int distance,
-    int direction);
+    int direction,
+    ClippingState & state);
+
+
+
+// ***** Function *****
+// Shared driver of the adaptive clipping operations:
+// deepens the clipping depth while the result stays
+// within the budget
+DdNode * cuddBddClippingAndMultiAdaptive(
+    DdManager * manager,
+    std::set<DdNode *> const & f,
+    DdNode * cube,
+    Cudd_ClippingBudget const * budget,
+    int direction,
+    Cudd_ClippingStats * stats);
 
 
 
 // ***** Function *****
 // Recursive model counting for more than two bdds
+// f must be normalized (see normalizeOperands)
 long double cuddBddCountMintermMultiAux(
     DdManager * manager,
-    const std::set<DdNode *> & f,
+    NodeSet const & f,
     long double max,
-    parakram::LruCache<std::set<DdNode *>, long double> & cache);
+    CountMultiState & state,
+    size_t depth);
+
+
+
+// ***** Function *****
+// Recursive model counting for more than two bdds, in log space:
+// returns log2 of the fraction of all assignments that satisfy f
+// f must be normalized (see normalizeOperands)
+double cuddBddLogCountMintermMultiAux(
+    DdManager * manager,
+    NodeSet const & f,
+    PrivateCountMultiState<LogCountMultiCache> & state,
+    size_t depth);
+
+
+
+// ***** Function *****
+// Recursive exact model counting for more than two bdds:
+// returns the number of assignments to the variables at
+// or below the top level of f that satisfy f
+// f must be normalized (see normalizeOperands)
+parakram::BigUnsigned cuddBddApaCountMintermMultiAux(
+    DdManager * manager,
+    NodeSet const & f,
+    PrivateCountMultiState<ApaCountMultiCache> & state,
+    size_t depth);
+
+
+
+// ***** Function *****
+// Top level of a set of operands, the number of
+// variables in the manager if there are none
+int topLevel(DdManager * manager, NodeSet const & f);
 
 
 
@@ -137,10 +550,16 @@ long double cuddBddCountMintermMultiAux(
   @details The variables are existentially abstracted.
   Cudd_bddAndAbstractMulti implements the semiring matrix multiplication
   algorithm for the boolean semiring.
+  Intermediate results are memoized in an open addressing table with
+  as many slots as the manager's computed table, capped by cacheSize,
+  or in the manager's persistent table (see Cudd_MultiCacheEnable).
+  If decomposeComponents is non-zero, then at every step the operands
+  are split into groups with disjoint supports (detected using cheap
+  support signatures), which are and-abstracted independently.
 
   @return a pointer to the result is successful; NULL otherwise.
 
-  @sideeffect None
+  @sideeffect stats, if not NULL, is filled in
 
   @see Cudd_addMatrixMultiply Cudd_addTriangle Cudd_bddAnd
 
@@ -149,17 +568,24 @@ DdNode * Cudd_bddAndAbstractMulti(
     DdManager *manager, 
     std::set<DdNode*> const & f, 
     DdNode *cube,
-    int cacheSize)
+    int cacheSize,
+    int decomposeComponents,
+    Cudd_MultiStats * stats)
 {
   DdNode * res;
-  parakram::LruCache<std::set<DdNode *>, DdNode *> cache(cacheSize);
+  AndMultiState state(findPersistentMultiCache(manager), multiCacheSlots(manager, cacheSize), decomposeComponents != 0);
+  NodeSet fSet(f.cbegin(), f.cend());
+  bool const isZero = !normalizeOperands(fSet, DD_ONE(manager));
   do {
     manager->reordered = 0;
-    res = cuddBddAndAbstractMultiRecur(manager, f, cube, cache);
+    res = isZero ? Cudd_Not(DD_ONE(manager)) : cuddBddAndAbstractMultiRecur(manager, fSet, cube, state, 0);
+    if (manager->reordered == 1)
+      state.clear();
   } while(manager->reordered == 1);
   if (manager->errorCode == CUDD_TIMEOUT_EXPIRED && manager->timeoutHandler) {
     manager->timeoutHandler(manager, manager->tohArg);
   }
+  state.fillStats(stats);
   return (res);
 } // end of Cudd_bddAndAbstractMulti
 
@@ -173,7 +599,7 @@ DdNode * Cudd_bddAndAbstractMulti(
   @return a pointer to the resulting %BDD if successful; NULL if the
   intermediate result blows up.
 
-  @sideeffect None
+  @sideeffect stats, if not NULL, is filled in
 
   @see Cudd_bddIte Cudd_addApply Cudd_bddAndAbstract Cudd_bddIntersect
   Cudd_bddOr Cudd_bddNand Cudd_bddNor Cudd_bddXor Cudd_bddXnor
@@ -182,18 +608,24 @@ DdNode * Cudd_bddAndAbstractMulti(
 DdNode * Cudd_bddAndMulti(
     DdManager * dd,
     std::set<DdNode*> const & f,
-    int cacheSize)
+    int cacheSize,
+    Cudd_MultiStats * stats)
 {
-  parakram::LruCache<std::set<DdNode *>, DdNode*> cache(cacheSize);
+  AndMultiState state(findPersistentMultiCache(dd), multiCacheSlots(dd, cacheSize), false);
+  NodeSet fSet(f.cbegin(), f.cend());
+  bool const isZero = !normalizeOperands(fSet, DD_ONE(dd));
   DdNode * res;
   do {
     dd->reordered = 0;
-    res = cuddBddAndMultiRecur(dd, f, cache);
+    res = isZero ? Cudd_Not(DD_ONE(dd)) : cuddBddAndMultiRecur(dd, fSet, state, 0);
+    if (dd->reordered == 1)
+      state.clear();
   } while (dd->reordered == 1);
   if (dd->errorCode == CUDD_TIMEOUT_EXPIRED && dd->timeoutHandler)
   {
     dd->timeoutHandler(dd, dd->tohArg);
   }
+  state.fillStats(stats);
   return res;
 } // end of Cudd_bddAndMulti
 
@@ -201,6 +633,64 @@ DdNode * Cudd_bddAndMulti(
 
 
 
+/**
+  @brief Takes the AND of a set of BDDs and simultaneously abstracts
+  the variables in cube, within a time and node budget.
+
+  @details Computes the same result as Cudd_bddAndAbstractMulti
+  (or Cudd_bddAndMulti, if cube is the constant one),
+  but keeps the pending steps on an explicit stack instead of the C stack,
+  and gives up cleanly as soon as budget->timeLimit seconds have passed
+  or the manager has more than budget->maxLiveNodes live nodes
+  (a non-positive limit means no limit).
+  The budget is checked every few hundred steps,
+  so it may be overshot slightly.
+
+  @return a pointer to the result if successful; NULL otherwise,
+  with the reason in status.
+
+  @sideeffect status, and stats if not NULL, are filled in
+
+  @see Cudd_bddAndAbstractMulti
+
+*/
+DdNode * Cudd_bddAndAbstractMultiBudgeted(
+    DdManager * manager,
+    std::set<DdNode *> const & f,
+    DdNode * cube,
+    int cacheSize,
+    Cudd_MultiBudget const * budget,
+    Cudd_MultiStatus * status,
+    Cudd_MultiStats * stats)
+{
+  DdNode * res;
+  Cudd_MultiStatus resStatus = CUDD_MULTI_SUCCESS;
+  AndMultiState state(findPersistentMultiCache(manager), multiCacheSlots(manager, cacheSize), false);
+  std::deque<AndAbstractTask> stack;
+  AndAbstractBudget checker(budget);
+  NodeSet fSet(f.cbegin(), f.cend());
+  bool const isZero = !normalizeOperands(fSet, DD_ONE(manager));
+  do {
+    manager->reordered = 0;
+    res = isZero
+      ? Cudd_Not(DD_ONE(manager))
+      : cuddBddAndAbstractMultiIter(manager, fSet, cube, state, stack, checker, resStatus);
+    if (manager->reordered == 1)
+      state.clear();
+  } while (manager->reordered == 1);
+  if (manager->errorCode == CUDD_TIMEOUT_EXPIRED && manager->timeoutHandler) {
+    manager->timeoutHandler(manager, manager->tohArg);
+  }
+  state.fillStats(stats);
+  if (status)
+    *status = resStatus;
+  return res;
+} // end of Cudd_bddAndAbstractMultiBudgeted
+
+
+
+
+
 /**
   @brief Approximates the conjunction of a set f of BDDs
 
@@ -220,9 +710,10 @@ Cudd_bddClippingAndMulti(
     int direction)
 {
   DdNode * res;
+  ClippingState state(0);
   do {
     dd->reordered = 0;
-    res = cuddBddClippingAndMultiRecur(dd, f, maxDepth, direction);
+    res = cuddBddClippingAndMultiRecur(dd, f, maxDepth, direction, state);
   } while(1 == dd->reordered);
   if (CUDD_TIMEOUT_EXPIRED == dd->errorCode && dd->timeoutHandler) {
     dd->timeoutHandler(dd, dd->tohArg);
@@ -257,11 +748,12 @@ Cudd_bddClippingAndAbstractMulti(
     int direction)
 {
   DdNode * res;
+  ClippingState state(0);
 
   do 
   {
     dd->reordered = 0;
-    res = cuddBddClippingAndAbstractMultiRecur(dd, f, cube, maxDepth, direction);
+    res = cuddBddClippingAndAbstractMultiRecur(dd, f, cube, maxDepth, direction, state);
   } while (1 == dd->reordered);
 
 
@@ -273,6 +765,74 @@ Cudd_bddClippingAndAbstractMulti(
 
 
 
+
+
+/**
+  @brief Approximates the conjunction of a set f of BDDs, with
+  the clipping depth chosen by a budget instead of fixed up front.
+
+  @details The conjunction is clipped wherever the manager has more
+  than budget->maxLiveNodes live nodes.  If budget->maxResultSize is
+  positive, the clipping depth is doubled, starting from
+  budget->initialDepth, for as long as the result has at most
+  budget->maxResultSize nodes and is still being clipped for depth;
+  the deepest result within that size is returned.  Every result
+  is an over approximation if direction is
+  dd_constants::Clip_Up and an under approximation otherwise.
+
+  @return a pointer to the resulting %BDD if successful; NULL if the
+  intermediate result blows up.
+
+  @sideeffect stats, if not NULL, is filled with the outcome
+
+  @see Cudd_bddClippingAndMulti
+
+*/
+DdNode *
+Cudd_bddClippingAndMultiAdaptive(
+    DdManager * dd,
+    std::set<DdNode *> const & f,
+    Cudd_ClippingBudget const * budget,
+    int direction,
+    Cudd_ClippingStats * stats)
+{
+  return cuddBddClippingAndMultiAdaptive(dd, f, DD_ONE(dd), budget, direction, stats);
+} // end of Cudd_bddClippingAndMultiAdaptive
+
+
+
+
+
+/**
+  @brief Approximates the conjunction of a set f of BDDs and
+  simultaneously abstracts the variables in cube, with the clipping
+  depth chosen by a budget instead of fixed up front.
+
+  @details The variables are existentially abstracted.
+  The budget is interpreted as in Cudd_bddClippingAndMultiAdaptive.
+
+  @return a pointer to the resulting %BDD if successful; NULL if the
+  intermediate result blows up.
+
+  @sideeffect stats, if not NULL, is filled with the outcome
+
+  @see Cudd_bddClippingAndAbstractMulti Cudd_bddClippingAndMultiAdaptive
+
+*/
+DdNode *
+Cudd_bddClippingAndAbstractMultiAdaptive(
+    DdManager * dd,
+    std::set<DdNode *> const & f,
+    DdNode * cube,
+    Cudd_ClippingBudget const * budget,
+    int direction,
+    Cudd_ClippingStats * stats)
+{
+  return cuddBddClippingAndMultiAdaptive(dd, f, cube, budget, direction, stats);
+} // end of Cudd_bddClippingAndAbstractMultiAdaptive
+
+
+
 /**
   @brief Returns the number of minterms of a set of %ADD or %BDD as a long double.
 
@@ -299,9 +859,11 @@ Cudd_LdblCountMintermMulti(
   if (HUGE_VALL == max)
     throw new std::runtime_error("OOM while counting minterms");
 
-  parakram::LruCache<std::set<DdNode *>, long double> cache(multiCacheCapacity);
-
-  long double count = cuddBddCountMintermMultiAux(manager, funcs, max, cache);
+  CountMultiState state(findPersistentMultiCache(manager), multiCacheSlots(manager, multiCacheCapacity));
+  NodeSet fSet(funcs.cbegin(), funcs.cend());
+  long double count = normalizeOperands(fSet, DD_ONE(manager))
+    ? cuddBddCountMintermMultiAux(manager, fSet, max, state, 0)
+    : 0;
 
   if (count >= powl(2.0L, (long double)(LDBL_MAX_EXP + LDBL_MIN_EXP)))
     throw std::runtime_error("min term count is too large to be scaled back");
@@ -316,66 +878,397 @@ Cudd_LdblCountMintermMulti(
 
 
 
+/**
+  @brief Returns log2 of the number of minterms of the conjunction of
+  a set of %BDDs.
+
+  @details Works in log space, so unlike Cudd_LdblCountMintermMulti it
+  neither overflows nor underflows, whatever the number of variables;
+  the result is a floating point estimate.
+  The memo table is private to the call, with as many slots as the
+  manager's computed table, capped by multiCacheCapacity.
+
+  @return log2 of the minterm count; -HUGE_VAL if there are none.
+
+  @sideeffect None
+
+  @see Cudd_LdblCountMintermMulti Cudd_ApaCountMintermMulti
+
+*/
+double
+Cudd_LogCountMintermMulti(
+    DdManager * manager,
+    const std::set<DdNode *> & funcs,
+    int numVars,
+    int multiCacheCapacity)
+{
+  PrivateCountMultiState<LogCountMultiCache> state(multiCacheSlots(manager, multiCacheCapacity));
+  NodeSet fSet(funcs.cbegin(), funcs.cend());
+  if (!normalizeOperands(fSet, DD_ONE(manager)))
+    return -HUGE_VAL;
+  return numVars + cuddBddLogCountMintermMultiAux(manager, fSet, state, 0);
+} // end of Cudd_LogCountMintermMulti
+
+
+
+
+
+/**
+  @brief Returns the exact number of minterms of the conjunction of
+  a set of %BDDs, as an arbitrary precision integer.
+
+  @details As with Cudd_LdblCountMintermMulti, the count is the
+  fraction of satisfying assignments times 2^numVars, so numVars
+  should be at least the size of the support of the conjunction.
+  The memo table is private to the call, with as many slots as the
+  manager's computed table, capped by multiCacheCapacity.
+
+  @return the minterm count
+
+  @sideeffect None
+
+  @see Cudd_LdblCountMintermMulti Cudd_LogCountMintermMulti
+
+*/
+parakram::BigUnsigned
+Cudd_ApaCountMintermMulti(
+    DdManager * manager,
+    const std::set<DdNode *> & funcs,
+    int numVars,
+    int multiCacheCapacity)
+{
+  PrivateCountMultiState<ApaCountMultiCache> state(multiCacheSlots(manager, multiCacheCapacity));
+  NodeSet fSet(funcs.cbegin(), funcs.cend());
+  if (!normalizeOperands(fSet, DD_ONE(manager)))
+    return parakram::BigUnsigned();
+
+  // count over all the variables of the manager,
+  // then rescale to numVars
+  auto count = cuddBddApaCountMintermMultiAux(manager, fSet, state, 0);
+  count <<= topLevel(manager, fSet);
+  int const numLevels = Cudd_ReadSize(manager);
+  if (numVars >= numLevels)
+    count <<= numVars - numLevels;
+  else
+    count >>= numLevels - numVars;
+  return count;
+} // end of Cudd_ApaCountMintermMulti
+
+
+
+
+
+/**
+  @brief Gives the manager a memo table for the multi operations
+  that persists across calls.
+
+  @details Cudd_bddAndAbstractMulti, Cudd_bddAndMulti and
+  Cudd_LdblCountMintermMulti normally build a fresh memo table per call.
+  Once enabled, they share one memo table per manager instead,
+  with as many slots as the manager's computed table,
+  capped by multiCacheCapacity (if positive).
+  The table is flushed by a pre-gc and a pre-reordering hook,
+  so that it never refers to nodes that may have been freed.
+  Must be disabled before the manager is destroyed.
+
+  @return 1 if successful; 0 otherwise.
+
+  @sideeffect Adds hooks to the manager
+
+  @see Cudd_MultiCacheDisable Cudd_MultiCacheReadStats
+
+*/
+int
+Cudd_MultiCacheEnable(
+    DdManager * manager,
+    int multiCacheCapacity)
+{
+  {
+    std::lock_guard<std::mutex> lock(persistentMultiCachesMutex);
+    auto & persistent = persistentMultiCaches[manager];
+    if (!persistent)
+      persistent.reset(new PersistentMultiCache(multiCacheSlots(manager, multiCacheCapacity)));
+  }
+  if (0 == Cudd_AddHook(manager, flushPersistentMultiCache, CUDD_PRE_GC_HOOK)
+      || 0 == Cudd_AddHook(manager, flushPersistentMultiCache, CUDD_PRE_REORDERING_HOOK))
+  {
+    Cudd_MultiCacheDisable(manager);
+    return 0;
+  }
+  return 1;
+} // end of Cudd_MultiCacheEnable
+
+
+
+/**
+  @brief Removes the persistent memo table of the multi operations.
+
+  @return 1 if the manager had a persistent memo table; 0 otherwise.
+
+  @sideeffect Removes the hooks added by Cudd_MultiCacheEnable
+
+  @see Cudd_MultiCacheEnable
+
+*/
+int
+Cudd_MultiCacheDisable(DdManager * manager)
+{
+  Cudd_RemoveHook(manager, flushPersistentMultiCache, CUDD_PRE_GC_HOOK);
+  Cudd_RemoveHook(manager, flushPersistentMultiCache, CUDD_PRE_REORDERING_HOOK);
+  std::lock_guard<std::mutex> lock(persistentMultiCachesMutex);
+  return persistentMultiCaches.erase(manager) > 0 ? 1 : 0;
+} // end of Cudd_MultiCacheDisable
+
+
+
+/**
+  @brief Reads the hit/miss statistics of the persistent memo table
+  of the multi operations, accumulated since it was enabled.
+
+  @return 1 if the manager has a persistent memo table; 0 otherwise.
+
+  @sideeffect stats is filled in
+
+  @see Cudd_MultiCacheEnable
+
+*/
+int
+Cudd_MultiCacheReadStats(
+    DdManager * manager,
+    Cudd_MultiCacheStats * stats)
+{
+  auto persistent = findPersistentMultiCache(manager);
+  if (NULL == persistent)
+    return 0;
+  stats->andLookups = persistent->andCache.numLookups();
+  stats->andHits = persistent->andCache.numHits();
+  stats->countLookups = persistent->countCache.numLookups();
+  stats->countHits = persistent->countCache.numHits();
+  stats->slots = persistent->andCache.numSlots();
+  stats->hookFlushes = persistent->numHookFlushes;
+  return 1;
+} // end of Cudd_MultiCacheReadStats
+
+
+
+
+
 // *****************************************
 // *** Internal api function definitions ***
 // *****************************************
 
 
 
+// ***** Function *****
+// Sorts the operands, removes duplicates and constant ones.
+// Returns false if the conjunction is trivially zero,
+// i.e., if there is a zero or a complementary pair.
+bool normalizeOperands(NodeSet & f, DdNode * one)
+{
+  f.sortUnique();
+  f.erase(one);
+  // f and !f differ only in the lowest bit,
+  // so complementary pairs are adjacent after sorting
+  for (size_t i = 0; i < f.size(); ++i)
+  {
+    if (f[i] == Cudd_Not(one))
+      return false;
+    if (i > 0 && Cudd_Regular(f[i]) == Cudd_Regular(f[i - 1]))
+      return false;
+  }
+  return true;
+} // end of normalizeOperands
+
+
+
+// ***** Function *****
+// Collects the then/else cofactors of the operands
+// w.r.t. the variable with the given index.
+void splitOperands(
+    NodeSet const & f,
+    unsigned int index,
+    NodeSet & tv,
+    NodeSet & ev)
+{
+  tv.clear();
+  ev.clear();
+  for (auto func: f)
+  {
+    auto F = Cudd_Regular(func);
+    if (F->index == index)
+    {
+      tv.push_back(Cudd_NotCond(cuddT(F), Cudd_IsComplement(func)));
+      ev.push_back(Cudd_NotCond(cuddE(F), Cudd_IsComplement(func)));
+    } else {
+      tv.push_back(func);
+      ev.push_back(func);
+    }
+  }
+} // end of splitOperands
+
+
+
+// ***** Function *****
+// Number of memo table slots for one multi operation:
+// the size of the manager's computed table,
+// capped by the caller's cache capacity (if positive).
+size_t multiCacheSlots(DdManager * manager, int multiCacheCapacity)
+{
+  size_t slots = Cudd_ReadCacheSlots(manager);
+  if (multiCacheCapacity > 0 && static_cast<size_t>(multiCacheCapacity) < slots)
+    slots = multiCacheCapacity;
+  return slots;
+} // end of multiCacheSlots
+
+
+
+// ***** Function *****
+// Computes (and memoizes) the support signature of a bdd.
+SupportSignature supportSignature(
+    DdManager * manager,
+    DdNode * f,
+    AndMultiState & state)
+{
+  auto F = Cudd_Regular(f);
+  if (cuddIsConstant(F))
+    return SupportSignature{ INT_MAX, -1, 0 };
+
+  auto cached = state.signatures->tryGet(&F, 1, NULL);
+  if (cached.isPresent())
+    return cached.get();
+
+  auto t = supportSignature(manager, cuddT(F), state);
+  auto e = supportSignature(manager, cuddE(F), state);
+  SupportSignature result{
+    manager->perm[F->index],
+    std::max(manager->perm[F->index], std::max(t.bottom, e.bottom)),
+    (1ULL << (F->index & 63)) | t.bloom | e.bloom };
+  state.signatures->insert(&F, 1, NULL, result);
+  return result;
+} // end of supportSignature
+
+
+
+// ***** Function *****
+// Groups the operands into components with disjoint supports.
+// Returns the number of components; if more than one,
+// the components are stored in frame.components.
+size_t findComponents(
+    DdManager * manager,
+    NodeSet const & f,
+    AndMultiState & state,
+    AndMultiFrame & frame)
+{
+  auto & componentOf = frame.componentOf;
+  auto & signatures = frame.componentSignatures;
+  componentOf.resize(f.size());
+  signatures.clear();
+  size_t numComponents = 0;
+
+  // union the components of all operands with intersecting signatures
+  for (size_t i = 0; i < f.size(); ++i)
+  {
+    auto sig = supportSignature(manager, f[i], state);
+    size_t target = signatures.size();
+    for (size_t c = 0; c < signatures.size(); ++c)
+    {
+      auto & csig = signatures[c];
+      if (csig.bottom < csig.top || !csig.intersects(sig))
+        continue; // dead component, or independent of f[i]
+      if (target == signatures.size())
+        target = c;
+      else
+      {
+        // merge component c into target
+        auto & tsig = signatures[target];
+        tsig.top = std::min(tsig.top, csig.top);
+        tsig.bottom = std::max(tsig.bottom, csig.bottom);
+        tsig.bloom |= csig.bloom;
+        csig.top = 1;
+        csig.bottom = 0;
+        for (size_t j = 0; j < i; ++j)
+          if (componentOf[j] == c)
+            componentOf[j] = target;
+        --numComponents;
+      }
+    }
+    if (target == signatures.size())
+    {
+      signatures.push_back(sig);
+      ++numComponents;
+    } else {
+      auto & tsig = signatures[target];
+      tsig.top = std::min(tsig.top, sig.top);
+      tsig.bottom = std::max(tsig.bottom, sig.bottom);
+      tsig.bloom |= sig.bloom;
+    }
+    componentOf[i] = target;
+  }
+  if (numComponents < 2)
+    return numComponents;
+
+  // collect the operands of every live component, preserving the order
+  if (frame.components.size() < numComponents)
+    frame.components.resize(numComponents);
+  size_t numCollected = 0;
+  for (size_t c = 0; c < signatures.size(); ++c)
+  {
+    if (signatures[c].bottom < signatures[c].top)
+      continue;
+    auto & component = frame.components[numCollected++];
+    component.clear();
+    for (size_t i = 0; i < f.size(); ++i)
+      if (componentOf[i] == c)
+        component.push_back(f[i]);
+  }
+  frame.components.resize(numComponents);
+  return numComponents;
+} // end of findComponents
+
+
+
 // *** Function *****
 // Recursive and-abstract implementation
+// fSet must be normalized (see normalizeOperands)
 DdNode * cuddBddAndAbstractMultiRecur(
     DdManager * manager,
-    std::set<DdNode*> const & fSet2,
+    NodeSet const & fSet,
     DdNode * cube,
-    parakram::LruCache<std::set<DdNode *>, DdNode *> & cache)
+    AndMultiState & state,
+    size_t depth)
 {
 
   statLine(manager);
+  ++state.numRecursions;
   auto one = DD_ONE(manager);
   auto zero = Cudd_Not(one);
   DdNode * r = NULL;
 
-  auto fSet = fSet2;
-  fSet.erase(one);
-
   // Terminal cases.
-  // if any of the funcs is zero, return zero
-  if (fSet.count(zero) == 1) return zero;
-
-  // if any of the funcs is the not of any other func, return zero
-  for (auto f: fSet)
-    if (fSet.count(Cudd_Not(f)) > 0)
-      return zero;
-
   // if all of the funcs are one, return one
   if (fSet.empty()) return one;
 
-  // check cache
-  auto cachedResult = cache.tryGet(fSet);
-  if (cachedResult.isPresent())
-    return cachedResult.get();
-
   // if there is only one element, no more need for conjunction
   if (fSet.size() == 1)
-  {
-    r = cuddBddExistAbstractRecur(manager, *fSet.cbegin(), cube);
-    cache.insert(fSet, r);
-    return r;
-  }
+    return cuddBddExistAbstractRecur(manager, fSet[0], cube);
 
   // if cube is empty, return the conjunction
   if (cube == one)
-  {
-    r = cuddBddAndMultiRecur(manager, fSet, cache);
-    // cache.insert(fSet, r); // should already be in the cache
-    return r;
-  }
+    return cuddBddAndMultiRecur(manager, fSet, state, depth);
 
   // find the top variable of the set of functions
-  int top = manager->perm[Cudd_Regular(*fSet.cbegin())->index];
+  unsigned int index = Cudd_Regular(fSet[0])->index;
+  int top = manager->perm[index];
   for (auto f: fSet)
-    top = ddMin(top, manager->perm[Cudd_Regular(f)->index]);
+  {
+    auto F = Cudd_Regular(f);
+    int topf = manager->perm[F->index];
+    if (topf < top)
+    {
+      top = topf;
+      index = F->index;
+    }
+  }
 
   // find the top variables of the quantified variables
   int topcube = manager->perm[cube->index];
@@ -383,55 +1276,78 @@ DdNode * cuddBddAndAbstractMultiRecur(
   // skip the quantified variables until there is something to quantify
   while (topcube < top) {
     cube = cuddT(cube);
-    if (cube == one) { // if there is nothing to quantify, return the conjunction
-      r = (cuddBddAndMultiRecur(manager, fSet, cache));
-      // cache.insert(fSet, r); // should already be in the cache
-      return r;
-    }
+    if (cube == one) // if there is nothing to quantify, return the conjunction
+      return cuddBddAndMultiRecur(manager, fSet, state, depth);
     topcube = manager->perm[cube->index];
   }
 
-  // collect the 'then's and 'else's
-  std::set<DdNode *> tv, ev;
-  int index = 0;
-  for (auto f: fSet)
+  // check cache
+  r = state.lookup(manager, fSet, cube);
+  if (NULL != r)
+    return r;
+
+  auto & frame = state.frame(depth);
+
+  // if the operands fall apart into groups with disjoint supports,
+  // then and-abstract each group separately and conjoin the results
+  if (state.decompose && findComponents(manager, fSet, state, frame) > 1)
   {
-    auto F = Cudd_Regular(f);
-    auto topf = manager->perm[F->index];
-    if (topf == top) {
-      index = F->index;
-      auto t = cuddT(F);
-      auto e = cuddE(F);
-      if (Cudd_IsComplement(f)) {
-        t = Cudd_Not(t);
-        e = Cudd_Not(e);
+    ++state.numDecompositions;
+    r = one;
+    cuddRef(r);
+    for (auto const & component: frame.components)
+    {
+      auto c = cuddBddAndAbstractMultiRecur(manager, component, cube, state, depth + 1);
+      if (NULL == c)
+      {
+        Cudd_IterDerefBdd(manager, r);
+        return NULL;
       }
-      tv.insert(t);
-      ev.insert(e);
-    } else {
-      tv.insert(f);
-      ev.insert(f);
+      cuddRef(c);
+      auto rc = cuddBddAndRecur(manager, r, c);
+      if (NULL == rc)
+      {
+        Cudd_IterDerefBdd(manager, r);
+        Cudd_IterDerefBdd(manager, c);
+        return NULL;
+      }
+      cuddRef(rc);
+      Cudd_IterDerefBdd(manager, r);
+      Cudd_IterDerefBdd(manager, c);
+      r = rc;
+      if (r == zero)
+        break;
     }
+    cuddDeref(r);
+    state.insert(fSet, cube, r);
+    return r;
   }
 
+  // collect the 'then's and 'else's
+  NodeSet & tv = frame.tv;
+  NodeSet & ev = frame.ev;
+  splitOperands(fSet, index, tv, ev);
+  bool const tvIsZero = !normalizeOperands(tv, one);
+  bool const evIsZero = !normalizeOperands(ev, one);
+
   // need to quantify the topmost variable
   if (topcube == top) {
     auto remainingCube = cuddT(cube);
-    auto t = cuddBddAndAbstractMultiRecur(manager, tv, remainingCube, cache);
+    auto t = tvIsZero ? zero : cuddBddAndAbstractMultiRecur(manager, tv, remainingCube, state, depth + 1);
     if (t == NULL) return NULL;
     // Special case: 1 or anything = 1. Hence, no need to compute
     // the else branch if t is 1. Likewise t + t * anything = t.
     // Notice that t == fe implies that fe does not depend on the
     // variables in the Cube.
-    if (t == one || std::find(ev.cbegin(), ev.cend(), t) != ev.cend()) {
-      cache.insert(fSet, t);
+    if (t == one || evIsZero || std::binary_search(ev.begin(), ev.end(), t)) {
+      state.insert(fSet, cube, t);
       return t;
     }
 
     cuddRef(t);
     // Special case: t + !t * anything == t + anything
     ev.erase(Cudd_Not(t));
-    auto e = cuddBddAndAbstractMultiRecur(manager, ev, remainingCube, cache);
+    auto e = cuddBddAndAbstractMultiRecur(manager, ev, remainingCube, state, depth + 1);
     if (NULL == e)
     {
       Cudd_IterDerefBdd(manager, t);
@@ -458,10 +1374,10 @@ DdNode * cuddBddAndAbstractMultiRecur(
   } // end of case where you need to quantify
   else
   { // no need to quantify
-    auto t = cuddBddAndAbstractMultiRecur(manager, tv, cube, cache);
+    auto t = tvIsZero ? zero : cuddBddAndAbstractMultiRecur(manager, tv, cube, state, depth + 1);
     if (NULL == t) return NULL;
     cuddRef(t);
-    auto e = cuddBddAndAbstractMultiRecur(manager, ev, cube, cache);
+    auto e = evIsZero ? zero : cuddBddAndAbstractMultiRecur(manager, ev, cube, state, depth + 1);
     if (NULL == e)
     {
       Cudd_IterDerefBdd(manager, t);
@@ -498,7 +1414,7 @@ DdNode * cuddBddAndAbstractMultiRecur(
     }
   }
 
-  cache.insert(fSet, r);
+  state.insert(fSet, cube, r);
   return r;
 } // end of cuddBddAndAbstractMultiRecur
 
@@ -509,38 +1425,29 @@ DdNode * cuddBddAndAbstractMultiRecur(
 
 // ***** Function *****
 // Recursive "and" implementation
+// fSet must be normalized (see normalizeOperands)
 DdNode * cuddBddAndMultiRecur(
     DdManager * manager,
-    std::set<DdNode *> const & fset,
-    parakram::LruCache<std::set<DdNode *>, DdNode *> & cache)
+    NodeSet const & fSet,
+    AndMultiState & state,
+    size_t depth)
 {
   statLine(manager);
+  ++state.numRecursions;
   auto one = DD_ONE(manager);
   auto zero = Cudd_Not(one);
 
   // Terminal cases
-  std::set<DdNode *> fSet = fset;
-  fSet.erase(one);
   if (fSet.empty())
     return one;
   if (fSet.size() == 1)
-    return *fSet.cbegin();
-  if (fSet.size() == 2)
-  {
-    auto first = fSet.cbegin();
-    auto second = fSet.cbegin();
-    ++second;
-    if (*first == Cudd_Not(*second))
-      return zero;
-  } 
-  if (fSet.count(zero) > 0)
-    return zero;
+    return fSet[0];
 
-  auto optResult = cache.tryGet(fSet);
-  if (optResult.isPresent())
-    return optResult.get();
+  auto cachedResult = state.lookup(manager, fSet, one);
+  if (NULL != cachedResult)
+    return cachedResult;
 
-  auto index = Cudd_Regular(*fSet.cbegin())->index;
+  auto index = Cudd_Regular(fSet[0])->index;
   auto top = manager->perm[index];
   for (auto f: fSet)
   {
@@ -553,25 +1460,18 @@ DdNode * cuddBddAndMultiRecur(
     }
   }
 
-  std::set<DdNode *> tv, ev;
-  for (auto f: fSet)
-  {
-    auto F = Cudd_Regular(f);
-    if (index == F->index)
-    {
-      tv.insert(Cudd_IsComplement(f) ? Cudd_Not(cuddT(F)) : cuddT(F));
-      ev.insert(Cudd_IsComplement(f) ? Cudd_Not(cuddE(F)) : cuddE(F));
-    } else {
-      tv.insert(f);
-      ev.insert(f);
-    }
-  }
+  auto & frame = state.frame(depth);
+  NodeSet & tv = frame.tv;
+  NodeSet & ev = frame.ev;
+  splitOperands(fSet, index, tv, ev);
+  bool const tvIsZero = !normalizeOperands(tv, one);
+  bool const evIsZero = !normalizeOperands(ev, one);
 
-  auto t = cuddBddAndMultiRecur(manager, tv, cache);
+  auto t = tvIsZero ? zero : cuddBddAndMultiRecur(manager, tv, state, depth + 1);
   if (NULL == t) return NULL;
   cuddRef(t);
 
-  auto e = cuddBddAndMultiRecur(manager, ev, cache);
+  auto e = evIsZero ? zero : cuddBddAndMultiRecur(manager, ev, state, depth + 1);
   if (NULL == e)
   {
     Cudd_IterDerefBdd(manager, t);
@@ -610,13 +1510,214 @@ DdNode * cuddBddAndMultiRecur(
   }
   cuddDeref(e);
   cuddDeref(t);
-  cache.insert(fSet, r);
+  state.insert(fSet, one, r);
   return r;
 } // end cuddBddAndMultiRecur
 
 
 
 
+
+
+// ***** Function *****
+// Iterative "and-abstract" implementation.
+// Follows the same steps as cuddBddAndAbstractMultiRecur
+// (without the component decomposition),
+// but keeps the pending calls on an explicit stack,
+// and gives up as soon as the budget is exceeded.
+// Binary and single operand steps are left to the cudd recursions.
+// fSet must be normalized (see normalizeOperands)
+DdNode * cuddBddAndAbstractMultiIter(
+    DdManager * manager,
+    NodeSet const & fSet,
+    DdNode * cube,
+    AndMultiState & state,
+    std::deque<AndAbstractTask> & stack,
+    AndAbstractBudget const & budget,
+    Cudd_MultiStatus & status)
+{
+  auto one = DD_ONE(manager);
+  auto zero = Cudd_Not(one);
+  size_t sp = 0;
+  DdNode * ret = NULL; // result of the last finished task
+
+  auto push = [&](NodeSet const & operands, DdNode * taskCube) {
+    if (sp == stack.size())
+      stack.emplace_back();
+    auto & task = stack[sp++];
+    task.phase = AndAbstractTask::Start;
+    task.fSet = operands;
+    task.cube = taskCube;
+    task.t = NULL;
+  };
+
+  auto failure = [&]() {
+    return CUDD_TIMEOUT_EXPIRED == manager->errorCode ? CUDD_MULTI_TIME_EXCEEDED : CUDD_MULTI_FAILED;
+  };
+
+  status = CUDD_MULTI_SUCCESS;
+  push(fSet, cube);
+  for (unsigned long iteration = 0; sp > 0; ++iteration)
+  {
+    if (NULL == ret && AndAbstractTask::Start != stack[sp - 1].phase)
+      status = failure(); // a child has failed
+    else if (0 == (iteration & 255))
+      status = budget.check(manager);
+    if (CUDD_MULTI_SUCCESS != status)
+    {
+      // unwind, releasing the then results held by the pending tasks
+      for (size_t i = 0; i < sp; ++i)
+        if (AndAbstractTask::AwaitElse == stack[i].phase)
+          Cudd_IterDerefBdd(manager, stack[i].t);
+      return NULL;
+    }
+
+    auto & task = stack[sp - 1];
+    switch (task.phase)
+    {
+      case AndAbstractTask::Start:
+      {
+        statLine(manager);
+        ++state.numRecursions;
+
+        // terminal cases
+        if (task.fSet.empty())
+        {
+          ret = one;
+          --sp;
+          continue;
+        }
+        if (task.fSet.size() == 1)
+        {
+          ret = task.cube == one ? task.fSet[0] : cuddBddExistAbstractRecur(manager, task.fSet[0], task.cube);
+          --sp;
+          continue;
+        }
+
+        // find the top variable, and skip the quantified variables above it
+        task.index = Cudd_Regular(task.fSet[0])->index;
+        int top = manager->perm[task.index];
+        for (auto f: task.fSet)
+        {
+          auto F = Cudd_Regular(f);
+          if (manager->perm[F->index] < top)
+          {
+            top = manager->perm[F->index];
+            task.index = F->index;
+          }
+        }
+        while (task.cube != one && manager->perm[task.cube->index] < top)
+          task.cube = cuddT(task.cube);
+        task.quantify = task.cube != one && manager->perm[task.cube->index] == top;
+        task.childCube = task.quantify ? cuddT(task.cube) : task.cube;
+
+        // check cache
+        ret = state.lookup(manager, task.fSet, task.cube);
+        if (NULL != ret)
+        {
+          --sp;
+          continue;
+        }
+
+        // collect the 'then's and 'else's
+        splitOperands(task.fSet, task.index, task.tv, task.ev);
+        bool const tvIsZero = !normalizeOperands(task.tv, one);
+        task.evIsZero = !normalizeOperands(task.ev, one);
+        task.phase = AndAbstractTask::AwaitThen;
+        if (tvIsZero)
+          ret = zero;
+        else
+          push(task.tv, task.childCube);
+        continue;
+      }
+
+      case AndAbstractTask::AwaitThen:
+      {
+        auto t = ret;
+        if (task.quantify)
+        {
+          // t or anything = t, see cuddBddAndAbstractMultiRecur
+          if (t == one || task.evIsZero || std::binary_search(task.ev.begin(), task.ev.end(), t))
+          {
+            state.insert(task.fSet, task.cube, t);
+            --sp;
+            continue;
+          }
+          // t + !t * anything == t + anything
+          task.ev.erase(Cudd_Not(t));
+        }
+        cuddRef(t);
+        task.t = t;
+        task.phase = AndAbstractTask::AwaitElse;
+        if (task.evIsZero)
+          ret = zero;
+        else
+          push(task.ev, task.childCube);
+        continue;
+      }
+
+      case AndAbstractTask::AwaitElse:
+      {
+        auto t = task.t;
+        auto e = ret;
+        DdNode * r;
+        if (t == e)
+        {
+          r = t;
+          cuddDeref(t);
+        }
+        else if (task.quantify)
+        {
+          cuddRef(e);
+          r = cuddBddAndRecur(manager, Cudd_Not(t), Cudd_Not(e));
+          if (NULL != r)
+          {
+            r = Cudd_Not(r);
+            cuddRef(r);
+          }
+          Cudd_IterDerefBdd(manager, t);
+          Cudd_IterDerefBdd(manager, e);
+          if (NULL != r)
+            cuddDeref(r);
+        }
+        else
+        {
+          cuddRef(e);
+          bool const isComplement = Cudd_IsComplement(t);
+          r = isComplement
+            ? cuddUniqueInter(manager, (int) task.index, Cudd_Not(t), Cudd_Not(e))
+            : cuddUniqueInter(manager, (int) task.index, t, e);
+          if (NULL == r)
+          {
+            Cudd_IterDerefBdd(manager, t);
+            Cudd_IterDerefBdd(manager, e);
+          }
+          else
+          {
+            if (isComplement)
+              r = Cudd_Not(r);
+            cuddDeref(e);
+            cuddDeref(t);
+          }
+        }
+        // the then result is released (or handed over to r) either way
+        task.phase = AndAbstractTask::Start;
+        --sp;
+        ret = r;
+        if (NULL != r)
+          state.insert(task.fSet, task.cube, r);
+        continue;
+      }
+    }
+  }
+  if (NULL == ret)
+    status = failure();
+  return ret;
+} // end of cuddBddAndAbstractMultiIter
+
+
+
+
 /**
   @brief Implements the recursive step of Cudd_bddClippingAndMulti
 
@@ -634,7 +1735,8 @@ cuddBddClippingAndMultiRecur(
     DdManager * manager,
     std::set<DdNode *> const & f,
     int distance,
-    int direction)
+    int direction,
+    ClippingState & state)
 {
   statLine(manager);
   auto one = DD_ONE(manager);
@@ -656,7 +1758,7 @@ cuddBddClippingAndMultiRecur(
   else if (f2.size() == 0)
     return one;
 
-  if (distance == 0) {
+  if (state.mustClip(manager, distance)) {
     auto min = *f2.cbegin();
     for (auto fit = f2.cbegin(); NULL != min && fit != f2.cend(); ++fit)
     {
@@ -719,10 +1821,10 @@ cuddBddClippingAndMultiRecur(
     fe.insert(el);
   }
 
-  auto t = cuddBddClippingAndMultiRecur(manager, ft, distance, direction);
+  auto t = cuddBddClippingAndMultiRecur(manager, ft, distance, direction, state);
   if (NULL == t) return NULL;
   cuddRef(t);
-  auto e = cuddBddClippingAndMultiRecur(manager, fe, distance, direction);
+  auto e = cuddBddClippingAndMultiRecur(manager, fe, distance, direction, state);
   if (NULL == e)
   {
     Cudd_RecursiveDeref(manager, t);
@@ -789,7 +1891,8 @@ cuddBddClippingAndAbstractMultiRecur(
     std::set<DdNode *> const & f,
     DdNode * cube,
     int distance,
-    int direction)
+    int direction,
+    ClippingState & state)
 {
 
   statLine(manager);
@@ -810,11 +1913,11 @@ cuddBddClippingAndAbstractMultiRecur(
   // if no elements then return true
   if (f2.size() == 0) return one;
   // if nothing more to abstract, just compute and
-  if (cube == one) return cuddBddClippingAndMultiRecur(manager, f2, distance, direction);
+  if (cube == one) return cuddBddClippingAndMultiRecur(manager, f2, distance, direction, state);
   // if only one element, compute abstraction
   if (f2.size() == 1) return cuddBddExistAbstractRecur(manager, *f2.cbegin(), cube);
   // if distance 0 then just return true or false depending on direction
-  if (0 == distance) return Cudd_NotCond(one, (0 == direction));
+  if (state.mustClip(manager, distance)) return Cudd_NotCond(one, (0 == direction));
 
   // At this point, f2 does not have any constants
   --distance;
@@ -845,7 +1948,7 @@ cuddBddClippingAndAbstractMultiRecur(
   if (topCube < minTop)
     return cuddBddClippingAndAbstractMultiRecur(
         manager, f2, cuddT(cube), 
-        distance, direction);
+        distance, direction, state);
 
   // collect then-s and else-s
   std::set<DdNode *> ft, fe;
@@ -876,7 +1979,7 @@ cuddBddClippingAndAbstractMultiRecur(
 
   // compute the 'then' part of the result
   auto nextCube = (topCube == minTop) ? cuddT(cube) : cube;
-  auto t = cuddBddClippingAndAbstractMultiRecur(manager, ft, nextCube, distance, direction);
+  auto t = cuddBddClippingAndAbstractMultiRecur(manager, ft, nextCube, distance, direction, state);
   if (NULL == t) return NULL;
   
   // Special case: 
@@ -888,7 +1991,7 @@ cuddBddClippingAndAbstractMultiRecur(
   cuddRef(t);
 
   // compute the 'else' part of the result
-  auto e = cuddBddClippingAndAbstractMultiRecur(manager, fe, nextCube, distance, direction);
+  auto e = cuddBddClippingAndAbstractMultiRecur(manager, fe, nextCube, distance, direction, state);
   if (NULL == e)
   {
     Cudd_RecursiveDeref(manager, t);
@@ -906,7 +2009,7 @@ cuddBddClippingAndAbstractMultiRecur(
     teSet.insert(Cudd_Not(e));
     DdNode * result = cuddBddClippingAndMultiRecur(
         manager, teSet,
-        distance, (direction == 0));
+        distance, (direction == 0), state);
     if (NULL == result)
     {
       Cudd_RecursiveDeref(manager, t);
@@ -960,42 +2063,112 @@ cuddBddClippingAndAbstractMultiRecur(
 
 
 
+
+
+
+// ***** Function *****
+// Shared driver of the adaptive clipping operations
+// cube is DD_ONE for plain conjunction
+DdNode * cuddBddClippingAndMultiAdaptive(
+    DdManager * manager,
+    std::set<DdNode *> const & f,
+    DdNode * cube,
+    Cudd_ClippingBudget const * budget,
+    int direction,
+    Cudd_ClippingStats * stats)
+{
+  auto const one = DD_ONE(manager);
+  int maxResultSize = budget ? budget->maxResultSize : 0;
+  ClippingState state(budget ? budget->maxLiveNodes : 0);
+
+  // without a size target there is nothing to deepen towards,
+  // so only the live node budget clips
+  int depth = maxResultSize > 0 ? std::max(1, budget->initialDepth) : INT_MAX;
+
+  DdNode * best = NULL;
+  int bestDepth = 0;
+  unsigned long long bestClips = 0;
+  unsigned long long numRounds = 0;
+  while (true)
+  {
+    DdNode * res;
+    do
+    {
+      manager->reordered = 0;
+      state.reset();
+      res = (cube == one)
+        ? cuddBddClippingAndMultiRecur(manager, f, depth, direction, state)
+        : cuddBddClippingAndAbstractMultiRecur(manager, f, cube, depth, direction, state);
+    } while (1 == manager->reordered);
+    ++numRounds;
+    if (NULL == res)
+      break;
+    cuddRef(res);
+
+    // a deeper result that outgrew the target is dropped,
+    // the shallowest one is kept whatever its size
+    int resSize = Cudd_DagSize(res);
+    if (NULL != best && resSize > maxResultSize)
+    {
+      Cudd_RecursiveDeref(manager, res);
+      break;
+    }
+    if (NULL != best)
+      Cudd_RecursiveDeref(manager, best);
+    best = res;
+    bestDepth = depth;
+    bestClips = state.numClips;
+
+    // deeper results are identical once nothing is clipped for depth
+    if (!state.clippedByDepth || resSize > maxResultSize || depth > INT_MAX / 2)
+      break;
+    depth *= 2;
+  }
+
+  if (NULL == best)
+  {
+    if (CUDD_TIMEOUT_EXPIRED == manager->errorCode && manager->timeoutHandler)
+      manager->timeoutHandler(manager, manager->tohArg);
+    return NULL;
+  }
+
+  if (stats)
+  {
+    stats->depth = bestDepth;
+    stats->rounds = numRounds;
+    stats->clips = bestClips;
+    stats->exact = (0 == bestClips);
+  }
+  cuddDeref(best);
+  return best;
+} // end of cuddBddClippingAndMultiAdaptive
+
+
+
 long double cuddBddCountMintermMultiAux(
     DdManager * manager,
-    const std::set<DdNode *> & f,
+    NodeSet const & f,
     long double max,
-    parakram::LruCache<std::set<DdNode *>, long double> & cache)
+    CountMultiState & state,
+    size_t depth)
 {
   const auto one = DD_ONE(manager);
-  const auto zero = Cudd_Not(one);
-
-  // if any of the funcs is false
-  // then there are zero solutions
-  if (f.count(zero) > 0)
-    return 0;
-
-  // filter away true funcs
-  // as they cannot affect the answer
-  std::set<DdNode *> funcs;
-  for (const auto func: f)
-    if(func != one)
-      funcs.insert(func);
 
   // no funcs left, so all funcs must have been true
-  if (funcs.empty())
+  if (f.empty())
     return max;
 
   // check cache
-  auto cacheResult = cache.tryGet(funcs);
+  auto cacheResult = state.cache->tryGet(f.data(), f.size(), NULL);
   if (cacheResult.isPresent())
-    return cacheResult.get();
+    return cacheResult.get() * max;
 
   // find the earliest variable
-  int minIndex = Cudd_Regular(*funcs.cbegin())->index;
+  unsigned int minIndex = Cudd_Regular(f[0])->index;
   int minTop = manager->perm[minIndex];
-  for (const auto func: funcs)
+  for (const auto func: f)
   {
-    int index = Cudd_Regular(func)->index;
+    unsigned int index = Cudd_Regular(func)->index;
     int top = manager->perm[index];
     if (top < minTop)
     {
@@ -1004,56 +2177,116 @@ long double cuddBddCountMintermMultiAux(
     }
   }
 
-
-  // process the "then" children
-  std::set<DdNode *> children;
-  for (const auto func: funcs)
-  {
-    int index = Cudd_Regular(func)->index;
-    if (index == minIndex)
-    {
-      // This is one of the nodes
-      // that is splitting on the earliest variable.
-      // So we need to take the "then" child
-      DdNode * t = cuddT(Cudd_Regular(func));
-      if (Cudd_IsComplement(func))
-        t = Cudd_Not(t);
-      children.insert(t);
-    } else
-    {
-      // This node will split later,
-      // so just keep it as it is
-      children.insert(func);
-    }
-  }
-  const long double tCount = cuddBddCountMintermMultiAux(manager, children, max, cache);
-
-
-  // process the "else" children
-  children.clear();
-  for (const auto func: funcs)
-  {
-    int index = Cudd_Regular(func)->index;
-    if (index == minIndex)
-    {
-      // split on this node
-      DdNode * e = cuddE(Cudd_Regular(func));
-      if (Cudd_IsComplement(func))
-        e = Cudd_Not(e);
-      children.insert(e);
-    } else
-    {
-      // do not split on this node yet
-      children.insert(func);
-    }
-  }
-  const long double eCount = cuddBddCountMintermMultiAux(manager, children, max, cache);
+  // count the "then" and "else" children,
+  // a zero child or a complementary pair has no solutions
+  auto & frame = state.frame(depth);
+  NodeSet & tv = frame.tv;
+  NodeSet & ev = frame.ev;
+  splitOperands(f, minIndex, tv, ev);
+  const bool tvIsZero = !normalizeOperands(tv, one);
+  const bool evIsZero = !normalizeOperands(ev, one);
+  const long double tCount = tvIsZero ? 0 : cuddBddCountMintermMultiAux(manager, tv, max, state, depth + 1);
+  const long double eCount = evIsZero ? 0 : cuddBddCountMintermMultiAux(manager, ev, max, state, depth + 1);
 
   // compute result, put into cache, and return
+  // (the cache holds fractions of max, so that entries of the
+  // persistent cache can be shared across different numVars)
   const long double fullCount = (tCount * .5) + (eCount * .5);
-  cache.insert(funcs, fullCount);
+  state.cache->insert(f.data(), f.size(), NULL, fullCount / max);
   return fullCount;
 
 
 } // end of cuddBddCountMintermMultiAux
 
+
+
+
+
+// ***** Function *****
+// Recursive model counting in log space
+double cuddBddLogCountMintermMultiAux(
+    DdManager * manager,
+    NodeSet const & f,
+    PrivateCountMultiState<LogCountMultiCache> & state,
+    size_t depth)
+{
+  const auto one = DD_ONE(manager);
+
+  // no funcs left, so all assignments are solutions
+  if (f.empty())
+    return 0;
+
+  auto cacheResult = state.cache.tryGet(f.data(), f.size(), NULL);
+  if (cacheResult.isPresent())
+    return cacheResult.get();
+
+  auto & frame = state.frame(depth);
+  NodeSet & tv = frame.tv;
+  NodeSet & ev = frame.ev;
+  splitOperands(f, manager->invperm[topLevel(manager, f)], tv, ev);
+  const double tLog = normalizeOperands(tv, one) ? cuddBddLogCountMintermMultiAux(manager, tv, state, depth + 1) : -HUGE_VAL;
+  const double eLog = normalizeOperands(ev, one) ? cuddBddLogCountMintermMultiAux(manager, ev, state, depth + 1) : -HUGE_VAL;
+
+  // log2((2^tLog + 2^eLog) / 2), without leaving log space
+  const double hi = std::max(tLog, eLog);
+  const double lo = std::min(tLog, eLog);
+  const double result = (lo == -HUGE_VAL) ? hi - 1 : hi + std::log2(1 + std::exp2(lo - hi)) - 1;
+  state.cache.insert(f.data(), f.size(), NULL, result);
+  return result;
+
+} // end of cuddBddLogCountMintermMultiAux
+
+
+
+
+
+// ***** Function *****
+// Recursive exact model counting
+parakram::BigUnsigned cuddBddApaCountMintermMultiAux(
+    DdManager * manager,
+    NodeSet const & f,
+    PrivateCountMultiState<ApaCountMultiCache> & state,
+    size_t depth)
+{
+  const auto one = DD_ONE(manager);
+
+  // no funcs left, the only assignment is the empty one
+  if (f.empty())
+    return parakram::BigUnsigned(1);
+
+  auto cacheResult = state.cache.tryGet(f.data(), f.size(), NULL);
+  if (cacheResult.isPresent())
+    return cacheResult.get();
+
+  // each child is counted from its own top level,
+  // so the levels skipped in between double its count
+  const int level = topLevel(manager, f);
+  auto & frame = state.frame(depth);
+  NodeSet & tv = frame.tv;
+  NodeSet & ev = frame.ev;
+  splitOperands(f, manager->invperm[level], tv, ev);
+  parakram::BigUnsigned result;
+  if (normalizeOperands(tv, one))
+    result += cuddBddApaCountMintermMultiAux(manager, tv, state, depth + 1) << (topLevel(manager, tv) - level - 1);
+  if (normalizeOperands(ev, one))
+    result += cuddBddApaCountMintermMultiAux(manager, ev, state, depth + 1) << (topLevel(manager, ev) - level - 1);
+
+  state.cache.insert(f.data(), f.size(), NULL, result);
+  return result;
+
+} // end of cuddBddApaCountMintermMultiAux
+
+
+
+
+
+// ***** Function *****
+// Top level of a set of operands
+int topLevel(DdManager * manager, NodeSet const & f)
+{
+  int level = manager->size;
+  for (const auto func: f)
+    level = std::min(level, static_cast<int>(manager->perm[Cudd_Regular(func)->index]));
+  return level;
+} // end of topLevel
+
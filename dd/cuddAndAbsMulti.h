@@ -27,13 +27,82 @@ SOFTWARE.
 #include <stdio.h>
 #include <cudd.h>
 #include <set>
+#include "big_unsigned.h"
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+/**
+  @brief Statistics of one Cudd_bddAndAbstractMulti / Cudd_bddAndMulti call.
+*/
+struct Cudd_MultiStats {
+  unsigned long long recursions;    /**< number of recursive calls */
+  unsigned long long cacheLookups;  /**< number of memo table lookups */
+  unsigned long long cacheHits;     /**< number of memo table hits */
+  unsigned long long cacheSlots;    /**< size of the memo table */
+  unsigned long long decompositions; /**< number of splits into independent components */
+};
+
+/**
+  @brief Limits for Cudd_bddAndAbstractMultiBudgeted.
+*/
+struct Cudd_MultiBudget {
+  double timeLimit;            /**< seconds, non-positive for no limit */
+  unsigned long maxLiveNodes;  /**< live nodes in the manager, 0 for no limit */
+};
+
+/**
+  @brief Outcome of Cudd_bddAndAbstractMultiBudgeted.
+*/
+typedef enum {
+  CUDD_MULTI_SUCCESS,
+  CUDD_MULTI_TIME_EXCEEDED,
+  CUDD_MULTI_NODES_EXCEEDED,
+  CUDD_MULTI_FAILED
+} Cudd_MultiStatus;
+
+/**
+  @brief Budget for Cudd_bddClippingAndMultiAdaptive /
+  Cudd_bddClippingAndAbstractMultiAdaptive.
+*/
+struct Cudd_ClippingBudget {
+  int maxResultSize;           /**< target size of the result, non-positive for no target */
+  unsigned long maxLiveNodes;  /**< clip while the manager has more live nodes, 0 for no limit */
+  int initialDepth;            /**< first clipping depth tried while deepening */
+};
+
+/**
+  @brief Outcome of one adaptive clipping call.
+*/
+struct Cudd_ClippingStats {
+  int depth;                   /**< clipping depth of the result, INT_MAX if unlimited */
+  unsigned long long rounds;   /**< number of clipping depths tried */
+  unsigned long long clips;    /**< number of clipped sub-problems in the result */
+  int exact;                   /**< whether the result was computed without clipping */
+};
+
+/**
+  @brief Statistics of the persistent memo table of a manager
+  (see Cudd_MultiCacheEnable).
+*/
+struct Cudd_MultiCacheStats {
+  unsigned long long andLookups;    /**< lookups by Cudd_bddAndMulti / Cudd_bddAndAbstractMulti */
+  unsigned long long andHits;       /**< hits by Cudd_bddAndMulti / Cudd_bddAndAbstractMulti */
+  unsigned long long countLookups;  /**< lookups by Cudd_LdblCountMintermMulti */
+  unsigned long long countHits;     /**< hits by Cudd_LdblCountMintermMulti */
+  unsigned long long slots;         /**< size of each memo table */
+  unsigned long long hookFlushes;   /**< flushes due to garbage collection or reordering */
+};
 
 /*---------------------------------------------------------------------------*/
 /* Function prototypes                                                       */
 /*---------------------------------------------------------------------------*/
 
-DdNode * Cudd_bddAndAbstractMulti(DdManager *manager, const std::set<DdNode *> & f, DdNode *cube, int multiCacheCapacity);
-DdNode * Cudd_bddAndMulti(DdManager *manager, const std::set<DdNode *> & f, int multiCacheCapacity);
+DdNode * Cudd_bddAndAbstractMulti(DdManager *manager, const std::set<DdNode *> & f, DdNode *cube, int multiCacheCapacity, int decomposeComponents = 0, Cudd_MultiStats * stats = NULL);
+DdNode * Cudd_bddAndMulti(DdManager *manager, const std::set<DdNode *> & f, int multiCacheCapacity, Cudd_MultiStats * stats = NULL);
+DdNode * Cudd_bddAndAbstractMultiBudgeted(DdManager *manager, const std::set<DdNode *> & f, DdNode *cube, int multiCacheCapacity,
+                                          Cudd_MultiBudget const * budget, Cudd_MultiStatus * status, Cudd_MultiStats * stats = NULL);
 DdNode * Cudd_bddClippingAndMulti(DdManager *manager, 
                                   const std::set<DdNode *> & f, 
                                   int maxDepth, 
@@ -43,4 +112,20 @@ DdNode * Cudd_bddClippingAndAbstractMulti(DdManager *manager,
                                           DdNode *cube, 
                                           int maxDepth, 
                                           int direction);
+DdNode * Cudd_bddClippingAndMultiAdaptive(DdManager *manager,
+                                          const std::set<DdNode *> & f,
+                                          Cudd_ClippingBudget const * budget,
+                                          int direction,
+                                          Cudd_ClippingStats * stats = NULL);
+DdNode * Cudd_bddClippingAndAbstractMultiAdaptive(DdManager *manager,
+                                                  const std::set<DdNode *> & f,
+                                                  DdNode *cube,
+                                                  Cudd_ClippingBudget const * budget,
+                                                  int direction,
+                                                  Cudd_ClippingStats * stats = NULL);
 long double Cudd_LdblCountMintermMulti(DdManager * dd, const std::set<DdNode *> & funcs, int numVars, int multiCacheCapacity);
+double Cudd_LogCountMintermMulti(DdManager * dd, const std::set<DdNode *> & funcs, int numVars, int multiCacheCapacity);
+parakram::BigUnsigned Cudd_ApaCountMintermMulti(DdManager * dd, const std::set<DdNode *> & funcs, int numVars, int multiCacheCapacity);
+int Cudd_MultiCacheEnable(DdManager * manager, int multiCacheCapacity);
+int Cudd_MultiCacheDisable(DdManager * manager);
+int Cudd_MultiCacheReadStats(DdManager * manager, Cudd_MultiCacheStats * stats);
@@ -636,9 +636,10 @@ bdd_ptr bdd_and_multi(DdManager * dd, bdd_ptr_set const & funcs, int cacheSize)
 bdd_ptr  bdd_and_exists_multi(DdManager *dd, 
                               bdd_ptr_set const & funcs, 
                               bdd_ptr var_cube, 
-                              int cacheSize)
+                              int cacheSize,
+                              bool decomposeComponents)
 {
-  DdNode * result = Cudd_bddAndAbstractMulti(dd, funcs, var_cube, cacheSize);
+  DdNode * result = Cudd_bddAndAbstractMulti(dd, funcs, var_cube, cacheSize, decomposeComponents ? 1 : 0);
   common_error(result, "bdd_and_exists_multi: result = NULL");
   Cudd_Ref(result);
   return result;
@@ -647,6 +648,42 @@ bdd_ptr  bdd_and_exists_multi(DdManager *dd,
 
 
 
+/**Function*******************************************************************
+ *
+  @brief Takes the AND of multiple BDDs and simultaneously abstracts 
+  the variables in cube, within a time and live node budget.
+
+  @details A non-positive time_limit (in seconds) or max_live_nodes
+  means no limit.
+
+  @return a pointer to the result if successful; NULL if the budget
+  was exceeded.
+
+  @sideeffect None
+
+  @see bdd_and_exists_multi Cudd_bddAndAbstractMultiBudgeted
+
+*****************************************************************************/
+bdd_ptr  bdd_and_exists_multi_budgeted(DdManager *dd, 
+                                       bdd_ptr_set const & funcs, 
+                                       bdd_ptr var_cube, 
+                                       int cacheSize,
+                                       double time_limit,
+                                       long max_live_nodes)
+{
+  Cudd_MultiBudget budget{ time_limit, max_live_nodes > 0 ? static_cast<unsigned long>(max_live_nodes) : 0 };
+  Cudd_MultiStatus status;
+  DdNode * result = Cudd_bddAndAbstractMultiBudgeted(dd, funcs, var_cube, cacheSize, &budget, &status);
+  if (CUDD_MULTI_TIME_EXCEEDED == status || CUDD_MULTI_NODES_EXCEEDED == status)
+    return NULL;
+  common_error(result, "bdd_and_exists_multi_budgeted: result = NULL");
+  Cudd_Ref(result);
+  return result;
+}
+
+
+
+
 
 /**Function********************************************************************
 
@@ -837,3 +874,161 @@ long double bdd_count_minterm_multi(DdManager * dd,
     return Cudd_LdblCountMintermMulti(dd, funcs, numVars, cacheSize);
 }
 
+
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns log2 of the number of minterms of a BDD.]
+
+  Description [Unlike bdd_count_minterm, works for any number of
+  variables. Returns -HUGE_VAL if there are no minterms.]
+
+  SideEffects []
+
+  SeeAlso     [bdd_count_minterm Cudd_LogCountMintermMulti]
+
+******************************************************************************/
+double bdd_log_count_minterm(DdManager * dd, bdd_ptr f, int numVars)
+{
+  return bdd_log_count_minterm_multi(dd, bdd_ptr_set{ f }, numVars, 0);
+}
+
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns log2 of the number of minterms of the conjunction
+  of a set of BDDs.]
+
+  Description [Unlike bdd_count_minterm_multi, works for any number of
+  variables. Returns -HUGE_VAL if there are no minterms.]
+
+  SideEffects []
+
+  SeeAlso     [bdd_count_minterm_multi Cudd_LogCountMintermMulti]
+
+******************************************************************************/
+double bdd_log_count_minterm_multi(DdManager * dd,
+                                   const bdd_ptr_set & funcs,
+                                   int numVars,
+                                   int cacheSize)
+{
+  return Cudd_LogCountMintermMulti(dd, funcs, numVars, cacheSize);
+}
+
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the exact number of minterms of a BDD.]
+
+  Description [Unlike bdd_count_minterm, does not round for many
+  variables. The count is the fraction of satisfying assignments times
+  2^numVars, so numVars should be at least the support size of f.]
+
+  SideEffects []
+
+  SeeAlso     [bdd_count_minterm Cudd_ApaCountMintermMulti]
+
+******************************************************************************/
+parakram::BigUnsigned bdd_exact_count_minterm(DdManager * dd, bdd_ptr f, int numVars)
+{
+  return bdd_exact_count_minterm_multi(dd, bdd_ptr_set{ f }, numVars, 0);
+}
+
+
+
+/**Function********************************************************************
+
+  Synopsis    [Returns the exact number of minterms of the conjunction
+  of a set of BDDs.]
+
+  Description [The count is the fraction of satisfying assignments
+  times 2^numVars, so numVars should be at least the support size of
+  the conjunction. The memo table is as large as the computed table,
+  capped at cacheSize slots; a cacheSize of 0 means no cap.]
+
+  SideEffects []
+
+  SeeAlso     [bdd_count_minterm_multi Cudd_ApaCountMintermMulti]
+
+******************************************************************************/
+parakram::BigUnsigned bdd_exact_count_minterm_multi(DdManager * dd,
+                                                    const bdd_ptr_set & funcs,
+                                                    int numVars,
+                                                    int cacheSize)
+{
+  return Cudd_ApaCountMintermMulti(dd, funcs, numVars, cacheSize);
+}
+
+
+
+
+
+
+/**Function********************************************************************
+
+  @brief Approximates the AND of a set of BDDs, deepening the clipping
+  depth while the result stays within the budget.
+
+  @details A non-positive max_result_size or max_live_nodes means no
+  limit.  The deepening starts at initial_depth.
+
+  @return a pointer to the result is successful; NULL otherwise.
+
+  @sideeffect None
+
+  @see bdd_clipping_and_multi Cudd_bddClippingAndMultiAdaptive
+
+******************************************************************************/
+bdd_ptr bdd_clipping_and_multi_adaptive(
+    DdManager * dd,
+    bdd_ptr_set const & funcs,
+    int max_result_size,
+    long max_live_nodes,
+    int initial_depth,
+    int direction)
+{
+  Cudd_ClippingBudget budget{ max_result_size, max_live_nodes > 0 ? static_cast<unsigned long>(max_live_nodes) : 0, initial_depth };
+  DdNode * result = Cudd_bddClippingAndMultiAdaptive(dd, funcs, &budget, direction);
+  common_error(result, "bdd_clipping_and_multi_adaptive: result = NULL");
+  Cudd_Ref(result);
+  return result;
+}
+
+
+
+
+
+/**Function********************************************************************
+
+  @brief Approximates the AND of a set of BDDs and simultaneously abstracts the
+  variables in cube, deepening the clipping depth while the result stays
+  within the budget.
+
+  @details The variables are existentially abstracted.
+  The budget is interpreted as in bdd_clipping_and_multi_adaptive.
+
+  @return a pointer to the result is successful; NULL otherwise.
+
+  @sideeffect None
+
+  @see bdd_clipping_and_exists_multi Cudd_bddClippingAndAbstractMultiAdaptive
+
+******************************************************************************/
+bdd_ptr bdd_clipping_and_exists_multi_adaptive(
+    DdManager *dd, 
+    bdd_ptr_set const & funcs, 
+    bdd_ptr var_cube,
+    int max_result_size,
+    long max_live_nodes,
+    int initial_depth,
+    int direction)
+{
+  Cudd_ClippingBudget budget{ max_result_size, max_live_nodes > 0 ? static_cast<unsigned long>(max_live_nodes) : 0, initial_depth };
+  DdNode * result = Cudd_bddClippingAndAbstractMultiAdaptive(dd, funcs, var_cube, &budget, direction);
+  common_error(result, "bdd_clipping_and_exists_multi_adaptive: result = NULL");
+  Cudd_Ref(result);
+  return result;
+}
@@ -29,6 +29,7 @@ SOFTWARE.
 #include <stdio.h>
 #include <cudd.h>
 #include <set>
+#include "big_unsigned.h"
 
 typedef struct DdNode * add_ptr;
 typedef struct DdNode * bdd_ptr;
@@ -72,10 +73,20 @@ void     bdd_print_minterms(DdManager *dd, bdd_ptr f);
 bdd_ptr  bdd_xnor(DdManager *dd, bdd_ptr f1, bdd_ptr f2);
 bdd_ptr  bdd_and_multi(DdManager *dd, bdd_ptr_set const & funcs, int cacheSize);
 bdd_ptr  bdd_and_exists_multi(DdManager *dd, bdd_ptr_set const & funcs, bdd_ptr var_cube, 
-                              int cacheSize);
+                              int cacheSize, bool decomposeComponents = false);
+bdd_ptr  bdd_and_exists_multi_budgeted(DdManager *dd, bdd_ptr_set const & funcs, bdd_ptr var_cube, 
+                                       int cacheSize, double time_limit, long max_live_nodes);
 bdd_ptr  bdd_clipping_and_multi(DdManager *dd, bdd_ptr_set const & funcs, int max_depth, int direction);
 bdd_ptr  bdd_clipping_and_exists_multi(DdManager *d, bdd_ptr_set const & funcs, bdd_ptr var_cube, int max_depth, int direction);
+bdd_ptr  bdd_clipping_and_multi_adaptive(DdManager *dd, bdd_ptr_set const & funcs,
+                                          int max_result_size, long max_live_nodes, int initial_depth, int direction);
+bdd_ptr  bdd_clipping_and_exists_multi_adaptive(DdManager *d, bdd_ptr_set const & funcs, bdd_ptr var_cube,
+                                                int max_result_size, long max_live_nodes, int initial_depth, int direction);
 bdd_ptr  bdd_substitute_vars(DdManager *d, bdd_ptr f, bdd_ptr* x, bdd_ptr* y, int n);
 bdd_ptr  bdd_assign(DdManager *d, bdd_ptr func, int varIndex, bdd_ptr varValue);
 long double bdd_count_minterm(DdManager * dd, bdd_ptr f, int numVars);
 long double bdd_count_minterm_multi(DdManager * dd, const bdd_ptr_set & fset, int numVars, int cacheSize);
+double   bdd_log_count_minterm(DdManager * dd, bdd_ptr f, int numVars);
+double   bdd_log_count_minterm_multi(DdManager * dd, const bdd_ptr_set & fset, int numVars, int cacheSize);
+parakram::BigUnsigned bdd_exact_count_minterm(DdManager * dd, bdd_ptr f, int numVars);
+parakram::BigUnsigned bdd_exact_count_minterm_multi(DdManager * dd, const bdd_ptr_set & fset, int numVars, int cacheSize);
@@ -24,7 +24,12 @@ SOFTWARE.
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
 
 
 namespace parakram {
@@ -101,5 +106,59 @@ namespace parakram {
   }; // end class DisjointSet
 
 
+
+  // ***** FlatDisjointSet *****
+  // Union-find over the integers 0 .. size - 1, stored in two flat arrays,
+  //   with path halving in find and union by rank.
+  // Meant for partitioning large index sets, where one heap node per element
+  //   (as in DisjointSet) costs more than the unions themselves.
+  class FlatDisjointSet
+  {
+    public:
+      typedef uint32_t Index;
+
+      explicit FlatDisjointSet(size_t size) :
+        m_parent(size),
+        m_rank(size, 0)
+      {
+        std::iota(m_parent.begin(), m_parent.end(), Index(0));
+      }
+
+      size_t size() const { return m_parent.size(); }
+
+      // ***** find *****
+      // the representative of the set of x
+      Index find(Index x)
+      {
+        while (m_parent[x] != x)
+        {
+          m_parent[x] = m_parent[m_parent[x]];
+          x = m_parent[x];
+        }
+        return x;
+      }
+
+      // ***** computeUnion *****
+      // merges the sets of a and b, and returns the representative of the result
+      Index computeUnion(Index a, Index b)
+      {
+        a = find(a);
+        b = find(b);
+        if (a == b)
+          return a;
+        if (m_rank[a] < m_rank[b])
+          std::swap(a, b);
+        m_parent[b] = a;
+        if (m_rank[a] == m_rank[b])
+          ++m_rank[a];
+        return a;
+      }
+
+    private:
+      std::vector<Index> m_parent;
+      std::vector<uint8_t> m_rank;
+  }; // end class FlatDisjointSet
+
+
 } // end namespace parakram
 
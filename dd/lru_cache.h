@@ -28,99 +28,288 @@ SOFTWARE.
 #pragma once
 
 #include "optional.h"
-#include <unordered_map>
-#include <list>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <utility>
+#include <vector>
 
 namespace parakram {
 
+  // ***** LruCacheSizer *****
+  // ******** class ********
+  // Estimates the bytes held by one cache entry:
+  //   the entry itself, plus the heap memory
+  //   of variable length keys (vectors and sets).
+  // Specialize (or pass another TSizer) for other
+  //   keys and values that own heap memory.
   template<typename TKey, typename TValue>
+    struct LruCacheSizer
+    {
+      template<typename T>
+        static size_t heapBytes(T const &) { return 0; }
+
+      template<typename T>
+        static size_t heapBytes(std::vector<T> const & v) { return v.capacity() * sizeof(T); }
+
+      // a red-black tree node holds three pointers and a color
+      template<typename T>
+        static size_t heapBytes(std::set<T> const & s) { return s.size() * (sizeof(T) + 4 * sizeof(void *)); }
+
+      size_t operator()(TKey const & key, TValue const & value) const
+      {
+        return sizeof(TKey) + sizeof(TValue) + heapBytes(key) + heapBytes(value);
+      }
+    };
+
+
+
+  // ***** LruCache *****
+  // ***** class *****
+  // A least recently used cache, bounded by
+  //   a number of entries and / or a number of bytes.
+  // All the entries live in one array, threaded on
+  //   an intrusive hash chain and an intrusive recency
+  //   list (by index), so a lookup is one hash probe
+  //   and the promotion is a few index updates.
+  // Evicted slots are recycled through a free list.
+  // Template arguments:
+  //   TKey: the key type, must be equality comparable
+  //   TValue: the type of the cached values, must be copyable
+  //   THash: hash function for TKey
+  //   TSizer: estimates the bytes of an entry (see LruCacheSizer)
+  template<typename TKey,
+           typename TValue,
+           typename THash = std::hash<TKey>,
+           typename TSizer = LruCacheSizer<TKey, TValue> >
   class LruCache
   {
     public:
 
-      LruCache(int capacity);
+      // capacity: maximum number of entries, 0 to cache nothing, negative for no limit
+      // byteBudget: maximum bytes of the entries (see TSizer), 0 for no limit
+      LruCache(int capacity, size_t byteBudget = 0, THash hash = THash(), TSizer sizer = TSizer());
 
+      // returns false if the key already exists
       bool insert(const TKey & key, const TValue & value);
       Optional<TValue> tryGet(const TKey & key);
+      // drops all the entries, and resets the statistics
+      void clear();
+
+      size_t size() const { return m_size; }
+      size_t numBytes() const { return m_numBytes; }
+      unsigned long long numEvictions() const { return m_numEvictions; }
 
     private:
-      typedef unsigned long long KeyId;
-      typedef std::list<KeyId>::const_iterator PriorityQueueIterator;
-      typedef std::unordered_map<TKey, KeyId> KeyStore;
-      typedef typename KeyStore::const_iterator KeyStoreIterator;
-      typedef std::unordered_map<KeyId, KeyStoreIterator> KeyStoreMap;
+      typedef uint32_t Index;
+      static constexpr Index Nil = ~Index(0);
+
+      struct Entry
+      {
+        TKey key;
+        TValue value;
+        size_t hash;
+        size_t bytes;
+        Index nextInChain;   // next entry in the hash chain, or in the free list
+        Index newer;         // recency list, towards the most recently used
+        Index older;         // recency list, towards the least recently used
+      };
+
+      Index find(const TKey & key, size_t hash) const;
+      void unlinkRecency(Index i);
+      void pushNewest(Index i);
+      void unlinkChain(Index i);
+      void evictOldest();
+      void growBuckets();
+      bool overBudget() const;
+
       int m_capacity;
-      KeyId m_largestKey;
-      KeyStore m_keyStore;
-      KeyStoreMap m_keyStoreMap;
-      std::unordered_map<KeyId, TValue> m_valueMap;
-      std::list<KeyId> m_priorityQueue;
-      std::unordered_map<KeyId, PriorityQueueIterator> m_priorityMap;
+      size_t m_byteBudget;
+      THash m_hash;
+      TSizer m_sizer;
+      std::vector<Entry> m_entries;
+      std::vector<Index> m_buckets;   // size is a power of 2
+      Index m_newest;
+      Index m_oldest;
+      Index m_free;
+      size_t m_size;
+      size_t m_numBytes;
+      unsigned long long m_numEvictions;
   };
 
 
-  template<typename TKey, typename TValue>
-    LruCache<TKey, TValue>::LruCache(int capacity) :
+  template<typename TKey, typename TValue, typename THash, typename TSizer>
+    LruCache<TKey, TValue, THash, TSizer>::LruCache(int capacity, size_t byteBudget, THash hash, TSizer sizer) :
       m_capacity(capacity),
-      m_largestKey(0),
-      m_keyStore(),
-      m_keyStoreMap(),
-      m_valueMap(),
-      m_priorityQueue(),
-      m_priorityMap()
+      m_byteBudget(byteBudget),
+      m_hash(hash),
+      m_sizer(sizer),
+      m_entries(),
+      m_buckets(16, Nil),
+      m_newest(Nil),
+      m_oldest(Nil),
+      m_free(Nil),
+      m_size(0),
+      m_numBytes(0),
+      m_numEvictions(0)
   { }
 
 
-  template<typename TKey, typename TValue>
-    bool LruCache<TKey, TValue>::insert(const TKey & key, const TValue & value)
+  template<typename TKey, typename TValue, typename THash, typename TSizer>
+    bool LruCache<TKey, TValue, THash, TSizer>::insert(const TKey & key, const TValue & value)
     {
+      // a cache of capacity 0 stores nothing
+      if (m_capacity == 0)
+        return true;
+
       // return false if the key already exists
-      if (m_keyStore.find(key) != m_keyStore.end())
+      size_t hash = m_hash(key);
+      if (find(key, hash) != Nil)
         return false;
 
-      // get the new key id
-      KeyId keyId = ++m_largestKey;
-      m_keyStore[key] = keyId;
-      m_keyStoreMap[keyId] = m_keyStore.find(key);
-      
-      // insert the value
-      m_valueMap[keyId] = value;
-
-      // push to the top of the priority queue
-      m_priorityQueue.push_front(keyId);
-      m_priorityMap[keyId] = m_priorityQueue.begin();
-
-      // forget least recently used element
-      while (m_keyStore.size() > m_capacity && !m_keyStore.empty())
+      // take a slot from the free list, or a new one
+      Index i;
+      if (m_free != Nil)
+      {
+        i = m_free;
+        m_free = m_entries[i].nextInChain;
+        m_entries[i].key = key;
+        m_entries[i].value = value;
+      }
+      else
       {
-        KeyId lruId = m_priorityQueue.back();
-        m_priorityMap.erase(lruId);
-        m_priorityQueue.pop_back();
-        m_valueMap.erase(lruId);
-        auto ksmit = m_keyStoreMap.find(lruId);
-        auto ksit = ksmit->second;
-        m_keyStoreMap.erase(ksmit);
-        m_keyStore.erase(ksit);
+        i = static_cast<Index>(m_entries.size());
+        m_entries.push_back(Entry{ key, value, 0, 0, Nil, Nil, Nil });
       }
+      Entry & e = m_entries[i];
+      e.hash = hash;
+      e.bytes = m_sizer(key, value);
+
+      // link into the hash chain and the recency list
+      Index & head = m_buckets[hash & (m_buckets.size() - 1)];
+      e.nextInChain = head;
+      head = i;
+      pushNewest(i);
+      ++m_size;
+      m_numBytes += e.bytes;
+
+      // forget least recently used elements,
+      // but always keep the new one
+      while (m_size > 1 && overBudget())
+        evictOldest();
+      if (m_size > m_buckets.size())
+        growBuckets();
       return true;
     }
 
-  template<typename TKey, typename TValue>
-    Optional<TValue> LruCache<TKey, TValue>::tryGet(const TKey & key)
+
+  template<typename TKey, typename TValue, typename THash, typename TSizer>
+    Optional<TValue> LruCache<TKey, TValue, THash, TSizer>::tryGet(const TKey & key)
     {
-      auto keyIdIter = m_keyStore.find(key);
-      KeyId keyId;
-      if (m_keyStore.end() == keyIdIter)
+      Index i = find(key, m_hash(key));
+      if (Nil == i)
         return Optional<TValue>();
-      else
-        keyId = keyIdIter->second;
+      if (i != m_newest)
+      {
+        unlinkRecency(i);
+        pushNewest(i);
+      }
+      return m_entries[i].value;
+    }
 
-     auto pqiter = m_priorityMap.find(keyId);
-     m_priorityQueue.erase(pqiter->second);
-     m_priorityQueue.push_front(keyId);
-     pqiter->second = m_priorityQueue.begin();
 
-     return m_valueMap[keyId];
+  template<typename TKey, typename TValue, typename THash, typename TSizer>
+    void LruCache<TKey, TValue, THash, TSizer>::clear()
+    {
+      m_entries.clear();
+      m_buckets.assign(16, Nil);
+      m_newest = m_oldest = m_free = Nil;
+      m_size = 0;
+      m_numBytes = 0;
+      m_numEvictions = 0;
+    }
+
+
+  template<typename TKey, typename TValue, typename THash, typename TSizer>
+    typename LruCache<TKey, TValue, THash, TSizer>::Index
+    LruCache<TKey, TValue, THash, TSizer>::find(const TKey & key, size_t hash) const
+    {
+      for (Index i = m_buckets[hash & (m_buckets.size() - 1)]; i != Nil; i = m_entries[i].nextInChain)
+        if (m_entries[i].hash == hash && m_entries[i].key == key)
+          return i;
+      return Nil;
+    }
+
+
+  template<typename TKey, typename TValue, typename THash, typename TSizer>
+    void LruCache<TKey, TValue, THash, TSizer>::unlinkRecency(Index i)
+    {
+      Entry & e = m_entries[i];
+      if (e.newer != Nil) m_entries[e.newer].older = e.older; else m_newest = e.older;
+      if (e.older != Nil) m_entries[e.older].newer = e.newer; else m_oldest = e.newer;
+      e.newer = e.older = Nil;
+    }
+
+
+  template<typename TKey, typename TValue, typename THash, typename TSizer>
+    void LruCache<TKey, TValue, THash, TSizer>::pushNewest(Index i)
+    {
+      Entry & e = m_entries[i];
+      e.newer = Nil;
+      e.older = m_newest;
+      if (m_newest != Nil) m_entries[m_newest].newer = i; else m_oldest = i;
+      m_newest = i;
+    }
+
+
+  template<typename TKey, typename TValue, typename THash, typename TSizer>
+    void LruCache<TKey, TValue, THash, TSizer>::unlinkChain(Index i)
+    {
+      Index * link = &m_buckets[m_entries[i].hash & (m_buckets.size() - 1)];
+      while (*link != i)
+        link = &m_entries[*link].nextInChain;
+      *link = m_entries[i].nextInChain;
+    }
+
+
+  template<typename TKey, typename TValue, typename THash, typename TSizer>
+    void LruCache<TKey, TValue, THash, TSizer>::evictOldest()
+    {
+      Index i = m_oldest;
+      unlinkRecency(i);
+      unlinkChain(i);
+      Entry & e = m_entries[i];
+      m_numBytes -= e.bytes;
+      --m_size;
+      ++m_numEvictions;
+      // release the heap memory of the evicted entry now
+      e.key = TKey();
+      e.value = TValue();
+      e.nextInChain = m_free;
+      m_free = i;
+    }
+
+
+  template<typename TKey, typename TValue, typename THash, typename TSizer>
+    void LruCache<TKey, TValue, THash, TSizer>::growBuckets()
+    {
+      m_buckets.assign(2 * m_buckets.size(), Nil);
+      size_t mask = m_buckets.size() - 1;
+      for (Index i = m_oldest; i != Nil; i = m_entries[i].newer)
+      {
+        Index & head = m_buckets[m_entries[i].hash & mask];
+        m_entries[i].nextInChain = head;
+        head = i;
+      }
+    }
+
+
+  template<typename TKey, typename TValue, typename THash, typename TSizer>
+    bool LruCache<TKey, TValue, THash, TSizer>::overBudget() const
+    {
+      return (m_capacity > 0 && m_size > static_cast<size_t>(m_capacity))
+        || (m_byteBudget > 0 && m_numBytes > m_byteBudget);
     }
 
 
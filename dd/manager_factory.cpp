@@ -0,0 +1,267 @@
+/*
+
+Copyright 2026 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+
+#include "manager_factory.h"
+
+#include <cuddInt.h>
+
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+
+
+namespace {
+
+  // bounds on the initial slots of each unique subtable
+  const size_t MinUniqueSlots = 32;
+  const size_t MaxUniqueSlots = 1 << 12;
+  // bounds on the initial slots of the computed table
+  const size_t MaxCacheSlots = 1 << 22;
+  // without a memory limit, the initial unique table stays below this many bytes
+  const size_t DefaultUniqueTableBudget = size_t(256) << 20;
+
+  std::string toLower(std::string const & s)
+  {
+    std::string result(s);
+    std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) { return std::tolower(c); });
+    return result;
+  }
+
+  size_t roundUpToPowerOfTwo(size_t n)
+  {
+    size_t result = 1;
+    while (result < n)
+      result <<= 1;
+    return result;
+  }
+
+} // end anonymous namespace
+
+
+namespace dd {
+
+  DynamicReordering parseDynamicReordering(std::string const & name)
+  {
+    auto lower = toLower(name);
+    if (lower == "none")
+      return DynamicReordering::None;
+    else if (lower == "sift")
+      return DynamicReordering::Sift;
+    else if (lower == "symmsift")
+      return DynamicReordering::SymmSift;
+    else if (lower == "groupsift")
+      return DynamicReordering::GroupSift;
+    throw std::invalid_argument("Unknown dynamic reordering '" + name + "', expecting one of none/sift/symmsift/groupsift");
+  }
+
+  std::string toString(DynamicReordering reordering)
+  {
+    switch (reordering)
+    {
+      case DynamicReordering::None: return "none";
+      case DynamicReordering::Sift: return "sift";
+      case DynamicReordering::SymmSift: return "symmsift";
+      case DynamicReordering::GroupSift: return "groupsift";
+    }
+    return "unknown";
+  }
+
+
+
+  GcPolicy parseGcPolicy(std::string const & name)
+  {
+    auto lower = toLower(name);
+    if (lower == "default")
+      return GcPolicy::Default;
+    else if (lower == "eager")
+      return GcPolicy::Eager;
+    else if (lower == "lazy")
+      return GcPolicy::Lazy;
+    else if (lower == "off")
+      return GcPolicy::Off;
+    throw std::invalid_argument("Unknown gc policy '" + name + "', expecting one of default/eager/lazy/off");
+  }
+
+  std::string toString(GcPolicy policy)
+  {
+    switch (policy)
+    {
+      case GcPolicy::Default: return "default";
+      case GcPolicy::Eager: return "eager";
+      case GcPolicy::Lazy: return "lazy";
+      case GcPolicy::Off: return "off";
+    }
+    return "unknown";
+  }
+
+
+
+  size_t parseMemorySize(std::string const & text)
+  {
+    size_t pos = 0;
+    while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos])))
+      ++pos;
+    if (pos == 0 || pos + 1 < text.size())
+      throw std::invalid_argument("Invalid memory size '" + text + "', expecting a number of bytes with an optional K/M/G suffix");
+    size_t shift = 0;
+    if (pos < text.size())
+    {
+      switch (std::toupper(static_cast<unsigned char>(text[pos])))
+      {
+        case 'K': shift = 10; break;
+        case 'M': shift = 20; break;
+        case 'G': shift = 30; break;
+        default:
+          throw std::invalid_argument("Invalid memory size '" + text + "', expecting a number of bytes with an optional K/M/G suffix");
+      }
+    }
+    size_t value = 0;
+    for (size_t i = 0; i < pos; ++i)
+    {
+      if (value > (std::numeric_limits<size_t>::max() >> shift) / 10)
+        throw std::invalid_argument("Memory size '" + text + "' is too large");
+      value = value * 10 + size_t(text[i] - '0');
+    }
+    if (value > (std::numeric_limits<size_t>::max() >> shift))
+      throw std::invalid_argument("Memory size '" + text + "' is too large");
+    return value << shift;
+  }
+
+
+
+  // ***** Function *****
+  // The unique subtables start with room for a few nodes per literal
+  //   occurrence, estimated as 4 factors per variable, and shrink
+  //   (down to MinUniqueSlots) when there are too many variables to
+  //   fit an eighth of the memory limit.
+  // The computed table starts with 16 slots per factor, and takes at
+  //   most a quarter of the memory limit.
+  // Live nodes may take three quarters of the memory limit.
+  // ********************
+  ManagerSizing computeManagerSizing(ManagerOptions const & options)
+  {
+    size_t numVariables = std::max<size_t>(options.numVariables, 1);
+
+    size_t uniqueSlots = CUDD_UNIQUE_SLOTS;
+    if (options.numFactors > 0)
+      uniqueSlots = std::min(std::max(roundUpToPowerOfTwo(4 * options.numFactors / numVariables), uniqueSlots), MaxUniqueSlots);
+    size_t uniqueBudget = options.maxMemory > 0 ? options.maxMemory / 8 : DefaultUniqueTableBudget;
+    while (uniqueSlots > MinUniqueSlots && uniqueSlots * numVariables * sizeof(DdNode *) > uniqueBudget)
+      uniqueSlots >>= 1;
+
+    size_t cacheSlots = CUDD_CACHE_SLOTS;
+    if (options.numFactors > 0)
+      cacheSlots = std::min(std::max(roundUpToPowerOfTwo(16 * options.numFactors), cacheSlots), MaxCacheSlots);
+    if (options.maxMemory > 0)
+      while (cacheSlots > 1 && cacheSlots * sizeof(DdCache) > options.maxMemory / 4)
+        cacheSlots >>= 1;
+
+    size_t maxLive = options.maxMemory / 4 * 3 / sizeof(DdNode);
+    maxLive = std::min<size_t>(maxLive, std::numeric_limits<unsigned int>::max());
+
+    return ManagerSizing{ unsigned(uniqueSlots), unsigned(cacheSlots), unsigned(maxLive) };
+  }
+
+
+
+  DdManager * createManager(ManagerOptions const & options)
+  {
+    auto sizing = computeManagerSizing(options);
+    DdManager * manager = Cudd_Init(0, 0, sizing.uniqueSlots, sizing.cacheSlots, options.maxMemory);
+    if (!manager)
+      throw std::runtime_error("Could not initialize cudd");
+    configureManager(manager, options);
+    return manager;
+  }
+
+
+
+  void configureManager(DdManager * manager, ManagerOptions const & options)
+  {
+    if (options.maxMemory > 0)
+    {
+      Cudd_SetMaxMemory(manager, options.maxMemory);
+      Cudd_SetMaxLive(manager, computeManagerSizing(options).maxLive);
+    }
+
+    switch (options.reordering)
+    {
+      case DynamicReordering::None: Cudd_AutodynDisable(manager); break;
+      case DynamicReordering::Sift: Cudd_AutodynEnable(manager, CUDD_REORDER_SIFT); break;
+      case DynamicReordering::SymmSift: Cudd_AutodynEnable(manager, CUDD_REORDER_SYMM_SIFT); break;
+      case DynamicReordering::GroupSift: Cudd_AutodynEnable(manager, CUDD_REORDER_GROUP_SIFT); break;
+    }
+
+    switch (options.gcPolicy)
+    {
+      case GcPolicy::Default:
+        break;
+      case GcPolicy::Eager:
+        // leave the loose growth phase immediately, and grow the cache reluctantly
+        Cudd_EnableGarbageCollection(manager);
+        Cudd_SetLooseUpTo(manager, 1);
+        Cudd_SetMinHit(manager, 90);
+        break;
+      case GcPolicy::Lazy:
+        // grow the unique table without collecting, up to the live node limit
+        Cudd_EnableGarbageCollection(manager);
+        Cudd_SetLooseUpTo(manager, options.maxMemory > 0 ? computeManagerSizing(options).maxLive
+                                                         : std::numeric_limits<unsigned int>::max());
+        Cudd_SetMinHit(manager, 5);
+        break;
+      case GcPolicy::Off:
+        Cudd_DisableGarbageCollection(manager);
+        break;
+    }
+  }
+
+
+
+  ManagerStats readManagerStats(DdManager * manager)
+  {
+    return ManagerStats{
+      Cudd_ReadPeakNodeCount(manager),
+      Cudd_ReadPeakLiveNodeCount(manager),
+      Cudd_ReadMemoryInUse(manager),
+      Cudd_ReadMaxMemory(manager),
+      Cudd_ReadGarbageCollections(manager),
+      Cudd_ReadReorderings(manager)
+    };
+  }
+
+  std::ostream & operator << (std::ostream & out, ManagerStats const & stats)
+  {
+    return out << "peak " << stats.peakNodes << " nodes (" << stats.peakLiveNodes << " live), "
+               << (stats.memoryInUse >> 20) << " MB in use of " << (stats.maxMemory >> 20) << " MB, "
+               << stats.garbageCollections << " garbage collections, "
+               << stats.reorderings << " reorderings";
+  }
+
+} // end namespace dd
@@ -0,0 +1,111 @@
+/*
+
+Copyright 2026 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+
+#pragma once
+
+#include "dd.h"
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace dd {
+
+  // ***** DynamicReordering *****
+  // reordering that cudd triggers by itself as the unique table grows
+  enum class DynamicReordering { None, Sift, SymmSift, GroupSift };
+
+  // parses none / sift / symmsift / groupsift (case insensitive),
+  // throws std::invalid_argument otherwise
+  DynamicReordering parseDynamicReordering(std::string const & name);
+  std::string toString(DynamicReordering reordering);
+
+
+
+  // ***** GcPolicy *****
+  // how readily cudd collects garbage instead of growing its tables
+  //   Default: cudd's own thresholds
+  //   Eager:   collect before every resize, keeping memory low
+  //   Lazy:    grow the tables freely, collecting only when they stop growing
+  //   Off:     never collect
+  enum class GcPolicy { Default, Eager, Lazy, Off };
+
+  // parses default / eager / lazy / off (case insensitive),
+  // throws std::invalid_argument otherwise
+  GcPolicy parseGcPolicy(std::string const & name);
+  std::string toString(GcPolicy policy);
+
+  // parses a number of bytes with an optional K / M / G suffix (powers of 1024),
+  // throws std::invalid_argument otherwise
+  size_t parseMemorySize(std::string const & text);
+
+
+
+  // ***** ManagerOptions *****
+  struct ManagerOptions {
+    // expected size of the problem, used to size the tables (0 if unknown)
+    size_t numVariables = 0;
+    size_t numFactors = 0;
+    // hard limit on the memory of the manager in bytes, 0 for no limit
+    size_t maxMemory = 0;
+    DynamicReordering reordering = DynamicReordering::None;
+    GcPolicy gcPolicy = GcPolicy::Default;
+  };
+
+  // table sizes that createManager passes to Cudd_Init
+  struct ManagerSizing {
+    unsigned int uniqueSlots;  // initial slots of each unique subtable
+    unsigned int cacheSlots;   // initial slots of the computed table
+    unsigned int maxLive;      // live node limit, 0 for no limit
+  };
+  ManagerSizing computeManagerSizing(ManagerOptions const & options);
+
+  // creates a manager sized for the problem, and configures it with the options
+  // throws std::runtime_error if cudd cannot be initialized
+  DdManager * createManager(ManagerOptions const & options);
+
+  // applies the memory limit, reordering and gc policy to an existing manager
+  // (the problem size is only used when creating one)
+  void configureManager(DdManager * manager, ManagerOptions const & options);
+
+
+
+  // ***** ManagerStats *****
+  // resource usage of a manager, to be logged before it goes away
+  struct ManagerStats {
+    long peakNodes;
+    int peakLiveNodes;
+    size_t memoryInUse;
+    size_t maxMemory;
+    int garbageCollections;
+    int reorderings;
+  };
+  ManagerStats readManagerStats(DdManager * manager);
+  std::ostream & operator << (std::ostream & out, ManagerStats const & stats);
+
+} // end namespace dd
@@ -0,0 +1,77 @@
+/*
+
+Copyright 2026 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+#include "mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace dd {
+
+  MappedFile::MappedFile(std::string const & path) :
+    m_data(NULL),
+    m_size(0)
+  {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw std::runtime_error("Could not open file '" + path + "': " + strerror(errno));
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+      int err = errno;
+      close(fd);
+      throw std::runtime_error("Could not stat file '" + path + "': " + strerror(err));
+    }
+    m_size = st.st_size;
+    if (m_size > 0) // mapping an empty file fails, and is not needed
+    {
+      void * data = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED)
+      {
+        int err = errno;
+        close(fd);
+        throw std::runtime_error("Could not map file '" + path + "': " + strerror(err));
+      }
+      madvise(data, m_size, MADV_SEQUENTIAL);
+      m_data = static_cast<char const *>(data);
+    }
+    close(fd);
+  }
+
+  MappedFile::~MappedFile()
+  {
+    if (m_data)
+      munmap(const_cast<char *>(m_data), m_size);
+  }
+
+} // end namespace dd
@@ -0,0 +1,57 @@
+/*
+
+Copyright 2026 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace dd {
+
+  // ***** MappedFile *****
+  // ****** class ******
+  // A whole file mapped read-only into memory,
+  //   unmapped when the object is destroyed.
+  // Throws std::runtime_error if the file cannot be opened or mapped.
+  class MappedFile
+  {
+    public:
+      explicit MappedFile(std::string const & path);
+      ~MappedFile();
+      MappedFile(MappedFile const &) = delete;
+      MappedFile & operator = (MappedFile const &) = delete;
+
+      char const * begin() const { return m_data; }
+      char const * end() const { return m_data + m_size; }
+      size_t size() const { return m_size; }
+
+    private:
+      char const * m_data;
+      size_t m_size;
+  };
+
+} // end namespace dd
@@ -0,0 +1,58 @@
+/*
+
+Copyright 2026 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#pragma once
+
+#include "cuddAndAbsMulti.h"
+
+#include <stdexcept>
+
+namespace dd
+{
+
+  // gives the manager a persistent memo table for the multi operand
+  // operations (see Cudd_MultiCacheEnable) for the lifetime of the object,
+  // so that it is disabled before the manager is destroyed, even on
+  // an exception, as long as the scope is declared after the manager
+  class PersistentMultiCacheScope
+  {
+    public:
+      PersistentMultiCacheScope(DdManager * manager, int multiCacheCapacity) :
+        m_manager(manager)
+      {
+        if (!Cudd_MultiCacheEnable(manager, multiCacheCapacity))
+          throw std::runtime_error("Could not enable the persistent multi cache");
+      }
+      ~PersistentMultiCacheScope()
+      {
+        Cudd_MultiCacheDisable(m_manager);
+      }
+      PersistentMultiCacheScope(PersistentMultiCacheScope const &) = delete;
+      PersistentMultiCacheScope & operator=(PersistentMultiCacheScope const &) = delete;
+    private:
+      DdManager * m_manager;
+  };
+
+} // end namespace dd
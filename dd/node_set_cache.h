@@ -0,0 +1,227 @@
+/*
+
+Copyright 2026 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+#pragma once
+
+#include "optional.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace parakram {
+
+  // ***** NodeSetCache *****
+  // ******** class ********
+  // A fixed size, open addressing memo table
+  //   keyed on a sorted array of node pointers
+  //   together with one extra "tag" pointer
+  //   (e.g. the cube of an and-abstract operation).
+  // All memory is allocated up front:
+  //   the slots live in one flat array, and
+  //   the keys are copied into one flat key pool.
+  // Like the CUDD computed table, it is lossy:
+  //   if the probe window of a key is full,
+  //   the home slot is overwritten,
+  //   and when the key pool runs out
+  //   the whole table is flushed in O(1)
+  //   by bumping a generation counter.
+  // Template arguments:
+  //   TNode: the (pointer) type of the key elements and the tag
+  //   TValue: the type of the cached values, must be copyable
+  template<typename TNode, typename TValue>
+    class NodeSetCache
+    {
+      public:
+        // numSlots is rounded up to a power of 2
+        NodeSetCache(size_t numSlots);
+
+        Optional<TValue> tryGet(TNode const * keys, size_t numKeys, TNode tag);
+        void insert(TNode const * keys, size_t numKeys, TNode tag, TValue const & value);
+        void clear();
+
+        size_t numSlots() const { return m_slots.size(); }
+        unsigned long long numLookups() const { return m_numLookups; }
+        unsigned long long numHits() const { return m_numHits; }
+        unsigned long long numFlushes() const { return m_numFlushes; }
+
+      private:
+        static const size_t ProbeLength = 8;
+        static const size_t KeyPoolFactor = 4;
+
+        struct Slot {
+          size_t hash;
+          uint32_t keyOffset;
+          uint32_t keyLength;
+          uint32_t generation;
+          TNode tag;
+          TValue value;
+        };
+
+        static size_t hashKey(TNode const * keys, size_t numKeys, TNode tag);
+        bool matches(Slot const & slot, size_t hash, TNode const * keys, size_t numKeys, TNode tag) const;
+
+        size_t m_mask;
+        uint32_t m_generation;
+        std::vector<Slot> m_slots;
+        std::vector<TNode> m_keyPool;
+        size_t m_keyPoolUsed;
+        unsigned long long m_numLookups;
+        unsigned long long m_numHits;
+        unsigned long long m_numFlushes;
+    };
+
+
+
+
+  template<typename TNode, typename TValue>
+    NodeSetCache<TNode, TValue>::NodeSetCache(size_t numSlots) :
+      m_mask(0),
+      m_generation(1),
+      m_slots(),
+      m_keyPool(),
+      m_keyPoolUsed(0),
+      m_numLookups(0),
+      m_numHits(0),
+      m_numFlushes(0)
+  {
+    size_t size = 1;
+    while (size < numSlots)
+      size <<= 1;
+    m_mask = size - 1;
+    m_slots.resize(size, Slot{0, 0, 0, 0, TNode(), TValue()});
+    m_keyPool.resize(size * KeyPoolFactor);
+  }
+
+
+  template<typename TNode, typename TValue>
+    size_t NodeSetCache<TNode, TValue>::hashKey(TNode const * keys, size_t numKeys, TNode tag)
+    {
+      uint64_t h = reinterpret_cast<uintptr_t>(tag) + numKeys;
+      for (size_t i = 0; i < numKeys; ++i)
+        h ^= reinterpret_cast<uintptr_t>(keys[i]) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+      // final avalanche, since node pointers have few significant low bits
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      return static_cast<size_t>(h);
+    }
+
+
+  template<typename TNode, typename TValue>
+    bool NodeSetCache<TNode, TValue>::matches(
+        Slot const & slot, 
+        size_t hash, 
+        TNode const * keys, 
+        size_t numKeys, 
+        TNode tag) const
+    {
+      return slot.generation == m_generation
+        && slot.hash == hash
+        && slot.tag == tag
+        && slot.keyLength == numKeys
+        && 0 == std::memcmp(m_keyPool.data() + slot.keyOffset, keys, numKeys * sizeof(TNode));
+    }
+
+
+  template<typename TNode, typename TValue>
+    Optional<TValue> NodeSetCache<TNode, TValue>::tryGet(TNode const * keys, size_t numKeys, TNode tag)
+    {
+      ++m_numLookups;
+      size_t hash = hashKey(keys, numKeys, tag);
+      for (size_t i = 0; i < ProbeLength; ++i)
+      {
+        Slot const & slot = m_slots[(hash + i) & m_mask];
+        if (slot.generation != m_generation)
+          break;
+        if (matches(slot, hash, keys, numKeys, tag))
+        {
+          ++m_numHits;
+          return slot.value;
+        }
+      }
+      return Optional<TValue>();
+    }
+
+
+  template<typename TNode, typename TValue>
+    void NodeSetCache<TNode, TValue>::insert(TNode const * keys, size_t numKeys, TNode tag, TValue const & value)
+    {
+      // keys that would not even fit in an empty pool are not cached
+      if (numKeys > m_keyPool.size())
+        return;
+
+      size_t hash = hashKey(keys, numKeys, tag);
+      Slot * target = &m_slots[hash & m_mask];
+      for (size_t i = 0; i < ProbeLength; ++i)
+      {
+        Slot & slot = m_slots[(hash + i) & m_mask];
+        if (slot.generation != m_generation)
+        {
+          target = &slot;
+          break;
+        }
+        if (matches(slot, hash, keys, numKeys, tag))
+        {
+          slot.value = value;
+          return;
+        }
+      }
+
+      if (m_keyPoolUsed + numKeys > m_keyPool.size())
+      {
+        clear();
+        target = &m_slots[hash & m_mask];
+      }
+
+      std::memcpy(m_keyPool.data() + m_keyPoolUsed, keys, numKeys * sizeof(TNode));
+      target->hash = hash;
+      target->keyOffset = static_cast<uint32_t>(m_keyPoolUsed);
+      target->keyLength = static_cast<uint32_t>(numKeys);
+      target->generation = m_generation;
+      target->tag = tag;
+      target->value = value;
+      m_keyPoolUsed += numKeys;
+    }
+
+
+  template<typename TNode, typename TValue>
+    void NodeSetCache<TNode, TValue>::clear()
+    {
+      ++m_numFlushes;
+      m_keyPoolUsed = 0;
+      if (++m_generation == 0)
+      {
+        // generation counter wrapped around, so really wipe the slots
+        for (auto & slot: m_slots)
+          slot.generation = 0;
+        m_generation = 1;
+      }
+    }
+
+} // end namespace parakram
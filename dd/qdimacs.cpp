@@ -23,7 +23,10 @@ SOFTWARE.
 */
 
 #include "qdimacs.h"
+#include "mapped_file.h"
 
+#include <climits>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
@@ -35,6 +38,74 @@ namespace {
     return s1.compare(0, len, s2, len) == 0;
   }
 
+
+
+  // ***** QdimacsLexer *****
+  // scans the text of a Qdimacs file in place, one line at a time
+  struct QdimacsLexer {
+    const char * pos;
+    const char * end;
+    size_t lineNumber;
+
+    QdimacsLexer(const char * v_begin, const char * v_end) : pos(v_begin), end(v_end), lineNumber(1) {}
+
+    bool atEnd() const { return pos == end; }
+    bool atEndOfLine() const { return pos == end || *pos == '\n'; }
+
+    void skipBlanks()
+    {
+      while (pos != end && (*pos == ' ' || *pos == '\t' || *pos == '\r'))
+        ++pos;
+    }
+
+    // move past the next newline
+    void skipLine()
+    {
+      auto newline = static_cast<const char *>(memchr(pos, '\n', end - pos));
+      pos = newline ? newline + 1 : end;
+      ++lineNumber;
+    }
+
+    [[noreturn]] void fail(const std::string & what) const
+    {
+      throw std::invalid_argument("Qdimacs line " + std::to_string(lineNumber) + ": " + what);
+    }
+
+    // read the next integer on the current line,
+    // returns false if there are no more tokens on the line
+    bool nextInt(int & value)
+    {
+      skipBlanks();
+      if (atEndOfLine())
+        return false;
+      bool isNegative = (*pos == '-');
+      if (isNegative)
+        ++pos;
+      if (pos == end || *pos < '0' || *pos > '9')
+        fail("expected an integer");
+      long long v = 0;
+      while (pos != end && *pos >= '0' && *pos <= '9')
+      {
+        v = v * 10 + (*pos - '0');
+        if (v > INT_MAX)
+          fail("integer out of range");
+        ++pos;
+      }
+      if (pos != end && *pos != ' ' && *pos != '\t' && *pos != '\r' && *pos != '\n')
+        fail(std::string("unexpected character '") + *pos + "'");
+      value = isNegative ? -int(v) : int(v);
+      return true;
+    }
+
+    // read integers up to a 0 or the end of the line
+    void readZeroTerminated(std::vector<int> & out)
+    {
+      int v;
+      while (nextInt(v) && v != 0)
+        out.push_back(v);
+    }
+  };
+
 } // end anonymous namespace
 
 namespace dd {
@@ -104,6 +175,102 @@ namespace dd {
 
 
 
+    std::shared_ptr<Qdimacs> Qdimacs::parseQdimacsFile(const std::string& path)
+    {
+      return FlatQdimacs::parseFile(path)->toQdimacs();
+    }
+
+
+
+
+    std::shared_ptr<FlatQdimacs> FlatQdimacs::parse(const char * begin, const char * end)
+    {
+      auto q = std::make_shared<FlatQdimacs>();
+      QdimacsLexer lexer(begin, end);
+      while (!lexer.atEnd())
+      {
+        lexer.skipBlanks();
+        if (lexer.atEndOfLine())
+        {
+          // skip empty lines
+        }
+        else if (*lexer.pos == 'c' || *lexer.pos == '/')
+        {
+          // skip comments
+        }
+        else if (*lexer.pos == 'p')
+        {
+          ++lexer.pos;
+          lexer.skipBlanks();
+          if (lexer.end - lexer.pos < 3 || strncmp(lexer.pos, "cnf", 3) != 0)
+            lexer.fail("expected 'p cnf'");
+          lexer.pos += 3;
+          int numClauses;
+          if (!lexer.nextInt(q->numVariables) || !lexer.nextInt(numClauses))
+            lexer.fail("expected number of variables and clauses");
+          if (numClauses > 0)
+          {
+            q->clauseOffsets.reserve(size_t(numClauses) + 1);
+            q->literals.reserve(size_t(numClauses) * 3);
+          }
+        }
+        else if (*lexer.pos == 'a' || *lexer.pos == 'e')
+        {
+          q->quantifiers.emplace_back();
+          auto & quantifier = q->quantifiers.back();
+          quantifier.quantifierType = (*lexer.pos == 'a' ? Quantifier::ForAll : Quantifier::Exists);
+          ++lexer.pos;
+          lexer.readZeroTerminated(quantifier.variables);
+        }
+        else
+        {
+          lexer.readZeroTerminated(q->literals);
+          q->clauseOffsets.push_back(q->literals.size());
+        }
+        lexer.skipLine();
+      }
+      return q;
+    }
+
+
+
+
+    std::shared_ptr<FlatQdimacs> FlatQdimacs::parseFile(const std::string& path)
+    {
+      MappedFile file(path);
+      if (auto cached = loadCache(cachePath(path), file.begin(), file.end()))
+        return cached;
+      return parse(file.begin(), file.end());
+    }
+
+
+
+
+    std::shared_ptr<FlatQdimacs> FlatQdimacs::parseFileAndWriteCache(const std::string& path)
+    {
+      MappedFile file(path);
+      auto q = parse(file.begin(), file.end());
+      q->writeCache(cachePath(path), file.begin(), file.end());
+      return q;
+    }
+
+
+
+
+    std::shared_ptr<Qdimacs> FlatQdimacs::toQdimacs() const
+    {
+      auto q = std::make_shared<Qdimacs>();
+      q->numVariables = numVariables;
+      q->quantifiers = quantifiers;
+      q->clauses.reserve(numClauses());
+      for (size_t i = 0; i < numClauses(); ++i)
+        q->clauses.emplace_back(clauseBegin(i), clauseEnd(i));
+      return q;
+    }
+
+
+
+
     void Qdimacs::print(std::ostream& os) const
     {
       os << "p cnf " << numVariables << ' '<< clauses.size() << "\n";
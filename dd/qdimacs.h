@@ -24,10 +24,12 @@ SOFTWARE.
 
 #pragma once
 
+#include <cstddef>
 #include <vector>
 #include <memory>
 #include <istream>
 #include <ostream>
+#include <string>
 
 namespace dd {
 
@@ -67,6 +69,10 @@ namespace dd {
     // static function to parse a Qdimacs file
     static std::shared_ptr<Qdimacs> parseQdimacs(std::istream& is);
 
+    // static function to parse a Qdimacs file given its path,
+    // much faster than parseQdimacs (see FlatQdimacs::parseFile)
+    static std::shared_ptr<Qdimacs> parseQdimacsFile(const std::string& path);
+
     // print to output stream
     void print(std::ostream& os) const;
 
@@ -74,4 +80,51 @@ namespace dd {
 
 
 
+
+  // struct representing a Qdimacs file, with the clauses stored
+  // back to back in one flat literal array (CSR layout),
+  // so that millions of clauses cost two allocations rather than millions
+  struct FlatQdimacs {
+
+    int numVariables;                      // number of vars
+    std::vector<Quantifier> quantifiers;   // quantified variables, from outer to inner
+    std::vector<int> literals;             // literals of all the clauses, back to back
+    std::vector<size_t> clauseOffsets;     // clause i is literals[clauseOffsets[i], clauseOffsets[i + 1])
+
+    FlatQdimacs() : numVariables(0), quantifiers(), literals(), clauseOffsets(1, 0) {}
+
+    size_t numClauses() const { return clauseOffsets.size() - 1; }
+    const int * clauseBegin(size_t i) const { return literals.data() + clauseOffsets[i]; }
+    const int * clauseEnd(size_t i) const { return literals.data() + clauseOffsets[i + 1]; }
+    size_t clauseSize(size_t i) const { return clauseOffsets[i + 1] - clauseOffsets[i]; }
+
+    // parse the text of a Qdimacs file, with a hand written lexer
+    // throws std::invalid_argument on malformed input
+    static std::shared_ptr<FlatQdimacs> parse(const char * begin, const char * end);
+
+    // memory map a Qdimacs file and parse it,
+    // or load its sidecar cache (see cachePath) if that is present and up to date
+    static std::shared_ptr<FlatQdimacs> parseFile(const std::string& path);
+
+    // path of the binary sidecar cache of the Qdimacs file at 'path'
+    static std::string cachePath(const std::string& path);
+
+    // parse the Qdimacs file at 'path' and write its sidecar cache
+    static std::shared_ptr<FlatQdimacs> parseFileAndWriteCache(const std::string& path);
+
+    // load a binary cache written for the Qdimacs text [begin, end),
+    // returns nullptr if the cache is missing, was written by a different
+    // format version, or was written for a different text
+    static std::shared_ptr<FlatQdimacs> loadCache(const std::string& cachePath, const char * begin, const char * end);
+
+    // write the binary cache of this, as parsed from the text [begin, end)
+    void writeCache(const std::string& cachePath, const char * begin, const char * end) const;
+
+    // convert to the clause-per-vector representation
+    std::shared_ptr<Qdimacs> toQdimacs() const;
+
+  }; // end struct FlatQdimacs
+
+
+
 } // end namespace dd
@@ -0,0 +1,299 @@
+/*
+
+Copyright 2026 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+#include "qdimacs.h"
+#include "mapped_file.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#include <unistd.h>
+
+
+// Layout of a Qdimacs cache file (native byte order, every section 8 byte aligned):
+//   CacheHeader
+//   uint32_t quantifierTypes[numQuantifiers]            (0 = ForAll, 1 = Exists)
+//   uint64_t quantifierOffsets[numQuantifiers + 1]      (into quantifierVariables)
+//   int32_t  quantifierVariables[numQuantifierVariables]
+//   uint64_t clauseOffsets[numClauses + 1]              (into literals)
+//   int32_t  literals[numLiterals]
+// The header records the size and hash of the text the cache was built from,
+// so a cache is never used after its Qdimacs file has been modified.
+// Bump CacheVersion whenever the layout changes.
+
+namespace {
+
+  const char CacheMagic[8] = { 'Q', 'D', 'I', 'M', 'A', 'C', 'S', 'B' };
+  const uint32_t CacheVersion = 1;
+  const uint32_t CacheByteOrder = 0x01020304;
+
+  struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t sourceSize;
+    uint64_t sourceHash;
+    int64_t numVariables;
+    uint64_t numQuantifiers;
+    uint64_t numQuantifierVariables;
+    uint64_t numClauses;
+    uint64_t numLiterals;
+  };
+
+  static_assert(sizeof(CacheHeader) == 72, "unexpected padding in CacheHeader");
+  static_assert(sizeof(size_t) == sizeof(uint64_t), "clause offsets are stored as uint64_t");
+
+
+
+  size_t aligned(size_t numBytes) { return (numBytes + 7) & ~size_t(7); }
+
+
+
+  // whether offsets (numSections + 1 of them) start at 0, never
+  // decrease, and end at numItems
+  bool validOffsets(const uint64_t * offsets, size_t numSections, uint64_t numItems)
+  {
+    if (offsets[0] != 0 || offsets[numSections] != numItems)
+      return false;
+    for (size_t i = 0; i < numSections; ++i)
+      if (offsets[i] > offsets[i + 1])
+        return false;
+    return true;
+  }
+
+
+
+  // whether no literal is zero, which the text parser never produces
+  // (a zero ends a clause); like the parser, the literals are not
+  // checked against the number of variables in the header
+  bool validLiterals(const int32_t * literals, size_t numLiterals)
+  {
+    for (size_t i = 0; i < numLiterals; ++i)
+      if (literals[i] == 0)
+        return false;
+    return true;
+  }
+
+
+
+  // a fast non-cryptographic hash of the text, 8 bytes at a time
+  uint64_t hashText(const char * begin, const char * end)
+  {
+    const uint64_t prime = 0x100000001b3ull;
+    uint64_t h = 0xcbf29ce484222325ull ^ uint64_t(end - begin);
+    const char * pos = begin;
+    for (; end - pos >= 8; pos += 8)
+    {
+      uint64_t word;
+      memcpy(&word, pos, 8);
+      h = (h ^ word) * prime;
+      h ^= h >> 29;
+    }
+    for (; pos != end; ++pos)
+      h = (h ^ uint64_t(static_cast<unsigned char>(*pos))) * prime;
+    return h;
+  }
+
+
+
+  // ***** CacheWriter *****
+  // appends the sections of a cache file, padding each to 8 bytes
+  struct CacheWriter {
+    std::ofstream & out;
+
+    void write(const void * data, size_t numBytes)
+    {
+      static const char zeros[8] = { 0 };
+      out.write(static_cast<const char *>(data), numBytes);
+      out.write(zeros, aligned(numBytes) - numBytes);
+    }
+  };
+
+
+
+  // ***** CacheReader *****
+  // walks the sections of a mapped cache file,
+  // returning nullptr for sections that run past the end of the file
+  struct CacheReader {
+    const char * pos;
+    const char * end;
+
+    const char * read(size_t numBytes)
+    {
+      if (numBytes > size_t(end - pos) || aligned(numBytes) > size_t(end - pos))
+        return nullptr;
+      const char * result = pos;
+      pos += aligned(numBytes);
+      return result;
+    }
+  };
+
+} // end anonymous namespace
+
+
+
+
+namespace dd {
+
+
+
+
+    std::string FlatQdimacs::cachePath(const std::string& path)
+    {
+      return path + ".qdcache";
+    }
+
+
+
+
+    std::shared_ptr<FlatQdimacs> FlatQdimacs::loadCache(const std::string& cachePath, const char * begin, const char * end)
+    {
+      if (access(cachePath.c_str(), R_OK) != 0)
+        return nullptr;
+      MappedFile file(cachePath);
+      CacheReader reader{ file.begin(), file.end() };
+
+      const char * headerBytes = reader.read(sizeof(CacheHeader));
+      if (headerBytes == nullptr)
+        return nullptr;
+      CacheHeader header;
+      memcpy(&header, headerBytes, sizeof(CacheHeader));
+      if (memcmp(header.magic, CacheMagic, sizeof(CacheMagic)) != 0
+          || header.version != CacheVersion
+          || header.byteOrder != CacheByteOrder
+          || header.sourceSize != uint64_t(end - begin)
+          || header.numQuantifierVariables > file.size()
+          || header.numQuantifiers > file.size()
+          || header.numClauses > file.size()
+          || header.numLiterals > file.size())
+        return nullptr;
+
+      const char * quantifierTypes = reader.read(header.numQuantifiers * sizeof(uint32_t));
+      const char * quantifierOffsets = reader.read((header.numQuantifiers + 1) * sizeof(uint64_t));
+      const char * quantifierVariables = reader.read(header.numQuantifierVariables * sizeof(int32_t));
+      const char * clauseOffsets = reader.read((header.numClauses + 1) * sizeof(uint64_t));
+      const char * literals = reader.read(header.numLiterals * sizeof(int32_t));
+      if (literals == nullptr || reader.pos != reader.end
+          || header.sourceHash != hashText(begin, end))
+        return nullptr;
+
+      if (header.numVariables < std::numeric_limits<int>::min() || header.numVariables > std::numeric_limits<int>::max())
+        return nullptr;
+
+      // the hash covers the source text, not the payload, so check that
+      // every offset is in range, and that the variables are what the
+      // text parser could have produced, before anything is built on
+      // them (a corrupt cache falls back to parsing the text)
+      auto q = std::make_shared<FlatQdimacs>();
+      q->numVariables = static_cast<int>(header.numVariables);
+
+      std::vector<uint64_t> qOffsets(header.numQuantifiers + 1);
+      memcpy(qOffsets.data(), quantifierOffsets, qOffsets.size() * sizeof(uint64_t));
+      std::vector<int32_t> qVars(header.numQuantifierVariables);
+      memcpy(qVars.data(), quantifierVariables, qVars.size() * sizeof(int32_t));
+      if (!validOffsets(qOffsets.data(), header.numQuantifiers, header.numQuantifierVariables))
+        return nullptr;
+      if (!validLiterals(qVars.data(), qVars.size()))
+        return nullptr;
+      q->quantifiers.resize(header.numQuantifiers);
+      for (size_t i = 0; i < header.numQuantifiers; ++i)
+      {
+        uint32_t type;
+        memcpy(&type, quantifierTypes + i * sizeof(uint32_t), sizeof(uint32_t));
+        if (type > 1)
+          return nullptr;
+        q->quantifiers[i].quantifierType = (type == 0 ? Quantifier::ForAll : Quantifier::Exists);
+        q->quantifiers[i].variables.assign(qVars.cbegin() + qOffsets[i], qVars.cbegin() + qOffsets[i + 1]);
+      }
+
+      q->clauseOffsets.resize(header.numClauses + 1);
+      memcpy(q->clauseOffsets.data(), clauseOffsets, q->clauseOffsets.size() * sizeof(uint64_t));
+      if (!validOffsets(q->clauseOffsets.data(), header.numClauses, header.numLiterals))
+        return nullptr;
+      q->literals.resize(header.numLiterals);
+      memcpy(q->literals.data(), literals, q->literals.size() * sizeof(int32_t));
+      if (!validLiterals(q->literals.data(), q->literals.size()))
+        return nullptr;
+      return q;
+    }
+
+
+
+
+    void FlatQdimacs::writeCache(const std::string& cachePath, const char * begin, const char * end) const
+    {
+      CacheHeader header;
+      memcpy(header.magic, CacheMagic, sizeof(CacheMagic));
+      header.version = CacheVersion;
+      header.byteOrder = CacheByteOrder;
+      header.sourceSize = uint64_t(end - begin);
+      header.sourceHash = hashText(begin, end);
+      header.numVariables = numVariables;
+      header.numQuantifiers = quantifiers.size();
+      header.numQuantifierVariables = 0;
+      header.numClauses = numClauses();
+      header.numLiterals = literals.size();
+
+      std::vector<uint32_t> quantifierTypes;
+      std::vector<uint64_t> quantifierOffsets(1, 0);
+      std::vector<int32_t> quantifierVariables;
+      for (const auto & quantifier: quantifiers)
+      {
+        quantifierTypes.push_back(quantifier.quantifierType == Quantifier::ForAll ? 0 : 1);
+        quantifierVariables.insert(quantifierVariables.end(), quantifier.variables.cbegin(), quantifier.variables.cend());
+        quantifierOffsets.push_back(quantifierVariables.size());
+      }
+      header.numQuantifierVariables = quantifierVariables.size();
+
+      // write to a temporary file and rename it into place,
+      // so that a concurrent reader never sees a partial cache
+      std::string tmpPath = cachePath + ".tmp";
+      {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out)
+          throw std::runtime_error("Could not open '" + tmpPath + "' for writing");
+        CacheWriter writer{ out };
+        writer.write(&header, sizeof(CacheHeader));
+        writer.write(quantifierTypes.data(), quantifierTypes.size() * sizeof(uint32_t));
+        writer.write(quantifierOffsets.data(), quantifierOffsets.size() * sizeof(uint64_t));
+        writer.write(quantifierVariables.data(), quantifierVariables.size() * sizeof(int32_t));
+        writer.write(clauseOffsets.data(), clauseOffsets.size() * sizeof(uint64_t));
+        writer.write(literals.data(), literals.size() * sizeof(int32_t));
+        if (!out.flush())
+          throw std::runtime_error("Could not write '" + tmpPath + "'");
+      }
+      if (std::rename(tmpPath.c_str(), cachePath.c_str()) != 0)
+        throw std::runtime_error("Could not rename '" + tmpPath + "' to '" + cachePath + "'");
+    }
+
+
+
+} // end namespace dd
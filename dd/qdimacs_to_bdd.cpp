@@ -25,17 +25,170 @@ SOFTWARE.
 #include "qdimacs_to_bdd.h"
 #include "bdd_factory.h"
 
+#include <cuddInt.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+
+
+namespace {
+
+  size_t hashLiterals(const int * begin, const int * end)
+  {
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (; begin != end; ++begin)
+      h = (h ^ uint64_t(uint32_t(*begin))) * 0x100000001b3ull;
+    return size_t(h ^ (h >> 32));
+  }
+
+
+
+  // builds the clause (l1 OR ... OR lk) as the complement of the cube
+  //   (NOT l1 AND ... AND NOT lk), with one unique table lookup per literal
+  // the literals must be distinct, non-complementary, and sorted from the
+  //   deepest level to the shallowest
+  // returns NULL if the manager ran out of memory or started reordering
+  DdNode * buildClauseRecur(DdManager * manager, const int * begin, const int * end)
+  {
+    DdNode * const one = DD_ONE(manager);
+    DdNode * const zero = Cudd_Not(one);
+    DdNode * cube = one;
+    cuddRef(cube);
+    for (; begin != end; ++begin)
+    {
+      int index = std::abs(*begin);
+      // NOT l is: (x ? zero : cube) for l = x, and (x ? cube : zero) for l = NOT x
+      DdNode * t = (*begin > 0 ? zero : cube);
+      DdNode * e = (*begin > 0 ? cube : zero);
+      DdNode * r;
+      if (Cudd_IsComplement(t))
+      {
+        r = cuddUniqueInter(manager, index, Cudd_Not(t), Cudd_Not(e));
+        if (NULL != r)
+          r = Cudd_Not(r);
+      }
+      else
+        r = cuddUniqueInter(manager, index, t, e);
+      if (NULL == r)
+      {
+        Cudd_IterDerefBdd(manager, cube);
+        return NULL;
+      }
+      cuddRef(r);
+      Cudd_IterDerefBdd(manager, cube);
+      cube = r;
+    }
+    cuddDeref(cube);
+    return Cudd_Not(cube);
+  }
+
+
+
+  // referenced bdd for the clause with sorted, distinct literals [begin, end)
+  bdd_ptr buildClause(DdManager * manager, const int * begin, const int * end, std::vector<int> & byLevel)
+  {
+    // a clause with complementary literals is a tautology
+    for (const int * lit = begin; lit != end; ++lit)
+      if (*lit < 0 && std::binary_search(begin, end, -*lit))
+        return bdd_one(manager);
+    DdNode * res;
+    do {
+      manager->reordered = 0;
+      byLevel.assign(begin, end);
+      std::sort(byLevel.begin(), byLevel.end(), [manager](int a, int b) {
+          return cuddI(manager, std::abs(a)) > cuddI(manager, std::abs(b));
+        });
+      res = buildClauseRecur(manager, byLevel.data(), byLevel.data() + byLevel.size());
+    } while (manager->reordered == 1);
+    if (NULL == res)
+      throw std::runtime_error("Out of memory while building clause bdds");
+    cuddRef(res);
+    return res;
+  }
+
+} // end anonymous namespace
+
+
+
 
 namespace dd {
 
 
+
+
+  // ***** BddClauses *****
+  size_t BddClauses::findSlot(const int * begin, const int * end) const
+  {
+    size_t const mask = m_slots.size() - 1;
+    size_t slot = hashLiterals(begin, end) & mask;
+    while (m_slots[slot] != 0)
+    {
+      size_t i = m_slots[slot] - 1;
+      if (std::equal(begin, end, literalsBegin(i), literalsEnd(i)))
+        return slot;
+      slot = (slot + 1) & mask;
+    }
+    return slot;
+  }
+
+
+  size_t BddClauses::find(const int * begin, const int * end) const
+  {
+    if (m_slots.empty())
+      return npos;
+    size_t slot = findSlot(begin, end);
+    return m_slots[slot] == 0 ? npos : m_slots[slot] - 1;
+  }
+
+
+  size_t BddClauses::find(const std::set<int>& clause) const
+  {
+    std::vector<int> literals(clause.cbegin(), clause.cend());
+    return find(literals.data(), literals.data() + literals.size());
+  }
+
+
+  void BddClauses::append(const int * begin, const int * end, bdd_ptr f)
+  {
+    if (2 * (m_bdds.size() + 1) > m_slots.size())
+      rehash(std::max<size_t>(16, 2 * m_slots.size()));
+    m_literals.insert(m_literals.end(), begin, end);
+    m_offsets.push_back(m_literals.size());
+    m_bdds.push_back(f);
+    m_slots[findSlot(begin, end)] = m_bdds.size();
+  }
+
+
+  void BddClauses::reserve(size_t numClauses, size_t numLiterals)
+  {
+    m_literals.reserve(numLiterals);
+    m_offsets.reserve(numClauses + 1);
+    m_bdds.reserve(numClauses);
+    size_t numSlots = 16;
+    while (numSlots < 2 * numClauses)
+      numSlots *= 2;
+    if (numSlots > m_slots.size())
+      rehash(numSlots);
+  }
+
+
+  void BddClauses::rehash(size_t numSlots)
+  {
+    m_slots.assign(numSlots, 0);
+    for (size_t i = 0; i < m_bdds.size(); ++i)
+      m_slots[findSlot(literalsBegin(i), literalsEnd(i))] = i + 1;
+  }
+
+
   // destructor
   QdimacsToBdd::~QdimacsToBdd()
   {
     for (auto & q: quantifications)
       bdd_free(ddManager, q->quantifiedVariables);
-    for (auto & kv: clauses)
-      bdd_free(ddManager, kv.second);
+    for (auto f: clauses.bdds())
+      bdd_free(ddManager, f);
   }
 
 
@@ -71,14 +224,29 @@ namespace dd {
 
 
 
-    // create factors
+    // create factors, skipping repeated clauses
+    size_t numLiterals = 0;
+    int maxIndex = 0;
     for (const auto & clauseIn: qdimacs.clauses)
     {
-      BddWrapper clauseOut = -one; // start with False
+      numLiterals += clauseIn.size();
       for (auto vin: clauseIn)
-        clauseOut = clauseOut + result->getBdd(vin);
-      std::set<int> clauseKey(clauseIn.cbegin(), clauseIn.cend());
-      result->clauses[clauseKey] = clauseOut.getCountedBdd();
+        maxIndex = std::max(maxIndex, std::abs(vin));
+    }
+    if (maxIndex > 0)
+      bdd_free(ddManager, bdd_new_var_with_index(ddManager, maxIndex)); // creates all the variables up to maxIndex
+    result->clauses.reserve(qdimacs.clauses.size(), numLiterals);
+    std::vector<int> clauseKey, byLevel;
+    for (const auto & clauseIn: qdimacs.clauses)
+    {
+      clauseKey.assign(clauseIn.cbegin(), clauseIn.cend());
+      std::sort(clauseKey.begin(), clauseKey.end());
+      clauseKey.erase(std::unique(clauseKey.begin(), clauseKey.end()), clauseKey.end());
+      const int * begin = clauseKey.data();
+      const int * end = begin + clauseKey.size();
+      if (result->clauses.find(begin, end) != BddClauses::npos)
+        continue;
+      result->clauses.append(begin, end, buildClause(ddManager, begin, end, byLevel));
     }
 
 
@@ -100,9 +268,9 @@ namespace dd {
   BddWrapper
     QdimacsToBdd::getBdd(const std::set<int>& clause) const
   {
-    auto cit = clauses.find(clause);
-    if (cit != clauses.end())
-      return BddWrapper(bdd_dup(cit->second), ddManager);
+    auto ci = clauses.find(clause);
+    if (ci != BddClauses::npos)
+      return BddWrapper(bdd_dup(clauses.bdd(ci)), ddManager);
     BddWrapper result(bdd_zero(ddManager), ddManager);
     for (const auto l: clause)
     {
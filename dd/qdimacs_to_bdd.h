@@ -30,7 +30,6 @@ SOFTWARE.
 
 #include <vector>
 #include <set>
-#include <map>
 #include <memory>
 
 
@@ -53,13 +52,51 @@ namespace dd {
 
 
 
+  // the distinct clauses of a qdimacs in bdd form, in order of first occurrence
+  // the literals of each clause are sorted and stored back to back (CSR layout),
+  // with an open addressing hash index from literals to clause position
+  class BddClauses {
+    public:
+      static const size_t npos = size_t(-1);
+
+      BddClauses() : m_literals(), m_offsets(1, 0), m_bdds(), m_slots() {}
+
+      size_t size() const { return m_bdds.size(); }
+      bool empty() const { return m_bdds.empty(); }
+      bdd_ptr bdd(size_t i) const { return m_bdds[i]; }       // uncounted
+      const std::vector<bdd_ptr>& bdds() const { return m_bdds; } // uncounted
+      const int * literalsBegin(size_t i) const { return m_literals.data() + m_offsets[i]; }
+      const int * literalsEnd(size_t i) const { return m_literals.data() + m_offsets[i + 1]; }
+
+      // position of the clause with literals [begin, end) (sorted, distinct), or npos
+      size_t find(const int * begin, const int * end) const;
+      size_t find(const std::set<int>& clause) const;
+
+      // add a clause that is not yet present, taking over the reference to f
+      void append(const int * begin, const int * end, bdd_ptr f);
+
+      void reserve(size_t numClauses, size_t numLiterals);
+
+    private:
+      size_t findSlot(const int * begin, const int * end) const;
+      void rehash(size_t numSlots);
+
+      std::vector<int> m_literals;
+      std::vector<size_t> m_offsets;
+      std::vector<bdd_ptr> m_bdds;
+      std::vector<size_t> m_slots; // clause position + 1, or 0 if empty
+  };
+
+
+
+
   // qdimacs file in bdd form
   struct QdimacsToBdd {
 
 
     int numVariables;                                    // number of variables
     std::vector<BddQuantificationUPtr> quantifications;  // quantification clauses ordered from outer to inner
-    std::map<std::set<int>, bdd_ptr> clauses;            // cnf factors, mapped from original int-set clause to bdd clause
+    BddClauses clauses;                                  // cnf factors, one per distinct clause
     DdManager* ddManager;                                // the bdd manager
 
     typedef std::shared_ptr<QdimacsToBdd> Ptr;
@@ -0,0 +1,151 @@
+/*
+
+Copyright 2026 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace parakram {
+
+  // ***** SmallVector *****
+  // ******* class *******
+  // A vector of trivially copyable elements
+  //   that keeps up to N elements inline,
+  //   and only spills to the heap beyond that.
+  // Used as a cheap, allocation-free key for
+  //   small sets of pointers (see NodeSetCache).
+  // Template arguments:
+  //   T: the element type, must be trivially copyable
+  //   N: the number of elements stored inline
+  template<typename T, size_t N>
+    class SmallVector
+    {
+      static_assert(std::is_trivially_copyable<T>::value, "SmallVector needs trivially copyable elements");
+      public:
+        typedef T * iterator;
+        typedef T const * const_iterator;
+
+        SmallVector() : m_data(m_inline), m_size(0), m_capacity(N) { }
+
+        SmallVector(SmallVector<T, N> const & that) : SmallVector()
+        {
+          assign(that.begin(), that.end());
+        }
+
+        template<typename TIter>
+          SmallVector(TIter first, TIter last) : SmallVector()
+          {
+            assign(first, last);
+          }
+
+        SmallVector<T, N> & operator = (SmallVector<T, N> const & that)
+        {
+          if (this != &that)
+            assign(that.begin(), that.end());
+          return *this;
+        }
+
+        ~SmallVector()
+        {
+          if (m_data != m_inline)
+            delete[] m_data;
+        }
+
+        template<typename TIter>
+          void assign(TIter first, TIter last)
+          {
+            clear();
+            for (; first != last; ++first)
+              push_back(*first);
+          }
+
+        void push_back(T const & value)
+        {
+          if (m_size == m_capacity)
+            reserve(2 * m_capacity);
+          m_data[m_size++] = value;
+        }
+
+        void pop_back() { --m_size; }
+
+        void reserve(size_t capacity)
+        {
+          if (capacity <= m_capacity)
+            return;
+          T * data = new T[capacity];
+          std::memcpy(data, m_data, m_size * sizeof(T));
+          if (m_data != m_inline)
+            delete[] m_data;
+          m_data = data;
+          m_capacity = capacity;
+        }
+
+        void resize(size_t size)
+        {
+          reserve(size);
+          m_size = size;
+        }
+
+        void clear() { m_size = 0; }
+
+        // sort and remove duplicates
+        void sortUnique()
+        {
+          std::sort(m_data, m_data + m_size);
+          m_size = std::unique(m_data, m_data + m_size) - m_data;
+        }
+
+        // remove all occurences of value, preserving order
+        void erase(T const & value)
+        {
+          m_size = std::remove(m_data, m_data + m_size, value) - m_data;
+        }
+
+        bool isInline() const { return m_data == m_inline; }
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+        T * data() { return m_data; }
+        T const * data() const { return m_data; }
+        T & operator[] (size_t i) { return m_data[i]; }
+        T const & operator[] (size_t i) const { return m_data[i]; }
+        T & back() { return m_data[m_size - 1]; }
+        iterator begin() { return m_data; }
+        iterator end() { return m_data + m_size; }
+        const_iterator begin() const { return m_data; }
+        const_iterator end() const { return m_data + m_size; }
+
+      private:
+        T m_inline[N];
+        T * m_data;
+        size_t m_size;
+        size_t m_capacity;
+    };
+
+} // end namespace parakram
@@ -0,0 +1,220 @@
+/*
+
+Copyright 2026 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+#include "support_cache.h"
+
+#include <cudd.h>
+
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+  // ***** SupportCacheEntry *****
+  // memoized support of one regular node
+  struct SupportCacheEntry
+  {
+    bdd_ptr cube;          // referenced support cube
+    dd::VarSet vars;       // VarSet version of cube, filled in on demand
+    bool hasVars;
+  };
+
+
+
+  // ***** SupportCache *****
+  // memoized supports of one manager (see dd::enableSupportCache)
+  struct SupportCache
+  {
+    size_t capacity;
+    std::unordered_map<DdNode *, SupportCacheEntry> entries;
+    dd::SupportCacheStats stats;
+
+    SupportCache(size_t v_capacity) :
+      capacity(v_capacity),
+      entries(),
+      stats{0, 0, 0, 0, 0}
+    { }
+  };
+
+  // registry of the support caches, one per manager
+  std::mutex supportCachesMutex;
+  std::unordered_map<DdManager *, std::unique_ptr<SupportCache> > supportCaches;
+
+  SupportCache * findSupportCache(DdManager * manager)
+  {
+    std::lock_guard<std::mutex> lock(supportCachesMutex);
+    auto it = supportCaches.find(manager);
+    return it == supportCaches.end() ? NULL : it->second.get();
+  }
+
+  // releases all the cubes held by the cache
+  void flushSupportCache(DdManager * manager, SupportCache & cache)
+  {
+    for (auto & entry: cache.entries)
+      Cudd_RecursiveDeref(manager, entry.second.cube);
+    cache.entries.clear();
+  }
+
+  // CUDD hook that flushes the support cache of a manager
+  int flushSupportCacheHook(DdManager * manager, const char *, void *)
+  {
+    auto cache = findSupportCache(manager);
+    if (cache)
+    {
+      flushSupportCache(manager, *cache);
+      ++cache->stats.hookFlushes;
+    }
+    return 1;
+  }
+
+  // finds the entry of f, computing it on a miss
+  SupportCacheEntry & findEntry(DdManager * manager, SupportCache & cache, bdd_ptr f)
+  {
+    ++cache.stats.lookups;
+    DdNode * key = Cudd_Regular(f);
+    auto it = cache.entries.find(key);
+    if (it != cache.entries.end())
+    {
+      ++cache.stats.hits;
+      return it->second;
+    }
+    // may trigger a garbage collection, and hence a flush,
+    // so the entry is only inserted afterwards
+    bdd_ptr cube = bdd_support(manager, key);
+    if (cache.entries.size() >= cache.capacity)
+    {
+      flushSupportCache(manager, cache);
+      ++cache.stats.fullFlushes;
+    }
+    return cache.entries.emplace(key, SupportCacheEntry{cube, dd::VarSet(), false}).first->second;
+  }
+
+} // end anonymous namespace
+
+
+
+namespace dd
+{
+
+  bool enableSupportCache(DdManager * manager, size_t capacity)
+  {
+    {
+      std::lock_guard<std::mutex> lock(supportCachesMutex);
+      auto & cache = supportCaches[manager];
+      if (!cache)
+        cache.reset(new SupportCache(capacity));
+    }
+    if (0 == Cudd_AddHook(manager, flushSupportCacheHook, CUDD_PRE_GC_HOOK)
+        || 0 == Cudd_AddHook(manager, flushSupportCacheHook, CUDD_PRE_REORDERING_HOOK))
+    {
+      disableSupportCache(manager);
+      return false;
+    }
+    return true;
+  }
+
+  bool disableSupportCache(DdManager * manager)
+  {
+    Cudd_RemoveHook(manager, flushSupportCacheHook, CUDD_PRE_GC_HOOK);
+    Cudd_RemoveHook(manager, flushSupportCacheHook, CUDD_PRE_REORDERING_HOOK);
+    std::unique_ptr<SupportCache> cache;
+    {
+      std::lock_guard<std::mutex> lock(supportCachesMutex);
+      auto it = supportCaches.find(manager);
+      if (it == supportCaches.end())
+        return false;
+      cache = std::move(it->second);
+      supportCaches.erase(it);
+    }
+    flushSupportCache(manager, *cache);
+    return true;
+  }
+
+  bool readSupportCacheStats(DdManager * manager, SupportCacheStats * stats)
+  {
+    auto cache = findSupportCache(manager);
+    if (NULL == cache)
+      return false;
+    *stats = cache->stats;
+    stats->entries = cache->entries.size();
+    return true;
+  }
+
+  bdd_ptr supportCube(DdManager * manager, bdd_ptr f)
+  {
+    auto cache = findSupportCache(manager);
+    if (NULL == cache)
+      return bdd_support(manager, f);
+    return bdd_dup(findEntry(manager, *cache, f).cube);
+  }
+
+  VarSet supportVars(DdManager * manager, bdd_ptr f)
+  {
+    auto cache = findSupportCache(manager);
+    if (NULL == cache)
+    {
+      bdd_ptr cube = bdd_support(manager, f);
+      VarSet vars = VarSet::fromCube(manager, cube);
+      bdd_free(manager, cube);
+      return vars;
+    }
+    auto & entry = findEntry(manager, *cache, f);
+    if (!entry.hasVars)
+    {
+      entry.vars = VarSet::fromCube(manager, entry.cube);
+      entry.hasVars = true;
+    }
+    return entry.vars;
+  }
+
+  std::vector<int> supportIndices(DdManager * manager, bdd_ptr f)
+  {
+    std::vector<int> result;
+    bdd_ptr cube = supportCube(manager, f);
+    for (auto scan = cube; !Cudd_IsConstant(scan); scan = Cudd_T(scan))
+      result.push_back(Cudd_NodeReadIndex(scan));
+    bdd_free(manager, cube);
+    return result;
+  }
+
+
+
+  SupportCacheScope::SupportCacheScope(DdManager * manager, size_t capacity) :
+    m_manager(manager)
+  {
+    if (!enableSupportCache(manager, capacity))
+      throw std::runtime_error("Could not enable the support cache");
+  }
+
+  SupportCacheScope::~SupportCacheScope()
+  {
+    disableSupportCache(m_manager);
+  }
+
+} // end namespace dd
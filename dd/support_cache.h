@@ -0,0 +1,96 @@
+/*
+
+Copyright 2026 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+#pragma once
+
+#include "dd.h"
+#include "var_set.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace dd
+{
+
+  // default cap on the number of functions whose support is memoized
+  size_t const DefaultSupportCacheCapacity = 1 << 16;
+
+  // statistics of the support cache of a manager
+  struct SupportCacheStats
+  {
+    unsigned long long lookups;     // number of calls to supportCube / supportVars
+    unsigned long long hits;        // number of those answered from the cache
+    unsigned long long hookFlushes; // number of flushes on gc/reordering
+    unsigned long long fullFlushes; // number of flushes on reaching the capacity
+    size_t entries;                 // number of functions currently memoized
+  };
+
+
+
+  // Attaches a support cache to the manager, keyed by regular node pointer
+  // (f and its complement share an entry). Supports are kept both as
+  // referenced cube bdds and, lazily, as VarSets.
+  // The cache is flushed before every garbage collection and reordering,
+  // so it never refers to freed nodes, and it is flushed whenever it
+  // holds capacity entries.
+  // Must be disabled before the manager is destroyed.
+  // Returns false if the gc/reordering hooks could not be added.
+  bool enableSupportCache(DdManager * manager, size_t capacity = DefaultSupportCacheCapacity);
+
+  // Removes the support cache of the manager, releasing the cubes it holds.
+  // Returns false if the manager had no support cache.
+  bool disableSupportCache(DdManager * manager);
+
+  // Fills in the statistics of the support cache of the manager.
+  // Returns false if the manager has no support cache.
+  bool readSupportCacheStats(DdManager * manager, SupportCacheStats * stats);
+
+  // Support of f as a cube, memoized if the manager has a support cache.
+  // Returns a referenced bdd (like bdd_support).
+  bdd_ptr supportCube(DdManager * manager, bdd_ptr f);
+
+  // Support of f as a VarSet, memoized if the manager has a support cache.
+  VarSet supportVars(DdManager * manager, bdd_ptr f);
+
+  // Indices of the variables in the support of f, in increasing order of level.
+  std::vector<int> supportIndices(DdManager * manager, bdd_ptr f);
+
+
+
+  // enables the support cache of a manager for the lifetime of the object
+  class SupportCacheScope
+  {
+    public:
+      SupportCacheScope(DdManager * manager, size_t capacity = DefaultSupportCacheCapacity);
+      ~SupportCacheScope();
+      SupportCacheScope(SupportCacheScope const &) = delete;
+      SupportCacheScope & operator=(SupportCacheScope const &) = delete;
+    private:
+      DdManager * m_manager;
+  };
+
+} // end namespace dd
@@ -0,0 +1,126 @@
+/*
+
+Copyright 2026 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace parakram {
+
+  // ***** ThreadPool *****
+  // ****** class ******
+  // A fixed set of worker threads running submitted tasks in FIFO order.
+  // submit returns a future for the task's result; exceptions thrown by
+  //   the task are rethrown by the future's get().
+  // The destructor runs all the tasks already submitted, then joins.
+  class ThreadPool
+  {
+    public:
+      // numThreads <= 0 means one thread per hardware thread
+      explicit ThreadPool(int numThreads = 0) :
+        m_threads(),
+        m_tasks(),
+        m_mutex(),
+        m_hasWork(),
+        m_isStopping(false)
+      {
+        int n = numThreads > 0 ? numThreads : defaultNumThreads();
+        m_threads.reserve(n);
+        for (int i = 0; i < n; ++i)
+          m_threads.emplace_back([this]() { work(); });
+      }
+
+      ~ThreadPool()
+      {
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          m_isStopping = true;
+        }
+        m_hasWork.notify_all();
+        for (auto & thread: m_threads)
+          thread.join();
+      }
+
+      ThreadPool(ThreadPool const &) = delete;
+      ThreadPool & operator = (ThreadPool const &) = delete;
+
+      template<typename TFunc>
+        std::future<typename std::result_of<TFunc()>::type> submit(TFunc && func)
+        {
+          typedef typename std::result_of<TFunc()>::type TResult;
+          auto task = std::make_shared<std::packaged_task<TResult()> >(std::forward<TFunc>(func));
+          auto result = task->get_future();
+          {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.emplace_back([task]() { (*task)(); });
+          }
+          m_hasWork.notify_one();
+          return result;
+        }
+
+      int numThreads() const { return static_cast<int>(m_threads.size()); }
+
+      static int defaultNumThreads()
+      {
+        unsigned n = std::thread::hardware_concurrency();
+        return n > 0 ? static_cast<int>(n) : 1;
+      }
+
+    private:
+      void work()
+      {
+        while (true)
+        {
+          std::function<void()> task;
+          {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_hasWork.wait(lock, [this]() { return m_isStopping || !m_tasks.empty(); });
+            if (m_tasks.empty())
+              return;
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+          }
+          task();
+        }
+      }
+
+      std::vector<std::thread> m_threads;
+      std::deque<std::function<void()> > m_tasks;
+      std::mutex m_mutex;
+      std::condition_variable m_hasWork;
+      bool m_isStopping;
+  }; // end class ThreadPool
+
+} // end namespace parakram
@@ -0,0 +1,62 @@
+/*
+
+Copyright 2026 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+#include "var_set.h"
+#include "support_cache.h"
+
+#include <cudd.h>
+
+namespace dd
+{
+
+  VarSet VarSet::fromCube(DdManager *, bdd_ptr cube)
+  {
+    VarSet result;
+    for (auto scan = Cudd_Regular(cube); !Cudd_IsConstant(scan); scan = Cudd_T(scan))
+      result.insert(Cudd_NodeReadIndex(scan));
+    return result;
+  }
+
+  VarSet VarSet::support(DdManager * manager, bdd_ptr f)
+  {
+    return supportVars(manager, f);
+  }
+
+  bdd_ptr VarSet::toCube(DdManager * manager) const
+  {
+    auto vars = indices();
+    std::vector<bdd_ptr> varBdds;
+    varBdds.reserve(vars.size());
+    for (auto index: vars)
+      varBdds.push_back(Cudd_bddIthVar(manager, index));
+    auto cube = Cudd_bddComputeCube(manager, varBdds.data(), NULL, int(varBdds.size()));
+    common_error(cube, "VarSet::toCube: cube = NULL");
+    Cudd_Ref(cube);
+    return cube;
+  }
+
+} // end namespace dd
@@ -0,0 +1,196 @@
+/*
+
+Copyright 2026 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+#pragma once
+
+#include "dd.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dd
+{
+
+  // ***** VarSet *****
+  // ***** class *****
+  // A set of variable indices stored as a dense bitset,
+  //   with bit (i % 64) of word (i / 64) set iff variable i is in the set.
+  // Words beyond the end of the storage are implicitly zero,
+  //   so sets over different numbers of variables can be mixed freely.
+  // Meant to replace support cubes in set arithmetic on hot paths:
+  //   the operations are plain loops over words (which compilers vectorize)
+  //   and popcounts, and never touch the unique table.
+  class VarSet
+  {
+    public:
+      typedef uint64_t Word;
+      static constexpr size_t WordBits = 64;
+
+      VarSet() : m_words() { }
+
+      // the variables in a positive cube
+      static VarSet fromCube(DdManager * manager, bdd_ptr cube);
+      // the variables in the support of f (memoized by the support cache, if enabled)
+      static VarSet support(DdManager * manager, bdd_ptr f);
+      // the cube of the variables in the set, as a referenced bdd
+      bdd_ptr toCube(DdManager * manager) const;
+
+      void insert(int index)
+      {
+        size_t w = index / WordBits;
+        if (m_words.size() <= w)
+          m_words.resize(w + 1, 0);
+        m_words[w] |= Word(1) << (index % WordBits);
+      }
+
+      void erase(int index)
+      {
+        size_t w = index / WordBits;
+        if (w < m_words.size())
+          m_words[w] &= ~(Word(1) << (index % WordBits));
+      }
+
+      bool contains(int index) const
+      {
+        size_t w = index / WordBits;
+        return w < m_words.size() && (m_words[w] >> (index % WordBits) & 1);
+      }
+
+      size_t size() const
+      {
+        size_t result = 0;
+        for (auto word: m_words)
+          result += popcount(word);
+        return result;
+      }
+
+      bool empty() const
+      {
+        for (auto word: m_words)
+          if (word)
+            return false;
+        return true;
+      }
+
+      // indices of the variables in the set, in increasing order
+      std::vector<int> indices() const
+      {
+        std::vector<int> result;
+        for (size_t w = 0; w < m_words.size(); ++w)
+          for (Word word = m_words[w]; word; word &= word - 1)
+            result.push_back(int(w * WordBits + __builtin_ctzll(word)));
+        return result;
+      }
+
+      bool intersects(VarSet const & that) const
+      {
+        size_t n = std::min(m_words.size(), that.m_words.size());
+        for (size_t w = 0; w < n; ++w)
+          if (m_words[w] & that.m_words[w])
+            return true;
+        return false;
+      }
+
+      // |this & that|, |this | that| and |this - that|, without building the sets
+      size_t intersectionSize(VarSet const & that) const
+      {
+        size_t n = std::min(m_words.size(), that.m_words.size());
+        size_t result = 0;
+        for (size_t w = 0; w < n; ++w)
+          result += popcount(m_words[w] & that.m_words[w]);
+        return result;
+      }
+
+      size_t unionSize(VarSet const & that) const
+      {
+        return size() + that.size() - intersectionSize(that);
+      }
+
+      size_t differenceSize(VarSet const & that) const
+      {
+        return size() - intersectionSize(that);
+      }
+
+      VarSet & operator |= (VarSet const & that)
+      {
+        if (m_words.size() < that.m_words.size())
+          m_words.resize(that.m_words.size(), 0);
+        for (size_t w = 0; w < that.m_words.size(); ++w)
+          m_words[w] |= that.m_words[w];
+        return *this;
+      }
+
+      VarSet & operator &= (VarSet const & that)
+      {
+        if (m_words.size() > that.m_words.size())
+          m_words.resize(that.m_words.size());
+        for (size_t w = 0; w < m_words.size(); ++w)
+          m_words[w] &= that.m_words[w];
+        return *this;
+      }
+
+      VarSet & operator -= (VarSet const & that)
+      {
+        size_t n = std::min(m_words.size(), that.m_words.size());
+        for (size_t w = 0; w < n; ++w)
+          m_words[w] &= ~that.m_words[w];
+        return *this;
+      }
+
+      bool operator == (VarSet const & that) const
+      {
+        size_t n = std::min(m_words.size(), that.m_words.size());
+        for (size_t w = 0; w < n; ++w)
+          if (m_words[w] != that.m_words[w])
+            return false;
+        auto const & longer = m_words.size() > n ? m_words : that.m_words;
+        for (size_t w = n; w < longer.size(); ++w)
+          if (longer[w])
+            return false;
+        return true;
+      }
+
+      bool operator != (VarSet const & that) const
+      {
+        return !(*this == that);
+      }
+
+      std::vector<Word> const & words() const { return m_words; }
+
+    private:
+      static size_t popcount(Word word) { return __builtin_popcountll(word); }
+
+      std::vector<Word> m_words;
+  }; // end class VarSet
+
+  inline VarSet operator | (VarSet lhs, VarSet const & rhs) { return lhs |= rhs; }
+  inline VarSet operator & (VarSet lhs, VarSet const & rhs) { return lhs &= rhs; }
+  inline VarSet operator - (VarSet lhs, VarSet const & rhs) { return lhs -= rhs; }
+
+} // end namespace dd
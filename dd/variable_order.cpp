@@ -0,0 +1,355 @@
+/*
+
+Copyright 2026 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+#include "variable_order.h"
+#include "var_set.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <limits>
+#include <stdexcept>
+
+
+namespace {
+
+  // FORCE stops after this many passes even if the span is still shrinking
+  const int MaxForceIterations = 100;
+
+
+
+  // ***** Incidence *****
+  // the edges of each variable of a hypergraph, in CSR layout
+  struct Incidence {
+    std::vector<size_t> varOffsets;
+    std::vector<size_t> varEdges;
+
+    explicit Incidence(const dd::VariableHypergraph & hypergraph, int maxIndex) :
+      varOffsets(size_t(maxIndex) + 2, 0),
+      varEdges(hypergraph.edgeVariables.size())
+    {
+      for (int v: hypergraph.edgeVariables)
+        ++varOffsets[size_t(v) + 1];
+      for (size_t i = 1; i < varOffsets.size(); ++i)
+        varOffsets[i] += varOffsets[i - 1];
+      std::vector<size_t> next(varOffsets.begin(), varOffsets.end() - 1);
+      for (size_t e = 0; e < hypergraph.numEdges(); ++e)
+        for (auto v = hypergraph.edgeBegin(e); v != hypergraph.edgeEnd(e); ++v)
+          varEdges[next[*v]++] = e;
+    }
+
+    size_t degree(int v) const { return varOffsets[v + 1] - varOffsets[v]; }
+  };
+
+
+
+  int maxVariable(const dd::VariableHypergraph & hypergraph)
+  {
+    int result = -1;
+    for (int v: hypergraph.edgeVariables)
+      result = std::max(result, v);
+    return result;
+  }
+
+
+
+  // visit the edges breadth first, appending the new variables of each edge
+  std::vector<int> clusterOrder(const dd::VariableHypergraph & hypergraph, const Incidence & incidence)
+  {
+    std::vector<int> order;
+    std::vector<bool> isPlaced(incidence.varOffsets.size() - 1, false);
+    std::vector<bool> isQueued(hypergraph.numEdges(), false);
+    std::deque<size_t> queue;
+    for (size_t root = 0; root < hypergraph.numEdges(); ++root)
+    {
+      if (isQueued[root])
+        continue;
+      isQueued[root] = true;
+      queue.push_back(root);
+      while (!queue.empty())
+      {
+        size_t e = queue.front();
+        queue.pop_front();
+        for (auto v = hypergraph.edgeBegin(e); v != hypergraph.edgeEnd(e); ++v)
+        {
+          if (isPlaced[*v])
+            continue;
+          isPlaced[*v] = true;
+          order.push_back(*v);
+          for (size_t i = incidence.varOffsets[*v]; i < incidence.varOffsets[*v + 1]; ++i)
+          {
+            size_t ne = incidence.varEdges[i];
+            if (!isQueued[ne])
+            {
+              isQueued[ne] = true;
+              queue.push_back(ne);
+            }
+          }
+        }
+      }
+    }
+    return order;
+  }
+
+
+
+  size_t span(const dd::VariableHypergraph & hypergraph, const std::vector<double> & position)
+  {
+    size_t result = 0;
+    for (size_t e = 0; e < hypergraph.numEdges(); ++e)
+    {
+      if (hypergraph.edgeBegin(e) == hypergraph.edgeEnd(e))
+        continue;
+      double lo = std::numeric_limits<double>::max(), hi = std::numeric_limits<double>::lowest();
+      for (auto v = hypergraph.edgeBegin(e); v != hypergraph.edgeEnd(e); ++v)
+      {
+        lo = std::min(lo, position[*v]);
+        hi = std::max(hi, position[*v]);
+      }
+      result += size_t(hi - lo);
+    }
+    return result;
+  }
+
+
+
+  // FORCE, starting from 'order' and returning the order with the smallest span seen
+  std::vector<int> forceOrder(const dd::VariableHypergraph & hypergraph, const Incidence & incidence, std::vector<int> order)
+  {
+    std::vector<double> position(incidence.varOffsets.size() - 1, 0);
+    std::vector<double> centerOfGravity(hypergraph.numEdges(), 0);
+    std::vector<double> target(position.size(), 0);
+    for (size_t i = 0; i < order.size(); ++i)
+      position[order[i]] = double(i);
+    size_t bestSpan = span(hypergraph, position);
+    std::vector<int> bestOrder = order;
+
+    for (int iteration = 0; iteration < MaxForceIterations; ++iteration)
+    {
+      for (size_t e = 0; e < hypergraph.numEdges(); ++e)
+      {
+        double sum = 0;
+        for (auto v = hypergraph.edgeBegin(e); v != hypergraph.edgeEnd(e); ++v)
+          sum += position[*v];
+        size_t size = hypergraph.edgeEnd(e) - hypergraph.edgeBegin(e);
+        centerOfGravity[e] = size > 0 ? sum / double(size) : 0;
+      }
+      for (int v: order)
+      {
+        double sum = 0;
+        for (size_t i = incidence.varOffsets[v]; i < incidence.varOffsets[v + 1]; ++i)
+          sum += centerOfGravity[incidence.varEdges[i]];
+        target[v] = sum / double(incidence.degree(v));
+      }
+      std::stable_sort(order.begin(), order.end(), [&target](int a, int b) { return target[a] < target[b]; });
+      for (size_t i = 0; i < order.size(); ++i)
+        position[order[i]] = double(i);
+
+      size_t newSpan = span(hypergraph, position);
+      if (newSpan >= bestSpan)
+        break;
+      bestSpan = newSpan;
+      bestOrder = order;
+    }
+    return bestOrder;
+  }
+
+} // end anonymous namespace
+
+
+
+
+namespace dd {
+
+
+
+  VariableOrdering parseVariableOrdering(std::string const & name)
+  {
+    std::string lower(name);
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return std::tolower(c); });
+    if (lower == "none")
+      return VariableOrdering::None;
+    else if (lower == "cluster")
+      return VariableOrdering::Cluster;
+    else if (lower == "force")
+      return VariableOrdering::Force;
+    throw std::invalid_argument("Unknown variable ordering '" + name + "', expecting one of none/cluster/force");
+  }
+
+  std::string toString(VariableOrdering ordering)
+  {
+    switch (ordering)
+    {
+      case VariableOrdering::None: return "none";
+      case VariableOrdering::Cluster: return "cluster";
+      case VariableOrdering::Force: return "force";
+    }
+    return "unknown";
+  }
+
+
+
+  void VariableHypergraph::addEdge(const int * begin, const int * end)
+  {
+    edgeVariables.insert(edgeVariables.end(), begin, end);
+    edgeOffsets.push_back(edgeVariables.size());
+  }
+
+  VariableHypergraph VariableHypergraph::fromClauses(const Qdimacs & qdimacs)
+  {
+    VariableHypergraph result;
+    std::vector<int> vars;
+    for (const auto & clause: qdimacs.clauses)
+    {
+      vars.clear();
+      for (int literal: clause)
+        vars.push_back(std::abs(literal));
+      std::sort(vars.begin(), vars.end());
+      vars.erase(std::unique(vars.begin(), vars.end()), vars.end());
+      result.addEdge(vars.data(), vars.data() + vars.size());
+    }
+    return result;
+  }
+
+  VariableHypergraph VariableHypergraph::fromSupports(DdManager * manager, const std::vector<bdd_ptr> & factors)
+  {
+    VariableHypergraph result;
+    for (auto f: factors)
+    {
+      auto vars = VarSet::support(manager, f).indices();
+      result.addEdge(vars.data(), vars.data() + vars.size());
+    }
+    return result;
+  }
+
+
+
+  std::vector<int> computeVariableOrder(const VariableHypergraph & hypergraph, VariableOrdering ordering)
+  {
+    if (ordering == VariableOrdering::None)
+      return std::vector<int>();
+    Incidence incidence(hypergraph, maxVariable(hypergraph));
+    auto order = clusterOrder(hypergraph, incidence);
+    if (ordering == VariableOrdering::Force)
+      order = forceOrder(hypergraph, incidence, std::move(order));
+    return order;
+  }
+
+
+
+  size_t hypergraphSpan(const VariableHypergraph & hypergraph, const std::vector<int> & order)
+  {
+    int maxIndex = maxVariable(hypergraph);
+    for (int v: order)
+      maxIndex = std::max(maxIndex, v);
+    std::vector<double> position(size_t(maxIndex + 1), 0);
+    std::vector<bool> isOrdered(position.size(), false);
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+      position[order[i]] = double(i);
+      isOrdered[order[i]] = true;
+    }
+    VariableHypergraph ordered;
+    std::vector<int> vars;
+    for (size_t e = 0; e < hypergraph.numEdges(); ++e)
+    {
+      vars.clear();
+      for (auto v = hypergraph.edgeBegin(e); v != hypergraph.edgeEnd(e); ++v)
+        if (isOrdered[*v])
+          vars.push_back(*v);
+      ordered.addEdge(vars.data(), vars.data() + vars.size());
+    }
+    return span(ordered, position);
+  }
+
+
+
+  std::vector<int> currentVariableOrder(DdManager * manager)
+  {
+    std::vector<int> result(size_t(Cudd_ReadSize(manager)));
+    for (size_t level = 0; level < result.size(); ++level)
+      result[level] = Cudd_ReadInvPerm(manager, int(level));
+    return result;
+  }
+
+
+
+  void applyVariableOrder(DdManager * manager, const std::vector<int> & order)
+  {
+    if (order.empty())
+      return;
+    int maxIndex = *std::max_element(order.cbegin(), order.cend());
+    if (maxIndex >= Cudd_ReadSize(manager))
+      bdd_free(manager, bdd_new_var_with_index(manager, maxIndex));
+
+    std::vector<int> permutation;
+    permutation.reserve(size_t(Cudd_ReadSize(manager)));
+    std::vector<bool> isPlaced(size_t(Cudd_ReadSize(manager)), false);
+    for (int v: order)
+      if (!isPlaced[v])
+      {
+        isPlaced[v] = true;
+        permutation.push_back(v);
+      }
+    for (int v: currentVariableOrder(manager))
+      if (!isPlaced[v])
+        permutation.push_back(v);
+
+    if (!Cudd_ShuffleHeap(manager, permutation.data()))
+      throw std::runtime_error("Could not apply the variable order");
+  }
+
+
+
+  VariableOrderStats orderVariables(DdManager * manager, const VariableHypergraph & hypergraph, VariableOrdering ordering)
+  {
+    auto start = std::chrono::steady_clock::now();
+    VariableOrderStats stats;
+    // create the variables up front so that the span before reflects the default order
+    int maxIndex = maxVariable(hypergraph);
+    if (maxIndex >= Cudd_ReadSize(manager))
+      bdd_free(manager, bdd_new_var_with_index(manager, maxIndex));
+    stats.spanBefore = hypergraphSpan(hypergraph, currentVariableOrder(manager));
+    applyVariableOrder(manager, computeVariableOrder(hypergraph, ordering));
+    stats.spanAfter = hypergraphSpan(hypergraph, currentVariableOrder(manager));
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+  }
+
+
+
+  size_t sharedSize(const std::vector<bdd_ptr> & bdds)
+  {
+    if (bdds.empty())
+      return 0;
+    std::vector<DdNode *> nodes(bdds.cbegin(), bdds.cend());
+    return size_t(Cudd_SharingSize(nodes.data(), int(nodes.size())));
+  }
+
+} // end namespace dd
@@ -0,0 +1,109 @@
+/*
+
+Copyright 2026 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+#pragma once
+
+#include "dd.h"
+#include "qdimacs.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace dd {
+
+  // ***** VariableOrdering *****
+  // static orders that can be applied to a manager before factors are combined
+  //   None:    keep the order in which the variables were created
+  //   Cluster: walk the hypergraph breadth first, one edge at a time,
+  //            placing the variables of each edge next to each other
+  //   Force:   FORCE (Aloul, Markov, Sakallah), started from the Cluster order:
+  //            repeatedly move each variable to the mean center of gravity
+  //            of its edges, while the total edge span keeps shrinking
+  enum class VariableOrdering { None, Cluster, Force };
+
+  // parses none / cluster / force (case insensitive),
+  // throws std::invalid_argument otherwise
+  VariableOrdering parseVariableOrdering(std::string const & name);
+  std::string toString(VariableOrdering ordering);
+
+
+
+  // ***** VariableHypergraph *****
+  // variable indices connected by the clauses or factors that mention them,
+  // with the variables of all edges stored back to back (CSR layout)
+  struct VariableHypergraph {
+    std::vector<int> edgeVariables;
+    std::vector<size_t> edgeOffsets;
+
+    VariableHypergraph() : edgeVariables(), edgeOffsets(1, 0) {}
+
+    size_t numEdges() const { return edgeOffsets.size() - 1; }
+    const int * edgeBegin(size_t e) const { return edgeVariables.data() + edgeOffsets[e]; }
+    const int * edgeEnd(size_t e) const { return edgeVariables.data() + edgeOffsets[e + 1]; }
+    void addEdge(const int * begin, const int * end);
+
+    // one edge per clause, over the variables of its literals
+    static VariableHypergraph fromClauses(const Qdimacs & qdimacs);
+    // one edge per factor, over its support
+    static VariableHypergraph fromSupports(DdManager * manager, const std::vector<bdd_ptr> & factors);
+  };
+
+
+
+  // the variables of the hypergraph, top first
+  // returns an empty order for VariableOrdering::None
+  std::vector<int> computeVariableOrder(const VariableHypergraph & hypergraph, VariableOrdering ordering);
+
+  // sum over all edges of the distance between the first and the last of its
+  // variables in the order (top first); variables missing from the order are ignored
+  size_t hypergraphSpan(const VariableHypergraph & hypergraph, const std::vector<int> & order);
+
+  // the variable indices of the manager, top first
+  std::vector<int> currentVariableOrder(DdManager * manager);
+
+  // moves the variables in 'order' to the top of the manager, in that sequence,
+  //   keeping the relative order of the other variables
+  //   (creating variables up to the largest index if needed)
+  // throws std::runtime_error if cudd fails to shuffle
+  void applyVariableOrder(DdManager * manager, const std::vector<int> & order);
+
+
+
+  struct VariableOrderStats {
+    size_t spanBefore;
+    size_t spanAfter;
+    double seconds;
+  };
+
+  // computes the order of the hypergraph and applies it to the manager
+  VariableOrderStats orderVariables(DdManager * manager, const VariableHypergraph & hypergraph, VariableOrdering ordering);
+
+  // number of distinct nodes in the bdds, to report the effect of an order
+  size_t sharedSize(const std::vector<bdd_ptr> & bdds);
+
+} // end namespace dd
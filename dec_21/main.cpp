@@ -26,6 +26,7 @@ SOFTWARE.
 #include <blif_solve_lib/clo.hpp>
 #include <blif_solve_lib/log.h>
 
+#include <dd/manager_factory.h>
 #include <dd/qdimacs.h>
 #include <dd/qdimacs_to_bdd.h>
 
@@ -49,6 +50,7 @@ struct CommandLineOptions {
   int maxMucSize;
   std::string inputFile;
   bool computeExact;
+  size_t maxMemory;
 };
 
 
@@ -91,7 +93,7 @@ struct Dec21MucCallback: public MucCallback
 // function declarations
 CommandLineOptions parseClo(int argc, char const * const * const argv);
 int main(int argc, char const * const * const argv);
-std::shared_ptr<DdManager> ddm_init();
+std::shared_ptr<DdManager> ddm_init(const dd::Qdimacs& qdimacs, size_t maxMemory);
 fgpp::FactorGraph::Ptr createFactorGraph(DdManager* ddm, const dd::QdimacsToBdd& qdimacsToBdd);
 std::shared_ptr<dd::Qdimacs> parseQdimacs(const std::string & inputFilePath);
 std::shared_ptr<Master> createMustMaster(const dd::Qdimacs& qdimacs, 
@@ -116,7 +118,7 @@ int main(int argc, char const * const * const argv)
 
   auto start = blif_solve::now();
   auto qdimacs = parseQdimacs(clo.inputFile);                           // parse input file
-  auto ddm = ddm_init();                                                // init cudd
+  auto ddm = ddm_init(*qdimacs, clo.maxMemory);                         // init cudd
   auto bdds = dd::QdimacsToBdd::createFromQdimacs(ddm.get(), *qdimacs); // create bdds
   auto fg = createFactorGraph(ddm.get(), *bdds);                        // create factor graph
   blif_solve_log(INFO, "create factor graph from qdimacs file with "
@@ -147,6 +149,7 @@ int main(int argc, char const * const * const argv)
   auto mustMaster = createMustMaster(*qdimacs, bdds, fg, factorGraphResult);
   mustMaster->enumerate();
 
+  blif_solve_log(INFO, "Cudd: " << dd::readManagerStats(ddm.get()));
   blif_solve_log(INFO, "Done");
   return 0;
 }
@@ -158,8 +161,7 @@ int main(int argc, char const * const * const argv)
 // parse qdimacs file
 std::shared_ptr<dd::Qdimacs> parseQdimacs(const std::string& inputFilePath)
 {
-  std::ifstream fin(inputFilePath);
-  return dd::Qdimacs::parseQdimacs(fin);
+  return dd::Qdimacs::parseQdimacsFile(inputFilePath);
 }
 
 
@@ -172,8 +174,8 @@ std::shared_ptr<dd::Qdimacs> parseQdimacs(const std::string& inputFilePath)
 fgpp::FactorGraph::Ptr createFactorGraph(DdManager* ddm, const dd::QdimacsToBdd& bdds)
 {
   std::vector<dd::BddWrapper> bddWrapperVec;
-  for (const auto& factorKv: bdds.clauses)
-    bddWrapperVec.push_back(dd::BddWrapper(bdd_dup(factorKv.second), ddm));
+  for (auto factor: bdds.clauses.bdds())
+    bddWrapperVec.push_back(dd::BddWrapper(bdd_dup(factor), ddm));
   return fgpp::FactorGraph::createFactorGraph(bddWrapperVec);
 }
 
@@ -215,10 +217,17 @@ CommandLineOptions parseClo(int argc, char const * const * const argv)
         false,
         false
     );
+  auto maxMemory =
+    std::make_shared<CommandLineOption<std::string> >(
+      "--maxMemory",
+      "memory limit for cudd in bytes, with an optional K/M/G suffix (default 0, no limit)",
+      false,
+      std::string("0")
+    );
   
   // parse the command line
   blif_solve::parse(
-      {  largestSupportSet, maxMucSize, inputFile, verbosity, computeExact },
+      {  largestSupportSet, maxMucSize, inputFile, verbosity, computeExact, maxMemory },
       argc,
       argv);
 
@@ -231,7 +240,8 @@ CommandLineOptions parseClo(int argc, char const * const * const argv)
     *(largestSupportSet->value),
     *(maxMucSize->value),
     *(inputFile->value),
-    *(computeExact->value)
+    *(computeExact->value),
+    dd::parseMemorySize(*(maxMemory->value))
   };
 }
 
@@ -239,14 +249,14 @@ CommandLineOptions parseClo(int argc, char const * const * const argv)
 
 
 
-// initialize cudd with some defaults
-std::shared_ptr<DdManager> ddm_init()
+// initialize cudd, sized for the problem
+std::shared_ptr<DdManager> ddm_init(const dd::Qdimacs& qdimacs, size_t maxMemory)
 {
-  //UNIQUE_SLOTS = 256
-  //CACHE_SLOTS = 262144
-  std::shared_ptr<DdManager> m(Cudd_Init(0, 0, 256, 262144, 0));
-  if (!m) throw std::runtime_error("Could not initialize cudd");
-  return m;
+  dd::ManagerOptions managerOptions;
+  managerOptions.numVariables = size_t(qdimacs.numVariables);
+  managerOptions.numFactors = qdimacs.clauses.size();
+  managerOptions.maxMemory = maxMemory;
+  return std::shared_ptr<DdManager>(dd::createManager(managerOptions));
 }
 
 
@@ -448,7 +458,8 @@ void Dec21MucCallback::processMuc(const std::vector<std::vector<int> >& muc)
     auto mergedFunc = m_factorGraph->groupFactors(funcNodes);
     m_factorGraph->groupVariables(varNodes);
     blif_solve_log(INFO, "merged " << funcNodes.size() << " func nodes.");
-    m_factorGraph->converge();
+    auto numUpdates = m_factorGraph->convergeIncremental(); // only re-runs what the grouping touched
+    blif_solve_log(INFO, "re-converged factor graph with " << numUpdates << " node updates.");
     m_factorGraphResult = getFactorGraphResult(m_ddManager, *m_factorGraph, *m_qdimacsToBdd);
     blif_solve_log_bdd(DEBUG, "factor graph result:", m_ddManager, m_factorGraphResult.getUncountedBdd());
     for (auto & cd: clauseDataVec) cd->funcNode = mergedFunc;
@@ -493,8 +504,8 @@ dd::BddWrapper getFactorGraphResult(DdManager* ddm, const fgpp::FactorGraph& fg,
 dd::BddWrapper getExactResult(DdManager* ddm, const dd::QdimacsToBdd& qdimacsToBdd)
 {
   bdd_ptr f = bdd_one(ddm);
-  for(const auto & kv: qdimacsToBdd.clauses)
-    bdd_and_accumulate(ddm, &f, kv.second);
+  for(auto factor: qdimacsToBdd.clauses.bdds())
+    bdd_and_accumulate(ddm, &f, factor);
   bdd_ptr result = bdd_forsome(ddm, f, qdimacsToBdd.quantifications[0]->quantifiedVariables);
   bdd_free(ddm, f);
   return dd::BddWrapper(result, ddm);
@@ -1,7 +1,12 @@
 base_dir=$(dirname $0)
 test_cases_dir=$1
+# remaining arguments are passed on to blif_solve,
+# e.g. --decompose_components
+shift
+extra_flags="$@"
 
-results_dir=${base_dir}/results
+# set RESULTS_DIR to keep the results of different flags apart
+results_dir=${RESULTS_DIR:-${base_dir}/results}
 mkdir -p ${results_dir}
 log_file=${results_dir}/full_run.log
 rm -f ${log_file}
@@ -10,7 +15,7 @@ summary_file=${results_dir}/summary.txt
 
 for test_case in $(ls ${test_cases_dir}/*.blif); do
   test_case_name=$(basename ${test_case} .blif)
-  command="blif_solve/blif_solve --under_approximating_method Skip --over_approximating_method ExactAndAbstractMulti --must_count_solutions --verbosity INFO --cacheSize 100000 ${test_case}"
+  command="blif_solve/blif_solve --under_approximating_method Skip --over_approximating_method ExactAndAbstractMulti --must_count_solutions --verbosity INFO --cache_size 100000 ${extra_flags} ${test_case}"
   echo Running ${test_case_name} | tee -a ${log_file}
   (timeout 2m ${command}) | tee -a ${log_file}
   echo Finished ${test_case_name}
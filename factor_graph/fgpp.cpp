@@ -24,71 +24,248 @@ SOFTWARE.
 
 #include "fgpp.h"
 
+#include <dd/cuddAndAbsMulti.h>
+#include <dd/support_cache.h>
+#include <dd/thread_pool.h>
+#include <dd/var_set.h>
+#include <dd/variable_order.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <stdexcept>
 #include <map>
+#include <numeric>
+#include <set>
 #include <cassert>
+#include <future>
+#include <queue>
+#include <unordered_map>
+#include <utility>
 
 namespace {
 
-  struct FGNode;
-  struct FGEdge;
-  struct FGVariableNode;
-  struct FGFactorNode;
-  typedef std::shared_ptr<FGNode> FGNodePtr;
-  typedef std::set<FGNodePtr> FGNodePtrSet;
-  typedef std::weak_ptr<FGVariableNode> FGVariableNodeWeakPtr;
-  typedef std::shared_ptr<FGVariableNode> FGVariableNodePtr;
-  typedef std::weak_ptr<FGFactorNode> FGFactorNodeWeakPtr;
-  typedef std::shared_ptr<FGFactorNode> FGFactorNodePtr;
-  typedef std::shared_ptr<FGEdge> FGEdgePtr;
-  typedef std::set<FGEdgePtr> FGEdgePtrSet;
-
-  struct FGNode {
-    FGEdgePtrSet edges;
-    dd::BddWrapper nodeBdd;
-    virtual ~FGNode() {}
-    FGNode(const dd::BddWrapper & v_nodeBdd) : edges(), nodeBdd(v_nodeBdd) {}
-    virtual void passMessages(FGNodePtrSet & updatedNodes) = 0;
+  // nodes are numbered factors first, then variables
+  typedef uint32_t Index;
+
+
+
+  // ***** IndexSet *****
+  // a set of node indices in [0, capacity), with constant time
+  // insertion and a clear that costs the number of elements
+  class IndexSet
+  {
+    public:
+      explicit IndexSet(size_t capacity) : m_isMember(capacity, 0), m_members() {}
+      bool insert(Index i)
+      {
+        if (m_isMember[i])
+          return false;
+        m_isMember[i] = 1;
+        m_members.push_back(i);
+        return true;
+      }
+      bool contains(Index i) const { return m_isMember[i] != 0; }
+      size_t size() const { return m_members.size(); }
+      bool empty() const { return m_members.empty(); }
+      void clear()
+      {
+        for (auto i: m_members)
+          m_isMember[i] = 0;
+        m_members.clear();
+      }
+      // the members, in increasing order once sorted
+      std::vector<Index> const & members() const { return m_members; }
+      void sort() { std::sort(m_members.begin(), m_members.end()); }
+      void swap(IndexSet & that) { m_isMember.swap(that.m_isMember); m_members.swap(that.m_members); }
+    private:
+      std::vector<char> m_isMember;
+      std::vector<Index> m_members;
   };
 
-  struct FGEdge {
-    FGVariableNodeWeakPtr variableNode;
-    FGFactorNodeWeakPtr factorNode;
-    dd::BddWrapper variableToFactorMessage;
-    dd::BddWrapper factorToVariableMessage;
-    FGVariableNodePtr getVariableNode()
+
+
+  dd::BddWrapper project(const dd::BddWrapper & factor, const dd::BddWrapper & cube)
+  {
+    return factor.existentialQuantification(factor.support().cubeDiff(cube));
+  }
+
+
+  // how much replacing a message with a new one counts towards
+  // re-running the node receiving it; always positive
+  double messageResidual(const dd::BddWrapper & oldMessage,
+                         const dd::BddWrapper & newMessage,
+                         fgpp::Schedule schedule)
+  {
+    if (schedule == fgpp::Schedule::ResidualMinterms)
     {
-      FGVariableNodePtr result = variableNode.lock();
-      if (!result) throw std::runtime_error("Invalid weak pointer in FGEdge::getVariableNode()");
-      return result;
+      // messages only shrink during convergence, so this is the
+      // fraction of the old minterms that were removed
+      DdManager * manager = oldMessage.getManager();
+      int numVars = Cudd_ReadSize(manager);
+      double logOld = bdd_log_count_minterm(manager, oldMessage.getUncountedBdd(), numVars);
+      double logNew = bdd_log_count_minterm(manager, newMessage.getUncountedBdd(), numVars);
+      double removed = 1.0 - std::exp2(logNew - logOld);
+      return std::max(removed, std::numeric_limits<double>::min());
+    }
+    int oldSize = Cudd_DagSize(oldMessage.getUncountedBdd());
+    int newSize = Cudd_DagSize(newMessage.getUncountedBdd());
+    return 1.0 + std::abs(newSize - oldSize);
+  }
+
+
+  // slots of the memo table of the and-abstracts computing messages;
+  // the computations are many and small, and on random graphs a table as
+  // large as the computed table was several times slower than a small one
+  const int MessageMultiCacheCapacity = 1 << 14;
+
+
+  // ***** MultiCacheScope *****
+  // While messages are computed by and-abstracts, gives the manager a
+  // persistent memo table for the multi operand operations (unless it
+  // already has one), so that the calls don't each allocate a table of
+  // their own, and the edges of a node share their common sub-results.
+  class MultiCacheScope
+  {
+    public:
+      MultiCacheScope(DdManager * manager, fgpp::MessageComputation messageComputation) : m_manager(NULL)
+      {
+        Cudd_MultiCacheStats stats;
+        if (manager != NULL
+            && messageComputation != fgpp::MessageComputation::Conjoin
+            && 0 == Cudd_MultiCacheReadStats(manager, &stats)
+            && 1 == Cudd_MultiCacheEnable(manager, MessageMultiCacheCapacity))
+          m_manager = manager;
+      }
+      ~MultiCacheScope()
+      {
+        if (m_manager != NULL)
+          Cudd_MultiCacheDisable(m_manager);
+      }
+      MultiCacheScope(MultiCacheScope const &) = delete;
+      MultiCacheScope & operator=(MultiCacheScope const &) = delete;
+    private:
+      DdManager * m_manager;
+  };
+
+
+  // the conjunction of the operands projected on cube, in one pass of
+  // the multi-operand and-abstract engine, support being the union of
+  // the supports of the operands
+  dd::BddWrapper andAbstract(DdManager * manager,
+                             const bdd_ptr_set & operands,
+                             const dd::BddWrapper & support,
+                             const dd::BddWrapper & cube)
+  {
+    dd::BddWrapper quantified = support.cubeDiff(cube);
+    return dd::BddWrapper(bdd_and_exists_multi(manager, operands, quantified.getUncountedBdd(), MessageMultiCacheCapacity), manager);
+  }
+
+
+  // appends the projections of f on cubes[first, last) to result,
+  // halving the range at every step
+  void splitProjections(const dd::BddWrapper & f,
+                        const std::vector<dd::BddWrapper> & cubes,
+                        size_t first,
+                        size_t last,
+                        std::vector<dd::BddWrapper> & result)
+  {
+    if (last - first == 1)
+    {
+      result.push_back(project(f, cubes[first]));
+      return;
     }
-    FGFactorNodePtr getFactorNode()
+    size_t middle = first + (last - first) / 2;
+    for (auto range: { std::make_pair(first, middle), std::make_pair(middle, last) })
     {
-      FGFactorNodePtr result = factorNode.lock();
-      if (!result) throw std::runtime_error("Invalid weak pointer in FGEdge::getFactorNode()");
+      dd::BddWrapper cube = f.one();
+      for (size_t i = range.first; i < range.second; ++i)
+        cube = std::move(cube).cubeUnion(cubes[i]);
+      splitProjections(project(f, cube), cubes, range.first, range.second, result);
+    }
+  }
+
+
+  // conjoins the conjuncts and projects the result on each of the cubes
+  std::vector<dd::BddWrapper> outgoingMessages(DdManager * manager,
+                                               std::vector<dd::BddWrapper> conjuncts,
+                                               const std::vector<dd::BddWrapper> & cubes,
+                                               fgpp::MessageComputation messageComputation)
+  {
+    std::vector<dd::BddWrapper> result;
+    result.reserve(cubes.size());
+    if (messageComputation == fgpp::MessageComputation::Conjoin)
+    {
+      dd::BddWrapper message = dd::conjoinAll(manager, std::move(conjuncts));
+      for (const auto & cube: cubes)
+        result.push_back(project(message, cube));
       return result;
     }
-    FGEdge(const FGVariableNodePtr & variableNode, const FGFactorNodePtr & factorNode);
-  };
 
-  struct FGVariableNode : public FGNode {
-    FGVariableNode(const dd::BddWrapper & v_nodeBdd): FGNode(v_nodeBdd) {}
-    virtual void passMessages(FGNodePtrSet & updatedNodes) override;
-  };
+    bdd_ptr_set operands;
+    dd::BddWrapper support(bdd_one(manager), manager);
+    for (const auto & conjunct: conjuncts)
+    {
+      operands.insert(conjunct.getUncountedBdd());
+      support = std::move(support).cubeUnion(conjunct.support());
+    }
 
-  struct FGFactorNode : public FGNode {
-    FGFactorNode(const dd::BddWrapper & v_nodeBdd): FGNode(v_nodeBdd), supportBdd(v_nodeBdd.support()) {}
-    virtual void passMessages(FGNodePtrSet & updatedNodes) override;
-    dd::BddWrapper supportBdd;
-  };
+    // the variables kept by each message; edges keeping the same
+    // variables (e.g. all the edges of a variable node) get the
+    // same message, which is computed once
+    std::vector<dd::BddWrapper> kept;
+    std::vector<size_t> keptOf;
+    std::unordered_map<bdd_ptr, size_t> keptIndex;
+    keptOf.reserve(cubes.size());
+    for (const auto & cube: cubes)
+    {
+      dd::BddWrapper k = support.cubeIntersection(cube);
+      auto kit = keptIndex.emplace(k.getUncountedBdd(), kept.size()).first;
+      if (kit->second == kept.size())
+        kept.push_back(std::move(k));
+      keptOf.push_back(kit->second);
+    }
 
+    std::vector<dd::BddWrapper> projections;
+    projections.reserve(kept.size());
+    if (messageComputation == fgpp::MessageComputation::AndAbstract || kept.size() < 2)
+    {
+      for (const auto & k: kept)
+        projections.push_back(andAbstract(manager, operands, support, k));
+    }
+    else
+    {
+      // and-abstract onto each half of the kept variables, then split
+      // the two (smaller) projections further with plain quantification
+      size_t middle = kept.size() / 2;
+      for (auto range: { std::make_pair(size_t(0), middle), std::make_pair(middle, kept.size()) })
+      {
+        dd::BddWrapper cube(bdd_one(manager), manager);
+        for (size_t i = range.first; i < range.second; ++i)
+          cube = std::move(cube).cubeUnion(kept[i]);
+        splitProjections(andAbstract(manager, operands, support, cube), kept, range.first, range.second, projections);
+      }
+    }
 
-  dd::BddWrapper project(const dd::BddWrapper & factor, const dd::BddWrapper & cube)
-  {
-    return factor.existentialQuantification(factor.support().cubeDiff(cube));
+    for (auto k: keptOf)
+      result.push_back(projections[k]);
+    return result;
   }
 
 
+
+  // ***** FactorGraphImpl *****
+  // Compressed sparse row storage: nodes and edges live in contiguous
+  // arrays and refer to each other by index, and the messages are kept
+  // in arrays parallel to the edges.
+  // Edges are sorted by factor and then by variable, so the edges of a
+  // factor are a contiguous range of edge indices; the edges of a
+  // variable are listed, in edge order, in a second offset array.
+  // Grouping compacts the arrays, keeping the relative order of the
+  // nodes that remain and appending the new node at the end, so that
+  // the order in which nodes are processed never depends on addresses.
   class FactorGraphImpl: public fgpp::FactorGraph
   {
     public:
@@ -101,151 +278,588 @@ namespace {
       void groupVariables(const BddWrapper & variableCube) override;
       std::vector<BddWrapper> getIncomingMessages(const BddWrapper & variableCube) const override;
       int converge() override;
+      int convergeParallel(int numThreads, const dd::ManagerOptions & managerOptions) override;
+      long long convergeScheduled(fgpp::Schedule schedule, long long maxUpdates) override;
+      long long convergeIncremental() override;
+      void setMessageComputation(fgpp::MessageComputation messageComputation) override;
 
       static void test(DdManager *);
 
     private:
-      FGEdgePtrSet m_edges;
-      FGNodePtrSet m_factorNodes;
-      FGNodePtrSet m_variableNodes;
+      // Cudd_bddTransfer, used by convergeParallel to move bdds between
+      // the managers, and replaced by the tests to make a transfer fail
+      static DdNode * (*s_bddTransfer)(DdManager *, DdManager *, DdNode *);
+
+      // an edge while the arrays are being rebuilt
+      struct EdgeEntry {
+        Index factor;
+        Index variable;
+        BddWrapper variableToFactorMessage;
+        BddWrapper factorToVariableMessage;
+      };
+
+      size_t numFactors() const { return m_factorBdds.size(); }
+      size_t numVariables() const { return m_variableCubes.size(); }
+      size_t numNodes() const { return numFactors() + numVariables(); }
+      size_t numEdges() const { return m_edgeFactors.size(); }
+      bool isFactor(Index node) const { return node < numFactors(); }
+      Index variableNode(Index variable) const { return Index(numFactors() + variable); }
+
+      // calls func(edge) for every edge of the node, in edge order
+      template <typename TFunc>
+        void forEachEdge(Index node, TFunc && func) const
+        {
+          if (isFactor(node))
+          {
+            for (Index e = m_factorOffsets[node]; e < m_factorOffsets[node + 1]; ++e)
+              func(e);
+          }
+          else
+          {
+            Index v = Index(node - numFactors());
+            for (Index i = m_variableOffsets[v]; i < m_variableOffsets[v + 1]; ++i)
+              func(m_variableEdges[i]);
+          }
+        }
+      std::vector<Index> edgesOf(Index node) const;
+
+      // The bdds the outgoing messages of a node are computed from: the
+      // conjuncts of its message, and for each edge (in edge order) the
+      // cube it is projected on before being sent along the edge.
+      // The bdds are not referenced, and nothing is written, so other
+      // threads may call this while the graph is not being modified.
+      void messageInputs(Index node, std::vector<bdd_ptr> & conjuncts, std::vector<bdd_ptr> & cubes) const;
+      // the outgoing messages of a node, one per edge in edge order
+      std::vector<BddWrapper> computeMessages(Index node) const;
+      // the message a node sends along one of its edges
+      BddWrapper & outgoingMessage(Index node, Index edge)
+      {
+        return isFactor(node) ? m_factorToVariable[edge] : m_variableToFactor[edge];
+      }
+      // the node at the other end of one of the edges of a node
+      Index neighbour(Index node, Index edge) const
+      {
+        return isFactor(node) ? variableNode(m_edgeVariables[edge]) : m_edgeFactors[edge];
+      }
+      // Stores the outgoing messages of a node (one per edge, in edge order),
+      // adding the node at the other end of every changed edge to updatedNodes.
+      void updateMessages(Index node, std::vector<BddWrapper> messages, IndexSet & updatedNodes);
+      void passMessages(Index node, IndexSet & updatedNodes);
+
+      void resetMessages();
+      // replaces all the edges, sorting them and rebuilding the offsets
+      void setEdges(std::vector<EdgeEntry> edges);
+
+      // factor nodes
+      std::vector<BddWrapper> m_factorBdds;
+      std::vector<BddWrapper> m_factorSupports;
+      // variable nodes
+      std::vector<BddWrapper> m_variableCubes;
+      std::vector<dd::VarSet> m_variableVars;   // the variables in each cube
+      // edges, the edges of factor f being [m_factorOffsets[f], m_factorOffsets[f + 1])
+      std::vector<Index> m_edgeFactors;
+      std::vector<Index> m_edgeVariables;
+      std::vector<Index> m_factorOffsets;
+      // the edges of variable v are m_variableEdges[m_variableOffsets[v] .. m_variableOffsets[v + 1])
+      std::vector<Index> m_variableEdges;
+      std::vector<Index> m_variableOffsets;
+      // messages, by edge
+      std::vector<BddWrapper> m_variableToFactor;
+      std::vector<BddWrapper> m_factorToVariable;
+      // by node, whether its incoming messages changed since it was last
+      // run, or it was created or re-connected by grouping
+      std::vector<char> m_isPending;
+      fgpp::MessageComputation m_messageComputation;
 
   };
 
 
 
 
-  FGEdge::FGEdge(const FGVariableNodePtr & v_variableNode, const FGFactorNodePtr & v_factorNode):
-    variableNode(v_variableNode),
-    factorNode(v_factorNode),
-    variableToFactorMessage(v_variableNode->nodeBdd.one()),
-    factorToVariableMessage(v_variableNode->nodeBdd.one())
-  { }
+  DdNode * (*FactorGraphImpl::s_bddTransfer)(DdManager *, DdManager *, DdNode *) = Cudd_bddTransfer;
 
 
 
+  FactorGraphImpl::FactorGraphImpl(const std::vector<BddWrapper> & factors) :
+    m_messageComputation(fgpp::MessageComputation::Conjoin)
+  {
+    m_factorOffsets.push_back(0);
+    m_variableOffsets.push_back(0);
+    if (factors.empty())
+      return;
+
+    DdManager * manager = factors.front().getManager();
+    BddWrapper one = factors.front().one();
+    std::map<int, Index> varIndexToVariable;
+    std::vector<EdgeEntry> edges;
+    // for each factor
+    for (const auto & factor: factors)
+    {
+      // create a factor node
+      Index f = Index(m_factorBdds.size());
+      m_factorBdds.push_back(factor);
+      m_factorSupports.push_back(factor.support());
+      // for each var in factor
+      for (auto index: dd::supportIndices(manager, factor.getUncountedBdd()))
+      {
+        auto vit = varIndexToVariable.find(index);
+        if (vit == varIndexToVariable.end())
+        {
+          // if var node doesn't already exist, create it
+          BddWrapper v(bdd_new_var_with_index(manager, index), manager);
+          m_variableVars.push_back(dd::VarSet::fromCube(manager, v.getUncountedBdd()));
+          m_variableCubes.push_back(std::move(v));
+          vit = varIndexToVariable.insert(std::make_pair(index, Index(m_variableCubes.size() - 1))).first;
+        }
+        // create an edge
+        edges.push_back(EdgeEntry{f, vit->second, one, one});
+      }
+    }
+    setEdges(std::move(edges));
+    m_isPending.assign(numNodes(), 0);
+    std::fill(m_isPending.begin(), m_isPending.begin() + numFactors(), 1);
+  }
 
 
 
-  void FGVariableNode::passMessages(FGNodePtrSet & updatedNodes)
+  void FactorGraphImpl::setEdges(std::vector<EdgeEntry> edges)
   {
-    using namespace dd;
-    // compute message
-    BddWrapper message =  nodeBdd.one();
-    for (const auto & edge: edges)
-      message = message * edge->factorToVariableMessage;
-
-    // update message for each edge
-    for (const auto & edge: edges)
+    std::stable_sort(edges.begin(), edges.end(), [](const EdgeEntry & a, const EdgeEntry & b) {
+      return a.factor != b.factor ? a.factor < b.factor : a.variable < b.variable;
+    });
+
+    m_edgeFactors.clear();
+    m_edgeVariables.clear();
+    m_variableToFactor.clear();
+    m_factorToVariable.clear();
+    m_edgeFactors.reserve(edges.size());
+    m_edgeVariables.reserve(edges.size());
+    m_variableToFactor.reserve(edges.size());
+    m_factorToVariable.reserve(edges.size());
+    for (auto & edge: edges)
     {
-      // project the message
-      FGFactorNodePtr factorNode = edge->getFactorNode();
-      BddWrapper factorMessage = project(message, factorNode->supportBdd);
+      m_edgeFactors.push_back(edge.factor);
+      m_edgeVariables.push_back(edge.variable);
+      m_variableToFactor.push_back(std::move(edge.variableToFactorMessage));
+      m_factorToVariable.push_back(std::move(edge.factorToVariableMessage));
+    }
+
+    // factor offsets
+    m_factorOffsets.assign(numFactors() + 1, 0);
+    for (auto f: m_edgeFactors)
+      ++m_factorOffsets[f + 1];
+    for (size_t f = 0; f < numFactors(); ++f)
+      m_factorOffsets[f + 1] += m_factorOffsets[f];
+
+    // variable offsets, and the edges of each variable in edge order
+    m_variableOffsets.assign(numVariables() + 1, 0);
+    for (auto v: m_edgeVariables)
+      ++m_variableOffsets[v + 1];
+    for (size_t v = 0; v < numVariables(); ++v)
+      m_variableOffsets[v + 1] += m_variableOffsets[v];
+    m_variableEdges.resize(numEdges());
+    std::vector<Index> next(m_variableOffsets.cbegin(), m_variableOffsets.cend() - 1);
+    for (Index e = 0; e < numEdges(); ++e)
+      m_variableEdges[next[m_edgeVariables[e]]++] = e;
+  }
 
-      
-      // if message is already updated, skip
-      if (edge->variableToFactorMessage == factorMessage)
-        continue;
 
-      // update the message
-      edge->variableToFactorMessage = factorMessage;
-      updatedNodes.insert(factorNode);
-    }
 
+  std::vector<Index> FactorGraphImpl::edgesOf(Index node) const
+  {
+    std::vector<Index> result;
+    forEachEdge(node, [&](Index e) { result.push_back(e); });
+    return result;
   }
 
 
 
-  void FGFactorNode::passMessages(FGNodePtrSet & updatedNodes)
+  void FactorGraphImpl::setMessageComputation(fgpp::MessageComputation messageComputation)
   {
-    using namespace dd;
-    // compute conjoined message
-    BddWrapper conjoined = nodeBdd;
-    for (const auto & edge: edges)
-      conjoined = conjoined * edge->variableToFactorMessage;
+    m_messageComputation = messageComputation;
+  }
+
 
-    // update message for each edge
-    for (const auto & edge: edges)
+
+  void FactorGraphImpl::messageInputs(Index node, std::vector<bdd_ptr> & conjuncts, std::vector<bdd_ptr> & cubes) const
+  {
+    if (isFactor(node))
     {
-      // project the message
-      FGVariableNodePtr variableNode = edge->getVariableNode();
-      BddWrapper variableMessage = project(conjoined, variableNode->nodeBdd);
+      // the message is the factor conjoined with the incoming messages,
+      // projected on each neighbouring variable node
+      conjuncts.push_back(m_factorBdds[node].getUncountedBdd());
+      forEachEdge(node, [&](Index e) {
+        conjuncts.push_back(m_variableToFactor[e].getUncountedBdd());
+        cubes.push_back(m_variableCubes[m_edgeVariables[e]].getUncountedBdd());
+      });
+    }
+    else
+    {
+      // the message is the conjunction of the incoming messages,
+      // projected on the support of each neighbouring factor
+      forEachEdge(node, [&](Index e) {
+        conjuncts.push_back(m_factorToVariable[e].getUncountedBdd());
+        cubes.push_back(m_factorSupports[m_edgeFactors[e]].getUncountedBdd());
+      });
+    }
+  }
+
+
+
+  std::vector<dd::BddWrapper> FactorGraphImpl::computeMessages(Index node) const
+  {
+    using namespace dd;
+    DdManager * manager = m_factorBdds.front().getManager();
+    std::vector<bdd_ptr> conjuncts, cubes;
+    messageInputs(node, conjuncts, cubes);
+    std::vector<BddWrapper> conjunctWrappers, cubeWrappers;
+    conjunctWrappers.reserve(conjuncts.size());
+    for (auto conjunct: conjuncts)
+      conjunctWrappers.emplace_back(bdd_dup(conjunct), manager);
+    cubeWrappers.reserve(cubes.size());
+    for (auto cube: cubes)
+      cubeWrappers.emplace_back(bdd_dup(cube), manager);
+    return outgoingMessages(manager, std::move(conjunctWrappers), cubeWrappers, m_messageComputation);
+  }
+
+
+
+  void FactorGraphImpl::updateMessages(Index node, std::vector<dd::BddWrapper> messages, IndexSet & updatedNodes)
+  {
+    auto mit = messages.begin();
+    forEachEdge(node, [&](Index e) {
+      assert(mit != messages.end());
+      auto & message = *(mit++);
+      auto & current = outgoingMessage(node, e);
 
       // if message is already updated, skip
-      if (edge->factorToVariableMessage == variableMessage)
-        continue;
+      if (current == message)
+        return;
 
       // update the message
-      edge->factorToVariableMessage = variableMessage;
-      updatedNodes.insert(variableNode);
+      current = std::move(message);
+      updatedNodes.insert(neighbour(node, e));
+    });
+    assert(mit == messages.end());
+  }
+
+
+
+  void FactorGraphImpl::passMessages(Index node, IndexSet & updatedNodes)
+  {
+    updateMessages(node, computeMessages(node), updatedNodes);
+  }
+
+
+
+  void FactorGraphImpl::resetMessages()
+  {
+    auto one = m_factorBdds.front().one();
+    std::fill(m_variableToFactor.begin(), m_variableToFactor.end(), one);
+    std::fill(m_factorToVariable.begin(), m_factorToVariable.end(), one);
+  }
+
+
+
+  int FactorGraphImpl::converge()
+  {
+    // reset all messages
+    if (m_factorBdds.empty()) return 0;
+    resetMessages();
+    MultiCacheScope multiCacheScope(m_factorBdds.front().getManager(), m_messageComputation);
+
+    // set up factor nodes for message passing
+    IndexSet pendingSet(numNodes()), updatedNodes(numNodes());
+    for (Index f = 0; f < numFactors(); ++f)
+      pendingSet.insert(f);
+    
+    // pass messages and collect nodes for next iteration
+    int numIterations = 0;
+    while(!pendingSet.empty())
+    {
+      ++numIterations;
+      updatedNodes.clear();
+      pendingSet.sort();
+      for (auto node: pendingSet.members())
+        passMessages(node, updatedNodes);
+
+      pendingSet.swap(updatedNodes);
     }
+
+    std::fill(m_isPending.begin(), m_isPending.end(), 0);
+    return numIterations;
   }
 
 
 
-  FactorGraphImpl::FactorGraphImpl(const std::vector<BddWrapper> & factors)
+  long long FactorGraphImpl::convergeScheduled(fgpp::Schedule schedule, long long maxUpdates)
   {
-    if (factors.empty())
-      return;
+    if (m_factorBdds.empty()) return 0;
+    resetMessages();
+    MultiCacheScope multiCacheScope(m_factorBdds.front().getManager(), m_messageComputation);
+    long long numUpdates = 0;
+    auto mustStop = [&]() { return maxUpdates > 0 && numUpdates >= maxUpdates; };
 
-    std::map<bdd_ptr, FGVariableNodePtr> varNodeMap;
-    // for each factor
-    for (const auto & factor: factors)
+    if (schedule == fgpp::Schedule::Flood)
     {
-      // create a factor node
-      FGFactorNodePtr fnode = std::make_shared<FGFactorNode>(factor);
-      m_factorNodes.insert(fnode);
-      BddWrapper fsup = fnode->supportBdd;
-      // for each var in factor
-      while(!fsup.isOne())
+      IndexSet pendingSet(numNodes()), updatedNodes(numNodes());
+      for (Index f = 0; f < numFactors(); ++f)
+        pendingSet.insert(f);
+      while (!pendingSet.empty() && !mustStop())
       {
-        auto v = fsup.varWithLowestIndex();
-        fsup = fsup.cubeDiff(v);
-        auto vnmit = varNodeMap.find(v.getUncountedBdd());
-        if (vnmit == varNodeMap.end())
+        updatedNodes.clear();
+        pendingSet.sort();
+        auto const & members = pendingSet.members();
+        auto nit = members.cbegin();
+        for (; nit != members.cend() && !mustStop(); ++nit)
         {
-          // if var node doesn't already exist, create it
-          auto new_vn = std::make_shared<FGVariableNode>(v);
-          m_variableNodes.insert(new_vn);
-          vnmit = varNodeMap.insert(std::make_pair(v.getUncountedBdd(), new_vn)).first;
+          passMessages(*nit, updatedNodes);
+          ++numUpdates;
         }
-        // create an edge
-        auto vnode = vnmit->second;
-        FGEdgePtr edge = std::make_shared<FGEdge>(vnode, fnode);
-        m_edges.insert(edge);
-        vnode->edges.insert(edge);
-        fnode->edges.insert(edge);
+        // nodes not run when stopping early stay pending
+        for (; nit != members.cend(); ++nit)
+          updatedNodes.insert(*nit);
+        pendingSet.swap(updatedNodes);
       }
+      std::fill(m_isPending.begin(), m_isPending.end(), 0);
+      for (auto node: pendingSet.members())
+        m_isPending[node] = 1;
+      return numUpdates;
     }
+
+    // max-heap on the summed residuals of the messages that changed since
+    // a node was last run (summing re-runs a node once for several changes
+    // more readily than taking the largest); stale entries are skipped when
+    // popped, and a node is pending iff its residual is positive
+    typedef std::pair<double, Index> ResidualAndNode;
+    std::priority_queue<ResidualAndNode> heap;
+    std::vector<double> pendingResidual(numNodes(), 0);
+    for (Index f = 0; f < numFactors(); ++f)
+    {
+      pendingResidual[f] = std::numeric_limits<double>::infinity();
+      heap.push(ResidualAndNode(std::numeric_limits<double>::infinity(), f));
+    }
+
+    while (!heap.empty() && !mustStop())
+    {
+      auto top = heap.top();
+      heap.pop();
+      Index node = top.second;
+      if (pendingResidual[node] <= 0 || pendingResidual[node] != top.first)
+        continue;
+      pendingResidual[node] = 0;
+
+      auto messages = computeMessages(node);
+      ++numUpdates;
+      auto mit = messages.begin();
+      forEachEdge(node, [&](Index e) {
+        auto & message = *(mit++);
+        auto & current = outgoingMessage(node, e);
+        if (current == message)
+          return;
+        double residual = messageResidual(current, message, schedule);
+        current = std::move(message);
+        Index receiver = neighbour(node, e);
+        pendingResidual[receiver] += residual;
+        heap.push(ResidualAndNode(pendingResidual[receiver], receiver));
+      });
+    }
+
+    // nodes not run when stopping early stay pending
+    for (size_t node = 0; node < numNodes(); ++node)
+      m_isPending[node] = pendingResidual[node] > 0 ? 1 : 0;
+    return numUpdates;
   }
 
 
 
-  int FactorGraphImpl::converge()
+  // Messages are only ever replaced by conjunctions and projections of
+  // other messages and factors, so they remain over-approximations when
+  // the graph is regrouped (grouping doesn't change the conjunction of
+  // the factors). Starting below the all-ones messages of converge(),
+  // the fixpoint reached is at least as tight as converge()'s.
+  long long FactorGraphImpl::convergeIncremental()
   {
-    // reset all messages
-    if (m_factorNodes.empty()) return 0;
-    auto one = (*m_factorNodes.cbegin())->nodeBdd.one();
-    for (const auto & edge: m_edges)
+    IndexSet pendingSet(numNodes()), updatedNodes(numNodes());
+    for (size_t node = 0; node < numNodes(); ++node)
+      if (m_isPending[node])
+        pendingSet.insert(Index(node));
+    std::fill(m_isPending.begin(), m_isPending.end(), 0);
+    MultiCacheScope multiCacheScope(m_factorBdds.empty() ? NULL : m_factorBdds.front().getManager(), m_messageComputation);
+
+    long long numUpdates = 0;
+    while(!pendingSet.empty())
     {
-      edge->variableToFactorMessage = one;
-      edge->factorToVariableMessage = one;
+      updatedNodes.clear();
+      pendingSet.sort();
+      for (auto node: pendingSet.members())
+      {
+        passMessages(node, updatedNodes);
+        ++numUpdates;
+      }
+      pendingSet.swap(updatedNodes);
     }
+    return numUpdates;
+  }
+
+
+
+  // Within an iteration the pending nodes are either all factor nodes or
+  // all variable nodes, so they only read the messages written in the
+  // previous iteration, and can be processed in any order (Jacobi style).
+  // Each node is always handled by the same worker, which keeps its own
+  // copies of the bdds that don't change during convergence (factors,
+  // supports and variable cubes). Only the main thread touches the
+  // graph's manager, apart from the workers reading it in Cudd_bddTransfer
+  // while the main thread waits.
+  int FactorGraphImpl::convergeParallel(int numThreads, const dd::ManagerOptions & managerOptions)
+  {
+    if (numThreads <= 1)
+      return converge();
+    if (m_factorBdds.empty()) return 0;
+    resetMessages();
+    DdManager * mainManager = m_factorBdds.front().getManager();
+
+    // Each worker owns its manager: the destructor releases the bdds, then
+    // the caches, then quits the manager, so the workers are released
+    // even if a transfer throws. Declared before the pool, which is joined
+    // before the workers go away.
+    struct Worker {
+      DdManager * const manager;
+      std::unique_ptr<dd::SupportCacheScope> supportCacheScope;
+      std::unique_ptr<MultiCacheScope> multiCacheScope;
+      std::unordered_map<bdd_ptr, BddWrapper> fixedBdds; // copies of the bdds fixed during convergence
+      std::vector<Index> nodes;                          // pending nodes for the iteration
+      std::vector<std::vector<BddWrapper> > messages;    // their outgoing messages
+      Worker(const dd::ManagerOptions & options, const std::vector<int> & variableOrder, fgpp::MessageComputation messageComputation) :
+        manager(dd::createManager(options))
+      {
+        try {
+          dd::applyVariableOrder(manager, variableOrder);
+          supportCacheScope = std::make_unique<dd::SupportCacheScope>(manager);
+          multiCacheScope = std::make_unique<MultiCacheScope>(manager, messageComputation);
+        } catch (...) {
+          supportCacheScope.reset();
+          Cudd_Quit(manager);
+          throw;
+        }
+      }
+      ~Worker()
+      {
+        messages.clear();
+        fixedBdds.clear();
+        multiCacheScope.reset();
+        supportCacheScope.reset();
+        Cudd_Quit(manager);
+      }
+      Worker(const Worker &) = delete;
+      Worker & operator=(const Worker &) = delete;
+      BddWrapper transfer(bdd_ptr f, DdManager * source)
+      {
+        bdd_ptr copy = s_bddTransfer(source, manager, f);
+        if (copy == NULL)
+          throw std::runtime_error("Could not transfer a bdd to a factor graph worker");
+        Cudd_Ref(copy);
+        return BddWrapper(copy, manager);
+      }
+      const BddWrapper & transferFixed(bdd_ptr f, DdManager * source)
+      {
+        auto fit = fixedBdds.find(f);
+        if (fit == fixedBdds.end())
+          fit = fixedBdds.emplace(f, transfer(f, source)).first;
+        return fit->second;
+      }
+    };
+    std::vector<std::unique_ptr<Worker> > workers;
+    size_t numWorkers = std::min<size_t>(size_t(numThreads), numNodes());
+    auto variableOrder = dd::currentVariableOrder(mainManager);
+    // the workers only hold messages, so they are sized as small
+    // problems, and share the memory limit between them
+    dd::ManagerOptions workerOptions = managerOptions;
+    workerOptions.numVariables = 0;
+    workerOptions.numFactors = 0;
+    workerOptions.maxMemory = managerOptions.maxMemory / numWorkers;
+    for (size_t i = 0; i < numWorkers; ++i)
+      workers.push_back(std::make_unique<Worker>(workerOptions, variableOrder, m_messageComputation));
+
+    // round robin, separately for the two kinds of nodes since
+    // they are never pending in the same iteration
+    auto workerOf = [&](Index node) {
+      return (isFactor(node) ? node : node - numFactors()) % workers.size();
+    };
 
     // set up factor nodes for message passing
-    FGNodePtrSet pendingSet(m_factorNodes.cbegin(), m_factorNodes.cend());
-    
-    // pass messages and collect nodes for next iteration
+    IndexSet pendingSet(numNodes()), updatedNodes(numNodes());
+    for (Index f = 0; f < numFactors(); ++f)
+      pendingSet.insert(f);
     int numIterations = 0;
-    while(!pendingSet.empty())
     {
-      ++numIterations;
-      FGNodePtrSet updatedNodes;
-      for (const auto & node: pendingSet)
-        node->passMessages(updatedNodes);
+      parakram::ThreadPool pool(static_cast<int>(workers.size()));
+      while(!pendingSet.empty())
+      {
+        ++numIterations;
+        pendingSet.sort();
+        bool isFactorIteration = isFactor(pendingSet.members().front());
+        for (auto node: pendingSet.members())
+          workers[workerOf(node)]->nodes.push_back(node);
+
+        // compute the messages in the workers
+        std::vector<std::future<void> > done;
+        for (auto & worker: workers)
+        {
+          if (worker->nodes.empty())
+            continue;
+          done.push_back(pool.submit([&, w = worker.get()]() {
+            std::vector<bdd_ptr> conjuncts, cubes;
+            for (auto node: w->nodes)
+            {
+              conjuncts.clear();
+              cubes.clear();
+              messageInputs(node, conjuncts, cubes);
+              // a factor node's own bdd comes first, the rest are messages
+              std::vector<BddWrapper> conjunctCopies, cubeCopies;
+              conjunctCopies.reserve(conjuncts.size());
+              for (size_t i = 0; i < conjuncts.size(); ++i)
+                conjunctCopies.push_back(isFactorIteration && i == 0
+                                         ? w->transferFixed(conjuncts[i], mainManager)
+                                         : w->transfer(conjuncts[i], mainManager));
+              cubeCopies.reserve(cubes.size());
+              for (auto cube: cubes)
+                cubeCopies.push_back(w->transferFixed(cube, mainManager));
+              w->messages.push_back(outgoingMessages(w->manager, std::move(conjunctCopies), cubeCopies, m_messageComputation));
+            }
+          }));
+        }
+        for (auto & d: done)
+          d.get();
 
-      pendingSet.swap(updatedNodes);
+        // barrier: bring the messages back and collect the nodes for the next iteration
+        updatedNodes.clear();
+        for (auto & worker: workers)
+        {
+          for (size_t i = 0; i < worker->nodes.size(); ++i)
+          {
+            std::vector<BddWrapper> messages;
+            messages.reserve(worker->messages[i].size());
+            for (const auto & message: worker->messages[i])
+            {
+              bdd_ptr copy = s_bddTransfer(worker->manager, mainManager, message.getUncountedBdd());
+              if (copy == NULL)
+                throw std::runtime_error("Could not transfer a factor graph message back from a worker");
+              Cudd_Ref(copy);
+              messages.emplace_back(copy, mainManager);
+            }
+            updateMessages(worker->nodes[i], std::move(messages), updatedNodes);
+          }
+          worker->nodes.clear();
+          worker->messages.clear();
+        }
+
+        pendingSet.swap(updatedNodes);
+      }
     }
 
+    std::fill(m_isPending.begin(), m_isPending.end(), 0);
     return numIterations;
   }
 
@@ -255,13 +869,13 @@ namespace {
   std::vector<dd::BddWrapper> FactorGraphImpl::getIncomingMessages(const BddWrapper & variableCube) const
   {
     std::vector<BddWrapper> result;
-    result.reserve(m_edges.size());
-    for (const auto & vnode: m_variableNodes)
+    result.reserve(numEdges());
+    auto cubeVars = dd::VarSet::fromCube(variableCube.getManager(), variableCube.getUncountedBdd());
+    for (Index v = 0; v < numVariables(); ++v)
     {
-      if (vnode->nodeBdd.cubeIntersection(variableCube).isOne())
+      if (!m_variableVars[v].intersects(cubeVars))
         continue;
-      for (const auto & e: vnode->edges)
-        result.push_back(e->factorToVariableMessage);
+      forEachEdge(variableNode(v), [&](Index e) { result.push_back(m_factorToVariable[e]); });
     }
     return result;
   }
@@ -275,35 +889,56 @@ namespace {
     if (factors.empty())
       throw std::invalid_argument("FactorGraph::groupFactors must be called with at least one factor.");
     std::set<BddWrapper> factorSet(factors.cbegin(), factors.cend());
-    FGFactorNodePtr new_fnode = std::make_shared<FGFactorNode>(factors.cbegin()->one());
-    FGNodePtrSet neighbors;
-    for (auto fit = m_factorNodes.begin(); fit != m_factorNodes.end();)
+    DdManager * manager = factors.cbegin()->getManager();
+    BddWrapper one = factors.cbegin()->one();
+
+    // compact the factors that remain, the new factor goes last
+    std::vector<BddWrapper> grouped;
+    std::vector<Index> newIndex(numFactors());
+    std::vector<BddWrapper> factorBdds, factorSupports;
+    std::vector<char> isPending;
+    for (Index f = 0; f < numFactors(); ++f)
     {
-      FGNodePtr old_fnode = *fit;
-      if (factorSet.count(old_fnode->nodeBdd) == 0)
+      if (factorSet.count(m_factorBdds[f]) > 0)
       {
-        ++fit;
+        grouped.push_back(m_factorBdds[f]);
+        newIndex[f] = std::numeric_limits<Index>::max();
         continue;
       }
-
-      new_fnode->nodeBdd = new_fnode->nodeBdd * old_fnode->nodeBdd;
-      for (const auto & old_edge: old_fnode->edges)
+      newIndex[f] = Index(factorBdds.size());
+      factorBdds.push_back(std::move(m_factorBdds[f]));
+      factorSupports.push_back(std::move(m_factorSupports[f]));
+      isPending.push_back(m_isPending[f]);
+    }
+    Index newFactor = Index(factorBdds.size());
+    factorBdds.push_back(dd::conjoinAll(manager, std::move(grouped)));
+    factorSupports.push_back(factorBdds.back().support());
+    isPending.push_back(1);
+
+    // the edges of the grouped factors are replaced by one edge per neighbour
+    std::vector<EdgeEntry> edges;
+    edges.reserve(numEdges());
+    std::vector<char> isNeighbour(numVariables(), 0);
+    for (Index e = 0; e < numEdges(); ++e)
+    {
+      Index f = newIndex[m_edgeFactors[e]];
+      Index v = m_edgeVariables[e];
+      if (f != std::numeric_limits<Index>::max())
+        edges.push_back(EdgeEntry{f, v, std::move(m_variableToFactor[e]), std::move(m_factorToVariable[e])});
+      else if (!isNeighbour[v])
       {
-        const auto & old_vnode = old_edge->getVariableNode();
-        m_edges.erase(old_edge);
-        old_vnode->edges.erase(old_edge);
-        if (neighbors.count(old_vnode))
-          continue;
-        neighbors.insert(old_vnode);
-        FGEdgePtr new_edge = std::make_shared<FGEdge>(old_vnode, new_fnode);
-        m_edges.insert(new_edge);
-        old_vnode->edges.insert(new_edge);
-        new_fnode->edges.insert(new_edge);
+        isNeighbour[v] = 1;
+        edges.push_back(EdgeEntry{newFactor, v, one, one});
       }
-      fit = m_factorNodes.erase(fit);
     }
-    m_factorNodes.insert(new_fnode);
-    return new_fnode->nodeBdd;
+    for (Index v = 0; v < numVariables(); ++v)
+      isPending.push_back(m_isPending[variableNode(v)] || isNeighbour[v] ? 1 : 0);
+
+    m_factorBdds.swap(factorBdds);
+    m_factorSupports.swap(factorSupports);
+    m_isPending.swap(isPending);
+    setEdges(std::move(edges));
+    return m_factorBdds.back();
   }
 
 
@@ -312,36 +947,58 @@ namespace {
 
   void FactorGraphImpl::groupVariables(const BddWrapper & variableCube)
   {
-    if (m_variableNodes.empty())
+    if (m_variableCubes.empty())
       return;
-    FGVariableNodePtr new_vnode = std::make_shared<FGVariableNode>((*m_variableNodes.cbegin())->nodeBdd.one());
-    FGNodePtrSet neighbors;
-    for (auto vit = m_variableNodes.begin(); vit != m_variableNodes.end();)
+    DdManager * manager = variableCube.getManager();
+    BddWrapper one = variableCube.one();
+    auto cubeVars = dd::VarSet::fromCube(manager, variableCube.getUncountedBdd());
+
+    // compact the variables that remain, the new variable goes last
+    dd::VarSet newVars;
+    std::vector<Index> newIndex(numVariables());
+    std::vector<BddWrapper> variableCubes;
+    std::vector<dd::VarSet> variableVars;
+    std::vector<char> isPending(m_isPending.cbegin(), m_isPending.cbegin() + numFactors());
+    for (Index v = 0; v < numVariables(); ++v)
     {
-      FGNodePtr old_vnode = *vit;
-      if (old_vnode->nodeBdd.cubeIntersection(variableCube).isOne())
+      if (m_variableVars[v].intersects(cubeVars))
       {
-        ++vit;
+        newVars |= m_variableVars[v];
+        newIndex[v] = std::numeric_limits<Index>::max();
         continue;
       }
-
-      new_vnode->nodeBdd = new_vnode->nodeBdd.cubeUnion(old_vnode->nodeBdd);
-      for (const auto & old_edge: old_vnode->edges)
+      newIndex[v] = Index(variableCubes.size());
+      variableCubes.push_back(std::move(m_variableCubes[v]));
+      variableVars.push_back(std::move(m_variableVars[v]));
+      isPending.push_back(m_isPending[variableNode(v)]);
+    }
+    Index newVariable = Index(variableCubes.size());
+    variableCubes.push_back(BddWrapper(newVars.toCube(manager), manager));
+    variableVars.push_back(std::move(newVars));
+    isPending.push_back(1);
+
+    // the edges of the grouped variables are replaced by one edge per neighbour
+    std::vector<EdgeEntry> edges;
+    edges.reserve(numEdges());
+    std::vector<char> isNeighbour(numFactors(), 0);
+    for (Index e = 0; e < numEdges(); ++e)
+    {
+      Index f = m_edgeFactors[e];
+      Index v = newIndex[m_edgeVariables[e]];
+      if (v != std::numeric_limits<Index>::max())
+        edges.push_back(EdgeEntry{f, v, std::move(m_variableToFactor[e]), std::move(m_factorToVariable[e])});
+      else if (!isNeighbour[f])
       {
-        const auto & old_fnode = old_edge->getFactorNode();
-        m_edges.erase(old_edge);
-        old_fnode->edges.erase(old_edge);
-        if (neighbors.count(old_fnode))
-          continue;
-        neighbors.insert(old_fnode);
-        FGEdgePtr new_edge = std::make_shared<FGEdge>(new_vnode, old_fnode);
-        m_edges.insert(new_edge);
-        old_fnode->edges.insert(new_edge);
-        new_vnode->edges.insert(new_edge);
+        isNeighbour[f] = 1;
+        isPending[f] = 1;
+        edges.push_back(EdgeEntry{f, newVariable, one, one});
       }
-      vit = m_variableNodes.erase(vit);
     }
-    m_variableNodes.insert(new_vnode);
+
+    m_variableCubes.swap(variableCubes);
+    m_variableVars.swap(variableVars);
+    m_isPending.swap(isPending);
+    setEdges(std::move(edges));
   }
 
 } // end anonymous namespace
@@ -360,6 +1017,54 @@ namespace {
 namespace fgpp
 {
 
+  Schedule parseSchedule(std::string const & name)
+  {
+    std::string lower(name);
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return std::tolower(c); });
+    if (lower == "flood")
+      return Schedule::Flood;
+    else if (lower == "size")
+      return Schedule::ResidualSize;
+    else if (lower == "minterms")
+      return Schedule::ResidualMinterms;
+    throw std::invalid_argument("Unknown factor graph schedule '" + name + "', expecting one of flood/size/minterms");
+  }
+
+  std::string toString(Schedule schedule)
+  {
+    switch (schedule)
+    {
+      case Schedule::Flood: return "flood";
+      case Schedule::ResidualSize: return "size";
+      case Schedule::ResidualMinterms: return "minterms";
+    }
+    return "unknown";
+  }
+
+  MessageComputation parseMessageComputation(std::string const & name)
+  {
+    std::string lower(name);
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return std::tolower(c); });
+    if (lower == "conjoin")
+      return MessageComputation::Conjoin;
+    else if (lower == "andabstract")
+      return MessageComputation::AndAbstract;
+    else if (lower == "shared")
+      return MessageComputation::SharedAndAbstract;
+    throw std::invalid_argument("Unknown factor graph message computation '" + name + "', expecting one of conjoin/andabstract/shared");
+  }
+
+  std::string toString(MessageComputation messageComputation)
+  {
+    switch (messageComputation)
+    {
+      case MessageComputation::Conjoin: return "conjoin";
+      case MessageComputation::AndAbstract: return "andabstract";
+      case MessageComputation::SharedAndAbstract: return "shared";
+    }
+    return "unknown";
+  }
+
   
   FactorGraph::Ptr FactorGraph::createFactorGraph(const std::vector<BddWrapper> & factors)
   {
@@ -423,75 +1128,85 @@ namespace {
 
     // test factor graph creation
     FactorGraphImpl fg1(F);
-    assert(fg1.m_factorNodes.size() == numFactors);
-    assert(fg1.m_variableNodes.size() == numVars);
-    assert(fg1.m_edges.size() == 20);
-
-    // all factors nodes should be FGFactorNodes
-    std::vector<FGFactorNodePtr> fnodes(F.size());
-    for (const auto & fn: fg1.m_factorNodes)
+    assert(fg1.numFactors() == numFactors);
+    assert(fg1.numVariables() == numVars);
+    assert(fg1.numEdges() == 20);
+
+    // every factor should have a factor node
+    const Index missing = std::numeric_limits<Index>::max();
+    std::vector<Index> fnodes(F.size(), missing);
+    for (Index f = 0; f < fg1.numFactors(); ++f)
       for (size_t iF = 0; iF < F.size(); ++iF)
-        if (fn->nodeBdd == F[iF])
-          fnodes[iF] = std::dynamic_pointer_cast<FGFactorNode>(fn);
+        if (fg1.m_factorBdds[f] == F[iF])
+          fnodes[iF] = f;
     for (const auto & fnode: fnodes)
-      assert(fnode);
+      assert(fnode != missing);
     
     // f5 should have 3 edges to v5, v6, and v9
     {
-      FGFactorNodePtr f5Node = fnodes[5];
-      assert(f5Node->supportBdd == F[5].support());
-      assert(f5Node->edges.size() == 3);
+      Index f5Node = fnodes[5];
+      assert(fg1.m_factorSupports[f5Node] == F[5].support());
+      assert(fg1.edgesOf(f5Node).size() == 3);
       std::set<BddWrapper> f5Neigh, expectedF5Neigh;
-      for (const auto & e5: f5Node->edges)
-        f5Neigh.insert(e5->getVariableNode()->nodeBdd);
+      for (auto e5: fg1.edgesOf(f5Node))
+        f5Neigh.insert(fg1.m_variableCubes[fg1.m_edgeVariables[e5]]);
       expectedF5Neigh.insert(V[5]);
       expectedF5Neigh.insert(V[6]);
       expectedF5Neigh.insert(V[9]);
       assert(f5Neigh == expectedF5Neigh);
     }
 
-    // all variable nodes should be FGVariableNodes
-    std::vector<FGVariableNodePtr> vnodes(V.size());
-    for (const auto & vn: fg1.m_variableNodes)
+    // every variable should have a variable node
+    std::vector<Index> vnodes(V.size(), missing);
+    for (Index v = 0; v < fg1.numVariables(); ++v)
       for (size_t iV = 0; iV < V.size(); ++iV)
-        if (vn->nodeBdd == V[iV])
-          vnodes[iV] = std::dynamic_pointer_cast<FGVariableNode>(vn);
+        if (fg1.m_variableCubes[v] == V[iV])
+          vnodes[iV] = fg1.variableNode(v);
     for (const auto & vnode: vnodes)
-      assert(vnode);
+      assert(vnode != missing);
 
     // v10 should have 1 edge to f6
     {
-      FGNodePtr v10Node;
-      for (const auto & vn: fg1.m_variableNodes)
-        if (vn->nodeBdd == V[10]) v10Node = vn;
-      assert(v10Node);
-      assert(std::dynamic_pointer_cast<FGVariableNode>(v10Node));
-      assert(v10Node->edges.size() == 1);
-      assert((*v10Node->edges.begin())->getFactorNode()->nodeBdd == F[6]);
+      Index v10Node = vnodes[10];
+      assert(!fg1.isFactor(v10Node));
+      assert(fg1.edgesOf(v10Node).size() == 1);
+      assert(fg1.m_factorBdds[fg1.m_edgeFactors[fg1.edgesOf(v10Node).front()]] == F[6]);
     }
 
     // manual function and variable message passing
     {
-      std::set<FGNodePtr> updatedSet;
-      fnodes[2]->passMessages(updatedSet);
+      IndexSet updatedSet(fg1.numNodes());
+      fg1.passMessages(fnodes[2], updatedSet);
       assert(updatedSet.size() == 2);
-      for (const auto & en: fnodes[2]->edges)
-        assert(en->factorToVariableMessage == project(F[2], en->getVariableNode()->nodeBdd));
+      for (auto en: fg1.edgesOf(fnodes[2]))
+        assert(fg1.m_factorToVariable[en] == project(F[2], fg1.m_variableCubes[fg1.m_edgeVariables[en]]));
 
-      fnodes[4]->passMessages(updatedSet);
-      fnodes[0]->passMessages(updatedSet);
-      updatedSet.erase(updatedSet.begin(), updatedSet.end());
-      vnodes[1]->passMessages(updatedSet);
+      fg1.passMessages(fnodes[4], updatedSet);
+      fg1.passMessages(fnodes[0], updatedSet);
+      updatedSet.clear();
+      fg1.passMessages(vnodes[1], updatedSet);
       assert(updatedSet.size() == 3);
-      for (const auto & en: vnodes[1]->edges)
-        assert(en->variableToFactorMessage == -V[1]);
+      for (auto en: fg1.edgesOf(vnodes[1]))
+        assert(fg1.m_variableToFactor[en] == -V[1]);
+    }
+
+    // edges should be sorted by factor, and listed for each variable in edge order
+    for (Index e = 0; e + 1 < fg1.numEdges(); ++e)
+      assert(fg1.m_edgeFactors[e] < fg1.m_edgeFactors[e + 1]
+             || (fg1.m_edgeFactors[e] == fg1.m_edgeFactors[e + 1] && fg1.m_edgeVariables[e] < fg1.m_edgeVariables[e + 1]));
+    for (Index v = 0; v < fg1.numVariables(); ++v)
+    {
+      auto edges = fg1.edgesOf(fg1.variableNode(v));
+      assert(std::is_sorted(edges.cbegin(), edges.cend()));
+      for (auto e: edges)
+        assert(fg1.m_edgeVariables[e] == v);
     }
 
     // convergence should give over approximations
     BddWrapper FAnd = F[0].one();
     for (const auto & factor: F)
       FAnd = FAnd * factor;
-    fg1.converge();
+    int fg1Iterations = fg1.converge();
     for (const auto & variable: V)
     {
       auto messages = fg1.getIncomingMessages(variable);
@@ -502,14 +1217,105 @@ namespace {
       assert(-FAndProjected + messagesAnd == V[0].one()); // assert(FAndProjected => messagesAnd)
     }
 
+    // parallel convergence should give the same messages in as many iterations
+    {
+      std::vector<std::vector<BddWrapper> > sequentialMessages;
+      for (const auto & variable: V)
+        sequentialMessages.push_back(fg1.getIncomingMessages(variable));
+      assert(fg1.convergeParallel(3, dd::ManagerOptions()) == fg1Iterations);
+      for (size_t iV = 0; iV < V.size(); ++iV)
+        assert(fg1.getIncomingMessages(V[iV]) == sequentialMessages[iV]);
+      assert(fg1.convergeParallel(1, dd::ManagerOptions()) == fg1Iterations);
+      for (size_t iV = 0; iV < V.size(); ++iV)
+        assert(fg1.getIncomingMessages(V[iV]) == sequentialMessages[iV]);
+
+      // so should every schedule
+      long long floodUpdates = fg1.convergeScheduled(fgpp::Schedule::Flood, 0);
+      assert(floodUpdates >= fg1Iterations);
+      for (size_t iV = 0; iV < V.size(); ++iV)
+        assert(fg1.getIncomingMessages(V[iV]) == sequentialMessages[iV]);
+      for (auto schedule: {fgpp::Schedule::ResidualSize, fgpp::Schedule::ResidualMinterms})
+      {
+        assert(fg1.convergeScheduled(schedule, 0) >= fg1Iterations);
+        for (size_t iV = 0; iV < V.size(); ++iV)
+          assert(fg1.getIncomingMessages(V[iV]) == sequentialMessages[iV]);
+      }
+
+      // a bound on the updates stops early, still over approximating
+      assert(fg1.convergeScheduled(fgpp::Schedule::ResidualSize, 3) == 3);
+      for (const auto & variable: V)
+      {
+        auto messagesAnd = V[0].one();
+        for (const auto & m: fg1.getIncomingMessages(variable))
+          messagesAnd = messagesAnd * m;
+        assert(-project(FAnd, variable) + messagesAnd == V[0].one());
+      }
+
+      assert(fgpp::parseSchedule("Minterms") == fgpp::Schedule::ResidualMinterms);
+      assert(fgpp::toString(fgpp::parseSchedule("size")) == "size");
+
+      // as should every way of computing the messages
+      // (ending with the default)
+      for (auto messageComputation: {fgpp::MessageComputation::AndAbstract,
+                                     fgpp::MessageComputation::SharedAndAbstract,
+                                     fgpp::MessageComputation::Conjoin})
+      {
+        fg1.setMessageComputation(messageComputation);
+        assert(fg1.converge() == fg1Iterations);
+        for (size_t iV = 0; iV < V.size(); ++iV)
+          assert(fg1.getIncomingMessages(V[iV]) == sequentialMessages[iV]);
+        assert(fg1.convergeParallel(2, dd::ManagerOptions()) == fg1Iterations);
+        for (size_t iV = 0; iV < V.size(); ++iV)
+          assert(fg1.getIncomingMessages(V[iV]) == sequentialMessages[iV]);
+      }
+
+      // a failed transfer, to a worker or back from one, throws having
+      // released the workers (and their caches), and leaves the graph usable
+      for (bool failBack: {false, true})
+      {
+        static DdManager * graphManager;
+        static bool failToGraph;
+        static std::set<DdManager *> workerManagers;
+        graphManager = F[0].getManager();
+        failToGraph = failBack;
+        workerManagers.clear();
+        s_bddTransfer = [](DdManager * source, DdManager * destination, DdNode * f) -> DdNode * {
+          if ((destination == graphManager) != failToGraph)
+            return Cudd_bddTransfer(source, destination, f);
+          workerManagers.insert(destination == graphManager ? source : destination);
+          return NULL;
+        };
+        fg1.setMessageComputation(fgpp::MessageComputation::SharedAndAbstract);
+        bool threw = false;
+        try { fg1.convergeParallel(3, dd::ManagerOptions()); } catch (std::runtime_error const &) { threw = true; }
+        s_bddTransfer = Cudd_bddTransfer;
+        fg1.setMessageComputation(fgpp::MessageComputation::Conjoin);
+        assert(threw);
+        assert(!workerManagers.empty());
+        for (auto workerManager: workerManagers)
+        {
+          dd::SupportCacheStats supportStats;
+          Cudd_MultiCacheStats multiStats;
+          assert(!dd::readSupportCacheStats(workerManager, &supportStats));
+          assert(0 == Cudd_MultiCacheReadStats(workerManager, &multiStats));
+        }
+        assert(fg1.convergeParallel(2, dd::ManagerOptions()) == fg1Iterations);
+        for (size_t iV = 0; iV < V.size(); ++iV)
+          assert(fg1.getIncomingMessages(V[iV]) == sequentialMessages[iV]);
+      }
+
+      assert(fgpp::parseMessageComputation("AndAbstract") == fgpp::MessageComputation::AndAbstract);
+      assert(fgpp::toString(fgpp::parseMessageComputation("shared")) == "shared");
+    }
+
     // convergence on acyclic graph should give exact answers
     {
       FactorGraphImpl fg2(F);
       BddWrapper v_6_9_11 = V[6].cubeUnion(V[9]).cubeUnion(V[11]);
       fg2.groupVariables(v_6_9_11);
-      assert(fg2.m_factorNodes.size() == F.size());
-      assert(fg2.m_variableNodes.size() == V.size() - 3 + 1);
-      assert(fg2.m_edges.size() == fg1.m_edges.size() - 3);
+      assert(fg2.numFactors() == F.size());
+      assert(fg2.numVariables() == V.size() - 3 + 1);
+      assert(fg2.numEdges() == fg1.numEdges() - 3);
       fg2.converge();
       std::vector<BddWrapper> groupedVars{V[0], V[1], V[2], V[3], V[4], V[5], v_6_9_11, V[7], V[8], V[10]};
       for (const auto & gv: groupedVars)
@@ -523,36 +1329,79 @@ namespace {
       }
     }
 
+    // incremental convergence after grouping should stay sound, be at least
+    // as tight as converging from scratch, and start from the touched nodes only
+    {
+      FactorGraphImpl warm(F), cold(F);
+      assert(warm.convergeIncremental() > 0); // a new graph has all its factors pending
+      assert(warm.convergeIncremental() == 0);
+      BddWrapper v_6_9_11 = V[6].cubeUnion(V[9]).cubeUnion(V[11]);
+      for (auto * fg: {&warm, &cold})
+      {
+        fg->groupFactors({F[6], F[7]});
+        fg->groupVariables(v_6_9_11);
+      }
+      assert(size_t(std::count(warm.m_isPending.cbegin(), warm.m_isPending.cend(), 1)) < warm.numNodes());
+      warm.convergeIncremental();
+      assert(std::count(warm.m_isPending.cbegin(), warm.m_isPending.cend(), 1) == 0);
+      cold.converge();
+      std::vector<BddWrapper> groupedVars{V[0], V[1], V[2], V[3], V[4], V[5], v_6_9_11, V[7], V[8], V[10]};
+      for (const auto & variable: groupedVars)
+      {
+        auto warmAnd = V[0].one(), coldAnd = V[0].one();
+        for (const auto & m: warm.getIncomingMessages(variable))
+          warmAnd = warmAnd * m;
+        for (const auto & m: cold.getIncomingMessages(variable))
+          coldAnd = coldAnd * m;
+        assert(-project(FAnd, variable) + warmAnd == V[0].one());
+        assert(-warmAnd + coldAnd == V[0].one());
+      }
+    }
+
     // grouping of variable nodes should work
     {
       FactorGraphImpl fg3(F);
-      auto findNodeInSet = 
-        [](const BddWrapper& bdd, 
-           const FGNodePtrSet& nodeSet
-        ) -> FGNodePtr
+      auto findFactor = 
+        [&fg3](const BddWrapper& bdd) -> Index
+        {
+          for (Index f = 0; f < fg3.numFactors(); ++f)
+            if (fg3.m_factorBdds[f] == bdd)
+              return f;
+          assert(false); // could not find node
+          return 0; // unreachable
+        };
+      auto findVariable = 
+        [&fg3](const BddWrapper& bdd) -> Index
         {
-          for (const auto & node: nodeSet)
-            if (node->nodeBdd == bdd)
-              return node;
+          for (Index v = 0; v < fg3.numVariables(); ++v)
+            if (fg3.m_variableCubes[v] == bdd)
+              return fg3.variableNode(v);
           assert(false); // could not find node
-          return NULL; // unreachable
+          return 0; // unreachable
         };
       auto findEdgeInSet = 
-        [](const BddWrapper& variable,
+        [&fg3](const BddWrapper& variable,
            const BddWrapper& factor,
-           const FGEdgePtrSet& edgeSet
-        ) -> FGEdgePtr {
-          for (const auto & edge: edgeSet)
-            if(edge->getFactorNode()->nodeBdd == factor 
-               && edge->getVariableNode()->nodeBdd == variable)
+           const std::vector<Index>& edgeSet
+        ) -> Index {
+          for (auto edge: edgeSet)
+            if(fg3.m_factorBdds[fg3.m_edgeFactors[edge]] == factor 
+               && fg3.m_variableCubes[fg3.m_edgeVariables[edge]] == variable)
               return edge;
           assert(false); // could not find edge
-          return NULL; // unreachable
+          return 0; // unreachable
+        };
+      auto allEdges =
+        [&fg3]()
+        {
+          std::vector<Index> result(fg3.numEdges());
+          std::iota(result.begin(), result.end(), Index(0));
+          return result;
         };
       auto matchEdgeSet =
         [findEdgeInSet](const std::vector<BddWrapper>& variables,
            const std::vector<BddWrapper>& factors,
-           const FGEdgePtrSet& edges)
+           const std::vector<Index>& edges)
         {
           assert(variables.size() == factors.size());
           assert(factors.size() == edges.size());
@@ -562,51 +1411,51 @@ namespace {
       
       // check unmerged graph
       {
-        assert(fg3.m_factorNodes.size() == 8);
-        auto f_0 = findNodeInSet(F[0], fg3.m_factorNodes);
-        matchEdgeSet({V[0], V[1]}, {2, F[0]}, f_0->edges);
-        auto f_1 = findNodeInSet(F[1], fg3.m_factorNodes);
-        matchEdgeSet({V[1], V[2], V[3]}, {3, F[1]}, f_1->edges);
-        auto f_2 = findNodeInSet(F[2], fg3.m_factorNodes);
-        matchEdgeSet({V[2], V[4]}, {2, F[2]}, f_2->edges);
-        auto f_3 = findNodeInSet(F[3], fg3.m_factorNodes);
-        matchEdgeSet({V[0], V[7], V[8]}, {3, F[3]}, f_3->edges);
-        auto f_4 = findNodeInSet(F[4], fg3.m_factorNodes);
-        matchEdgeSet({V[1], V[5]}, {2, F[4]}, f_4->edges);
-        auto f_5 = findNodeInSet(F[5], fg3.m_factorNodes);
-        matchEdgeSet({V[5], V[6], V[9]}, {3, F[5]}, f_5->edges);
-        auto f_6 = findNodeInSet(F[6], fg3.m_factorNodes);
-        matchEdgeSet({V[6], V[11], V[10]}, {3, F[6]}, f_6->edges);
-        auto f_7 = findNodeInSet(F[7], fg3.m_factorNodes);
-        matchEdgeSet({V[9], V[11]}, {2, F[7]}, f_7->edges);
-
-        assert(fg3.m_variableNodes.size() == 12);
-        auto v_0 = findNodeInSet(V[0], fg3.m_variableNodes);
-        matchEdgeSet({2, V[0]}, {F[0], F[3]}, v_0->edges);
-        auto v_1 = findNodeInSet(V[1], fg3.m_variableNodes);
-        matchEdgeSet({3, V[1]}, {F[0], F[1], F[4]}, v_1->edges);
-        auto v_2 = findNodeInSet(V[2], fg3.m_variableNodes);
-        matchEdgeSet({2, V[2]}, {F[1], F[2]}, v_2->edges);
-        auto v_3 = findNodeInSet(V[3], fg3.m_variableNodes);
-        matchEdgeSet({1, V[3]}, {1, F[1]}, v_3->edges);
-        auto v_4 = findNodeInSet(V[4], fg3.m_variableNodes);
-        matchEdgeSet({1, V[4]}, {1, F[2]}, v_4->edges);
-        auto v_5 = findNodeInSet(V[5], fg3.m_variableNodes);
-        matchEdgeSet({2, V[5]}, {F[4], F[5]}, v_5->edges);
-        auto v_6 = findNodeInSet(V[6], fg3.m_variableNodes);
-        matchEdgeSet({2, V[6]}, {F[5], F[6]}, v_6->edges);
-        auto v_7 = findNodeInSet(V[7], fg3.m_variableNodes);
-        matchEdgeSet({1, V[7]}, {1, F[3]}, v_7->edges);
-        auto v_8 = findNodeInSet(V[8], fg3.m_variableNodes);
-        matchEdgeSet({1, V[8]}, {1, F[3]}, v_8->edges);
-        auto v_9 = findNodeInSet(V[9], fg3.m_variableNodes);
-        matchEdgeSet({2, V[9]}, {F[5], F[7]}, v_9->edges);
-        auto v_10 = findNodeInSet(V[10], fg3.m_variableNodes);
-        matchEdgeSet({1, V[10]}, {1, F[6]}, v_10->edges);
-        auto v_11 = findNodeInSet(V[11], fg3.m_variableNodes);
-        matchEdgeSet({2, V[11]}, {F[6], F[7]}, v_11->edges);
-
-        assert(fg3.m_edges.size() == 20);
+        assert(fg3.numFactors() == 8);
+        auto f_0 = findFactor(F[0]);
+        matchEdgeSet({V[0], V[1]}, {2, F[0]}, fg3.edgesOf(f_0));
+        auto f_1 = findFactor(F[1]);
+        matchEdgeSet({V[1], V[2], V[3]}, {3, F[1]}, fg3.edgesOf(f_1));
+        auto f_2 = findFactor(F[2]);
+        matchEdgeSet({V[2], V[4]}, {2, F[2]}, fg3.edgesOf(f_2));
+        auto f_3 = findFactor(F[3]);
+        matchEdgeSet({V[0], V[7], V[8]}, {3, F[3]}, fg3.edgesOf(f_3));
+        auto f_4 = findFactor(F[4]);
+        matchEdgeSet({V[1], V[5]}, {2, F[4]}, fg3.edgesOf(f_4));
+        auto f_5 = findFactor(F[5]);
+        matchEdgeSet({V[5], V[6], V[9]}, {3, F[5]}, fg3.edgesOf(f_5));
+        auto f_6 = findFactor(F[6]);
+        matchEdgeSet({V[6], V[11], V[10]}, {3, F[6]}, fg3.edgesOf(f_6));
+        auto f_7 = findFactor(F[7]);
+        matchEdgeSet({V[9], V[11]}, {2, F[7]}, fg3.edgesOf(f_7));
+
+        assert(fg3.numVariables() == 12);
+        auto v_0 = findVariable(V[0]);
+        matchEdgeSet({2, V[0]}, {F[0], F[3]}, fg3.edgesOf(v_0));
+        auto v_1 = findVariable(V[1]);
+        matchEdgeSet({3, V[1]}, {F[0], F[1], F[4]}, fg3.edgesOf(v_1));
+        auto v_2 = findVariable(V[2]);
+        matchEdgeSet({2, V[2]}, {F[1], F[2]}, fg3.edgesOf(v_2));
+        auto v_3 = findVariable(V[3]);
+        matchEdgeSet({1, V[3]}, {1, F[1]}, fg3.edgesOf(v_3));
+        auto v_4 = findVariable(V[4]);
+        matchEdgeSet({1, V[4]}, {1, F[2]}, fg3.edgesOf(v_4));
+        auto v_5 = findVariable(V[5]);
+        matchEdgeSet({2, V[5]}, {F[4], F[5]}, fg3.edgesOf(v_5));
+        auto v_6 = findVariable(V[6]);
+        matchEdgeSet({2, V[6]}, {F[5], F[6]}, fg3.edgesOf(v_6));
+        auto v_7 = findVariable(V[7]);
+        matchEdgeSet({1, V[7]}, {1, F[3]}, fg3.edgesOf(v_7));
+        auto v_8 = findVariable(V[8]);
+        matchEdgeSet({1, V[8]}, {1, F[3]}, fg3.edgesOf(v_8));
+        auto v_9 = findVariable(V[9]);
+        matchEdgeSet({2, V[9]}, {F[5], F[7]}, fg3.edgesOf(v_9));
+        auto v_10 = findVariable(V[10]);
+        matchEdgeSet({1, V[10]}, {1, F[6]}, fg3.edgesOf(v_10));
+        auto v_11 = findVariable(V[11]);
+        matchEdgeSet({2, V[11]}, {F[6], F[7]}, fg3.edgesOf(v_11));
+
+        assert(fg3.numEdges() == 20);
         matchEdgeSet({V[0], V[1],
                       V[1], V[2], V[3],
                       V[2], V[4],
@@ -623,7 +1472,7 @@ namespace {
                       F[5], F[5], F[5],
                       F[6], F[6], F[6],
                       F[7], F[7]},
-                     fg3.m_edges);
+                     allEdges());
       }
 
       // check merged graph
@@ -634,40 +1483,40 @@ namespace {
         fg3.groupFactors({F[0] * F[1] * F[2], F[3]});
         auto v_0_1_2_3 = v_0_1_2 * V[3];
         fg3.groupVariables(v_0_1_2_3);
-        assert(fg3.m_factorNodes.size() == 5);
+        assert(fg3.numFactors() == 5);
         auto f_0_1_2_3 = F[0] * F[1] * F[2] * F[3];
-        auto f_merged = findNodeInSet(f_0_1_2_3, fg3.m_factorNodes);
-        matchEdgeSet({v_0_1_2_3, V[4], V[7], V[8]}, {4, f_0_1_2_3}, f_merged->edges);
-        auto f_4 = findNodeInSet(F[4], fg3.m_factorNodes);
-        matchEdgeSet({v_0_1_2_3, V[5]}, {2, F[4]}, f_4->edges);
-        auto f_5 = findNodeInSet(F[5], fg3.m_factorNodes);
-        matchEdgeSet({V[5], V[6], V[9]}, {3, F[5]}, f_5->edges);
-        auto f_6 = findNodeInSet(F[6], fg3.m_factorNodes);
-        matchEdgeSet({V[6], V[10], V[11]}, {3, F[6]}, f_6->edges);
-        auto f_7 = findNodeInSet(F[7], fg3.m_factorNodes);
-        matchEdgeSet({V[9], V[11]}, {2, F[7]}, f_7->edges);
-
-        assert(fg3.m_variableNodes.size() == 9);
-        auto v_merged = findNodeInSet(v_0_1_2_3, fg3.m_variableNodes);
-        matchEdgeSet({2, v_0_1_2_3}, {f_0_1_2_3, F[4]}, v_merged->edges);
-        auto v_4 = findNodeInSet(V[4], fg3.m_variableNodes);
-        matchEdgeSet({1, V[4]}, {f_0_1_2_3}, v_4->edges);
-        auto v_5 = findNodeInSet(V[5], fg3.m_variableNodes);
-        matchEdgeSet({2, V[5]}, {F[4], F[5]}, v_5->edges);
-        auto v_6 = findNodeInSet(V[6], fg3.m_variableNodes);
-        matchEdgeSet({2, V[6]}, {F[5], F[6]}, v_6->edges);
-        auto v_7 = findNodeInSet(V[7], fg3.m_variableNodes);
-        matchEdgeSet({1, V[7]}, {f_0_1_2_3}, v_7->edges);
-        auto v_8 = findNodeInSet(V[8], fg3.m_variableNodes);
-        matchEdgeSet({1, V[8]}, {f_0_1_2_3}, v_8->edges);
-        auto v_9 = findNodeInSet(V[9], fg3.m_variableNodes);
-        matchEdgeSet({2, V[9]}, {F[5], F[7]}, v_9->edges);
-        auto v_10 = findNodeInSet(V[10], fg3.m_variableNodes);
-        matchEdgeSet({1, V[10]}, {1, F[6]}, v_10->edges);
-        auto v_11 = findNodeInSet(V[11], fg3.m_variableNodes);
-        matchEdgeSet({2, V[11]}, {F[6], F[7]}, v_11->edges);
+        auto f_merged = findFactor(f_0_1_2_3);
+        matchEdgeSet({v_0_1_2_3, V[4], V[7], V[8]}, {4, f_0_1_2_3}, fg3.edgesOf(f_merged));
+        auto f_4 = findFactor(F[4]);
+        matchEdgeSet({v_0_1_2_3, V[5]}, {2, F[4]}, fg3.edgesOf(f_4));
+        auto f_5 = findFactor(F[5]);
+        matchEdgeSet({V[5], V[6], V[9]}, {3, F[5]}, fg3.edgesOf(f_5));
+        auto f_6 = findFactor(F[6]);
+        matchEdgeSet({V[6], V[10], V[11]}, {3, F[6]}, fg3.edgesOf(f_6));
+        auto f_7 = findFactor(F[7]);
+        matchEdgeSet({V[9], V[11]}, {2, F[7]}, fg3.edgesOf(f_7));
+
+        assert(fg3.numVariables() == 9);
+        auto v_merged = findVariable(v_0_1_2_3);
+        matchEdgeSet({2, v_0_1_2_3}, {f_0_1_2_3, F[4]}, fg3.edgesOf(v_merged));
+        auto v_4 = findVariable(V[4]);
+        matchEdgeSet({1, V[4]}, {f_0_1_2_3}, fg3.edgesOf(v_4));
+        auto v_5 = findVariable(V[5]);
+        matchEdgeSet({2, V[5]}, {F[4], F[5]}, fg3.edgesOf(v_5));
+        auto v_6 = findVariable(V[6]);
+        matchEdgeSet({2, V[6]}, {F[5], F[6]}, fg3.edgesOf(v_6));
+        auto v_7 = findVariable(V[7]);
+        matchEdgeSet({1, V[7]}, {f_0_1_2_3}, fg3.edgesOf(v_7));
+        auto v_8 = findVariable(V[8]);
+        matchEdgeSet({1, V[8]}, {f_0_1_2_3}, fg3.edgesOf(v_8));
+        auto v_9 = findVariable(V[9]);
+        matchEdgeSet({2, V[9]}, {F[5], F[7]}, fg3.edgesOf(v_9));
+        auto v_10 = findVariable(V[10]);
+        matchEdgeSet({1, V[10]}, {1, F[6]}, fg3.edgesOf(v_10));
+        auto v_11 = findVariable(V[11]);
+        matchEdgeSet({2, V[11]}, {F[6], F[7]}, fg3.edgesOf(v_11));
         
-        assert(fg3.m_edges.size() == 14);
+        assert(fg3.numEdges() == 14);
         matchEdgeSet({v_0_1_2_3, V[4], V[7], V[8],
                       v_0_1_2_3, V[5],
                       V[5], V[6], V[9],
@@ -678,8 +1527,37 @@ namespace {
                       F[5], F[5], F[5],
                       F[6], F[6], F[6],
                       F[7], F[7]},
-                     fg3.m_edges);
+                     allEdges());
+      }
+    }
+
+    // a grouped factor keeps the neighbours of the factors it groups, but
+    // its support is that of the conjunction (f0 * f1 = v0 * -v1 * v3 does
+    // not depend on v2), so the messages its variables send it are
+    // projected on that support, rather than being trivially one
+    {
+      FactorGraphImpl fg4(F);
+      auto f_0_1 = fg4.groupFactors({F[0], F[1]});
+      assert(f_0_1 == F[0] * F[1]);
+      Index grouped = Index(fg4.numFactors() - 1);
+      assert(fg4.m_factorBdds[grouped] == f_0_1);
+      assert(fg4.m_factorSupports[grouped] == f_0_1.support());
+      std::set<BddWrapper> neighbours;
+      for (auto e: fg4.edgesOf(grouped))
+        neighbours.insert(fg4.m_variableCubes[fg4.m_edgeVariables[e]]);
+      assert(neighbours == std::set<BddWrapper>({V[0], V[1], V[2], V[3]}));
+
+      fg4.converge();
+      bool isTrivial = true;
+      for (auto e: fg4.edgesOf(grouped))
+      {
+        auto incoming = V[0].one();
+        for (auto ve: fg4.edgesOf(fg4.variableNode(fg4.m_edgeVariables[e])))
+          incoming = incoming * fg4.m_factorToVariable[ve];
+        assert(fg4.m_variableToFactor[e] == project(incoming, fg4.m_factorSupports[grouped]));
+        isTrivial = isTrivial && fg4.m_variableToFactor[e].isOne();
       }
+      assert(!isTrivial);
     }
 
 
@@ -25,12 +25,47 @@ SOFTWARE.
 #pragma once
 
 #include <dd/bdd_factory.h>
+#include <dd/manager_factory.h>
 #include <memory>
+#include <string>
 
 
 namespace fgpp
 {
 
+  // ***** Schedule *****
+  // the order in which nodes are re-run while converging a factor graph
+  //   Flood:            every node with an updated incoming message, in rounds
+  //   ResidualSize:     the node whose incoming messages changed the most
+  //                     (in total) first, a change counting 1 + the change in bdd size
+  //   ResidualMinterms: the node whose incoming messages changed the most
+  //                     (in total) first, a change counting the fraction of
+  //                     minterms it removed
+  enum class Schedule { Flood, ResidualSize, ResidualMinterms };
+
+  // parses flood / size / minterms (case insensitive),
+  // throws std::invalid_argument otherwise
+  Schedule parseSchedule(std::string const & name);
+  std::string toString(Schedule schedule);
+
+  // ***** MessageComputation *****
+  // how a node computes its outgoing messages, the conjunction of its
+  // inputs projected on each of its edges
+  //   Conjoin:           builds the conjunction, then projects it on each edge
+  //   AndAbstract:       one multi-operand and-abstract per edge, so the
+  //                      unprojected conjunction is never built
+  //   SharedAndAbstract: and-abstracts onto each half of the edges' variables,
+  //                      then splits the two projections edge by edge with plain
+  //                      existential quantification, sharing the work between edges
+  // All of them give the same messages.
+  enum class MessageComputation { Conjoin, AndAbstract, SharedAndAbstract };
+
+  // parses conjoin / andabstract / shared (case insensitive),
+  // throws std::invalid_argument otherwise
+  MessageComputation parseMessageComputation(std::string const & name);
+  std::string toString(MessageComputation messageComputation);
+
+
   class FactorGraph
   {
     public:
@@ -41,6 +76,33 @@ namespace fgpp
       virtual BddWrapper groupFactors(const std::vector<BddWrapper> & factors) = 0;
       virtual std::vector<BddWrapper> getIncomingMessages(const BddWrapper & variableCube) const = 0;
       virtual int converge() = 0;
+      // Same result and number of iterations as converge(), but the nodes
+      // pending in each iteration are split among numThreads workers,
+      // each computing messages in a DdManager of its own (with the
+      // variable order of the graph's manager).
+      // The workers take the reordering and gc policy of managerOptions,
+      // and split its maxMemory evenly, so that together they stay within
+      // the limit on top of the graph's manager. The numVariables and
+      // numFactors hints are dropped, since a worker only holds messages.
+      // The messages are transferred back to the graph's manager at the
+      // end of every iteration. numThreads <= 1 just calls converge().
+      virtual int convergeParallel(int numThreads, const dd::ManagerOptions & managerOptions = dd::ManagerOptions()) = 0;
+      // Converges with the given schedule, stopping early after maxUpdates
+      // node updates if maxUpdates > 0. Messages are over-approximations
+      // all along, so stopping early only loses precision.
+      // Fully converged, all the schedules give the same messages.
+      // Returns the number of node updates.
+      virtual long long convergeScheduled(Schedule schedule, long long maxUpdates = 0) = 0;
+      // Warm start: keeps the current messages, which stay valid
+      // over-approximations across groupFactors / groupVariables, and only
+      // re-runs the nodes touched since the last convergence (by grouping,
+      // or left pending by a bounded convergeScheduled), and whatever they
+      // update in turn. The result is at least as tight as converge()'s.
+      // Returns the number of node updates.
+      virtual long long convergeIncremental() = 0;
+      // How messages are computed by all the converge methods
+      // (MessageComputation::Conjoin by default).
+      virtual void setMessageComputation(MessageComputation messageComputation) = 0;
 
       // static Ptr createLegacyFactorGraph(const std::vector<BddWrapper> & factors);
       static Ptr createFactorGraph(const std::vector<BddWrapper> & factors);
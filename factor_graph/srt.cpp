@@ -35,6 +35,8 @@ SOFTWARE.
 #include <cmath>
 #include "srt.h"
 
+#include <dd/manager_factory.h>
+
 #ifdef DEBUG
 #define DBG(stmt) stmt
 #else
@@ -85,12 +87,8 @@ void read_FV(std::ifstream& fin, int &F, int &V)
 
 DdManager* ddm_init()
 {
-  DdManager *m;
-  //UNIQUE_SLOTS = 256
-  //CACHE_SLOTS = 262144
-  m = Cudd_Init(0, 0, 256, 262144, 0);
-  common_error(m, "srt.cpp : Could not initialize DdManager\n");
-  return m;
+  // the problem size is not known yet, and limits are set by the caller (see dd::configureManager)
+  return dd::createManager(dd::ManagerOptions());
 }
 
 
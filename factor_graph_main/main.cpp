@@ -24,6 +24,7 @@ SOFTWARE.
 
 
 
+#include <dd/manager_factory.h>
 #include <factor_graph/factor_graph.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -874,12 +875,9 @@ void fgtest1(factor_graph *fg)
 
 DdManager* ddm_init()
 {
-  DdManager *m;
-  //UNIQUE_SLOTS = 256
-  //CACHE_SLOTS = 262144
-  m = Cudd_Init(0, 0, 256, 262144, 0);
-  common_error(m, "main.c : Could not initialize DdManager\n");
-  Cudd_SetMaxMemory(m, (unsigned long) MAX_MEM_MB * (unsigned long)1000000);
+  dd::ManagerOptions options;
+  options.maxMemory = (size_t) MAX_MEM_MB * (size_t)1000000;
+  DdManager *m = dd::createManager(options);
   printf("max memory allowed : %d MB\n", (int)(Cudd_ReadMaxMemory(m)/1000000));
   return m;
 }
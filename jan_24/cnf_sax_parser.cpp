@@ -24,14 +24,210 @@ SOFTWARE.
 
 #include "cnf_sax_parser.h"
 
-#include <regex>
+#include <dd/mapped_file.h>
+#include <dd/thread_pool.h>
+
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <limits>
 #include <stdexcept>
+#include <vector>
 
 
 
 namespace {
 
-    static std::regex p_header_regex("p cnf ([0-9]*) ([0-9]*)", std::regex_constants::ECMAScript | std::regex_constants::icase);
+    enum class LineKind : char { Comment, PHeader, Quantifier, Clause };
+
+    // a lexed line, with its literals stored in the owning chunk
+    struct LexedLine {
+        LineKind kind;
+        char quantifier;
+        const char* text;
+        size_t textLength;
+        size_t literalsBegin;
+        size_t literalsEnd;
+        int numVars;
+        int numClauses;
+    };
+
+    // the lexed lines of a range of the input,
+    //   cleared and refilled for every range so that the buffers are reused
+    // a malformed line ends the chunk, and its error is raised
+    //   only after the lines before it have been delivered
+    struct LexedChunk {
+        std::vector<LexedLine> lines;
+        std::vector<int> literals;
+        std::string error;
+        void clear() { lines.clear(); literals.clear(); error.clear(); }
+    };
+
+    bool isBlank(char c) { return c == ' ' || c == '\t'; }
+
+    // reads the digits at pos (none reads as 0),
+    //   throwing std::range_error if the number exceeds limit
+    long long readDigits(const char*& pos, const char* end, long long limit)
+    {
+        long long result = 0;
+        for (; pos != end && *pos >= '0' && *pos <= '9'; ++pos)
+        {
+            result = result * 10 + (*pos - '0');
+            if (result > limit)
+                throw std::range_error("integer out of range");
+        }
+        return result;
+    }
+
+    // reads the longest prefix of [pos, end) that looks like an integer,
+    //   returning false if there is none, like std::istream >> int,
+    //   and throwing std::range_error if it does not fit in an int
+    bool readInt(const char*& pos, const char* end, int& value)
+    {
+        while (pos != end && isBlank(*pos)) ++pos;
+        const char* cur = pos;
+        bool isNegative = false;
+        if (cur != end && (*cur == '-' || *cur == '+'))
+        {
+            isNegative = (*cur == '-');
+            ++cur;
+        }
+        if (cur == end || *cur < '0' || *cur > '9')
+            return false;
+        long long const limit = isNegative ? -static_cast<long long>(std::numeric_limits<int>::min()) : std::numeric_limits<int>::max();
+        long long result = readDigits(cur, end, limit);
+        value = static_cast<int>(isNegative ? -result : result);
+        pos = cur;
+        return true;
+    }
+
+    void readLiterals(const char* pos, const char* end, std::vector<int>& literals)
+    {
+        int literal;
+        while (readInt(pos, end, literal))
+            literals.push_back(literal);
+    }
+
+    // matches "p cnf <numVars> <numClauses>", case insensitive,
+    //   where, as with the regex "p cnf ([0-9]*) ([0-9]*)" this replaced,
+    //   either number may be empty, and then reads as 0
+    bool readPHeader(const char* pos, const char* end, int& numVars, int& numClauses)
+    {
+        if (end - pos < 6 || pos[1] != ' '
+            || (pos[2] | 0x20) != 'c' || (pos[3] | 0x20) != 'n' || (pos[4] | 0x20) != 'f' || pos[5] != ' ')
+            return false;
+        pos += 6;
+        numVars = static_cast<int>(readDigits(pos, end, std::numeric_limits<int>::max()));
+        if (pos == end || *pos != ' ')
+            return false;
+        ++pos;
+        numClauses = static_cast<int>(readDigits(pos, end, std::numeric_limits<int>::max()));
+        return pos == end;
+    }
+
+    void lexLineUnchecked(const char* begin, const char* end, LexedChunk& chunk)
+    {
+        LexedLine line{ LineKind::Comment, 0, begin, static_cast<size_t>(end - begin), 0, 0, 0, 0 };
+        char first = *begin;
+        if (first == 'c' || first == '/' || first == '#')
+            line.kind = LineKind::Comment;
+        else if (first == 'p')
+        {
+            while (end != begin && end[-1] == ' ') --end;
+            line.kind = LineKind::PHeader;
+            line.textLength = static_cast<size_t>(end - begin);
+            if (!readPHeader(begin, end, line.numVars, line.numClauses))
+                throw std::runtime_error("Could not match p header line {" + std::string(begin, end) + '}');
+        }
+        else if (first == 'a' || first == 'e')
+        {
+            line.kind = LineKind::Quantifier;
+            line.quantifier = first;
+            line.literalsBegin = chunk.literals.size();
+            readLiterals(begin + 1, end, chunk.literals);
+            line.literalsEnd = chunk.literals.size();
+        }
+        else if (first == '-' || (first >= '0' && first <= '9'))
+        {
+            line.kind = LineKind::Clause;
+            line.literalsBegin = chunk.literals.size();
+            readLiterals(begin, end, chunk.literals);
+            line.literalsEnd = chunk.literals.size();
+        }
+        else
+            throw std::runtime_error("Could not parse qdimacs line {" + std::string(begin, end) + '}');
+        chunk.lines.push_back(line);
+    }
+
+    // lexes a single line (without its line break) into the chunk,
+    //   throwing std::runtime_error if the line is malformed
+    //   or has a number that does not fit in an int
+    void lexLine(const char* begin, const char* end, LexedChunk& chunk)
+    {
+        if (begin != end && end[-1] == '\r')
+            --end;
+        if (begin == end)
+            return;
+        size_t const numLiterals = chunk.literals.size();
+        try {
+            lexLineUnchecked(begin, end, chunk);
+        } catch (const std::range_error&) {
+            chunk.literals.resize(numLiterals);
+            throw std::runtime_error("Integer out of range in qdimacs line {" + std::string(begin, end) + '}');
+        }
+    }
+
+    void lexChunk(const char* begin, const char* end, LexedChunk& chunk)
+    {
+        chunk.clear();
+        try {
+            while (begin != end)
+            {
+                const char* lineEnd = static_cast<const char*>(std::memchr(begin, '\n', static_cast<size_t>(end - begin)));
+                if (lineEnd == nullptr)
+                    lineEnd = end;
+                lexLine(begin, lineEnd, chunk);
+                begin = (lineEnd == end ? end : lineEnd + 1);
+            }
+        } catch (const std::runtime_error& e) {
+            chunk.error = e.what();
+        }
+    }
+
+    // the end of the chunk starting at begin: just past the first line break after chunkSize bytes
+    const char* chunkEnd(const char* begin, const char* end, size_t chunkSize)
+    {
+        if (static_cast<size_t>(end - begin) <= chunkSize)
+            return end;
+        const char* lineBreak = static_cast<const char*>(std::memchr(begin + chunkSize, '\n', static_cast<size_t>(end - begin) - chunkSize));
+        return lineBreak == nullptr ? end : lineBreak + 1;
+    }
+
+    void deliver(const LexedChunk& chunk, jan_24::ICnfSaxParser& parser)
+    {
+        const int* literals = chunk.literals.data();
+        for (const auto& line: chunk.lines)
+        {
+            std::string_view text(line.text, line.textLength);
+            switch (line.kind)
+            {
+                case LineKind::Comment:
+                    parser.parseComment(text);
+                    break;
+                case LineKind::PHeader:
+                    parser.parsePHeader(text, line.numVars, line.numClauses);
+                    break;
+                case LineKind::Quantifier:
+                    parser.parseQuantifierLine(text, line.quantifier, jan_24::LiteralSpan(literals + line.literalsBegin, literals + line.literalsEnd));
+                    break;
+                case LineKind::Clause:
+                    parser.parseClause(text, jan_24::LiteralSpan(literals + line.literalsBegin, literals + line.literalsEnd));
+                    break;
+            }
+        }
+        if (!chunk.error.empty())
+            throw std::runtime_error(chunk.error);
+    }
 
 } // end anonymous namespace
 
@@ -43,45 +239,66 @@ namespace jan_24 {
     void ICnfSaxParser::parse(std::istream& cnfStream)
     {
         std::string line;
-        std::vector<int> literalsTerminatedWithZero;
+        LexedChunk chunk;
         while (getline(cnfStream, line))
         {
-            if (line.size() == 0)
-                continue;
-            else if (line[0] == 'c' || line[0] == '/' || line[0] == '#')
-                parseComment(line);
-            else if (line[0] == 'p')
-            {
-                while(line.back() == ' ') line.pop_back();
-                std::smatch p_header_match;
-                if (!std::regex_match(line, p_header_match, p_header_regex))
-                    throw std::runtime_error("Could not match p header line {" + line + '}');
-                int numVars = std::atoi(p_header_match[1].str().c_str());
-                int numClauses = std::atoi(p_header_match[2].str().c_str());
-                parsePHeader(line, numVars, numClauses);
-            }
-            else if (line[0] == 'a' || line[0] == 'e')
+            chunk.clear();
+            lexLine(line.data(), line.data() + line.size(), chunk);
+            deliver(chunk, *this);
+        }
+    }
+
+    void ICnfSaxParser::parseFile(const std::string& path, int numThreads, size_t chunkSize)
+    {
+        if (chunkSize == 0)
+            throw std::invalid_argument("ICnfSaxParser::parseFile: chunkSize must be positive");
+        dd::MappedFile file(path);
+        const char* pos = file.begin();
+        const char* end = file.end();
+
+        if (numThreads == 1 || static_cast<size_t>(end - pos) <= chunkSize)
+        {
+            LexedChunk chunk;
+            while (pos != end)
             {
-                std::stringstream liness(line);
-                char quantifier;
-                liness >> quantifier;
-                literalsTerminatedWithZero.clear();
-                int literal;
-                while(liness >> literal)
-                    literalsTerminatedWithZero.push_back(literal);
-                parseQuantifierLine(line, quantifier, literalsTerminatedWithZero);
+                const char* next = chunkEnd(pos, end, chunkSize);
+                lexChunk(pos, next, chunk);
+                deliver(chunk, *this);
+                pos = next;
             }
-            else if (line[0] == '-' || (line[0] >= '0' && line[0] <= '9'))
+            return;
+        }
+
+        // chunk i is lexed into slot i % numSlots, and the slot is
+        //   only handed to the next chunk after it has been delivered,
+        //   so at most numSlots chunks are in memory at any time
+        parakram::ThreadPool pool(numThreads);
+        size_t const numSlots = 2 * static_cast<size_t>(pool.numThreads());
+        std::vector<LexedChunk> slots(numSlots);
+        std::vector<std::future<void> > pending(numSlots);
+        size_t numSubmitted = 0, numDelivered = 0;
+        try {
+            while (numDelivered < numSubmitted || pos != end)
             {
-                literalsTerminatedWithZero.clear();
-                int literal;
-                std::stringstream liness (line);
-                while(liness >> literal)
-                    literalsTerminatedWithZero.push_back(literal);
-                parseClause(line, literalsTerminatedWithZero);
+                while (pos != end && numSubmitted - numDelivered < numSlots)
+                {
+                    const char* next = chunkEnd(pos, end, chunkSize);
+                    LexedChunk* slot = &slots[numSubmitted % numSlots];
+                    pending[numSubmitted % numSlots] = pool.submit([pos, next, slot]() { lexChunk(pos, next, *slot); });
+                    pos = next;
+                    ++numSubmitted;
+                }
+                size_t current = numDelivered % numSlots;
+                pending[current].get();
+                deliver(slots[current], *this);
+                ++numDelivered;
             }
-            else
-                throw std::runtime_error("Could not parse qdimacs line {" + line + '}');
+        } catch (...) {
+            // the lexing tasks point into the slots, so let them finish first
+            for (; numDelivered < numSubmitted; ++numDelivered)
+                if (pending[numDelivered % numSlots].valid())
+                    pending[numDelivered % numSlots].wait();
+            throw;
         }
     }
 
@@ -24,22 +24,54 @@ SOFTWARE.
 
 #pragma once
 
+#include <cstddef>
 #include <istream>
 #include <string>
-#include <vector>
+#include <string_view>
 
 namespace jan_24 {
 
+    // A read-only view of a contiguous range of literals,
+    //   valid only for the duration of the callback it is passed to.
+    class LiteralSpan {
+    public:
+        LiteralSpan(const int* begin, const int* end) : m_begin(begin), m_end(end) {}
+        const int* begin() const { return m_begin; }
+        const int* end() const { return m_end; }
+        const int* cbegin() const { return m_begin; }
+        const int* cend() const { return m_end; }
+        size_t size() const { return static_cast<size_t>(m_end - m_begin); }
+        bool empty() const { return m_begin == m_end; }
+        int operator[](size_t i) const { return m_begin[i]; }
+        int back() const { return m_end[-1]; }
+    private:
+        const int* m_begin;
+        const int* m_end;
+    };
+
+    // Streams the lines of a (q)dimacs file to the virtual callbacks.
+    // The line and literal arguments point into the parser's buffers,
+    //   so implementations must copy whatever they want to keep.
     class ICnfSaxParser {
     
     public:
         void parse(std::istream& cnfStream);
-        virtual void parseComment(const std::string& line) = 0;
-        virtual void parsePHeader(const std::string& line, int numVars, int numClauses) = 0;
-        virtual void parseQuantifierLine(const std::string& line, char quantifier, const std::vector<int> & literalsTerminatedWithZero) = 0;
-        virtual void parseClause(const std::string& line, const std::vector<int> & literalsTerminatedWithZero) = 0;
+        // chunks are cut at the first line break after this many bytes
+        static constexpr size_t DefaultChunkSize = 4 << 20;
+
+        // Maps the file and lexes it in chunks on numThreads threads
+        //   (0 for one per hardware thread, 1 to lex on the calling thread).
+        // The callbacks are always invoked on the calling thread,
+        //   in the order in which the lines appear in the file.
+        // Numbers that do not fit in an int are reported as errors.
+        void parseFile(const std::string& path, int numThreads = 0, size_t chunkSize = DefaultChunkSize);
+
+        virtual void parseComment(std::string_view line) = 0;
+        virtual void parsePHeader(std::string_view line, int numVars, int numClauses) = 0;
+        virtual void parseQuantifierLine(std::string_view line, char quantifier, LiteralSpan literalsTerminatedWithZero) = 0;
+        virtual void parseClause(std::string_view line, LiteralSpan literalsTerminatedWithZero) = 0;
 
         virtual ~ICnfSaxParser() {}
     };
 
-} // end namespace jan_24
\ No newline at end of file
+} // end namespace jan_24
@@ -29,6 +29,7 @@ SOFTWARE.
 #include <set>
 #include <stdexcept>
 #include <unordered_set>
+#include <vector>
 
 
 extern "C" {
@@ -81,10 +82,10 @@ class DiagnosticsSaxParser: public jan_24::ICnfSaxParser
 {
     public:
 
-    void parseComment(const std::string& line) override;
-    void parsePHeader(const std::string& line, int numVars, int numClauses) override;
-    void parseQuantifierLine(const std::string& line, char quantifier, const std::vector<int> & literalsTerminatedWithZero) override;
-    void parseClause(const std::string& line, const std::vector<int> & literalsTerminatedWithZero) override;
+    void parseComment(std::string_view line) override;
+    void parsePHeader(std::string_view line, int numVars, int numClauses) override;
+    void parseQuantifierLine(std::string_view line, char quantifier, jan_24::LiteralSpan literalsTerminatedWithZero) override;
+    void parseClause(std::string_view line, jan_24::LiteralSpan literalsTerminatedWithZero) override;
 
     void summarize(int & numHeaderVars,
                    int & numHeaderQuantifiedVars,
@@ -131,17 +132,17 @@ class QDimacsParser: private jan_24::ICnfSaxParser
 {
 public:
     using UPtr = std::unique_ptr<QDimacsParser const>;
-    static UPtr parseFile(std::istream& file);
+    static UPtr parseFile(const std::string& path);
 
     QDimacs qdimacs;
 
 private:
-    QDimacsParser(std::istream& file);
+    QDimacsParser(const std::string& path);
 
-    void parseComment(const std::string& line) override;
-    void parsePHeader(const std::string& line, int numVars, int numClauses) override;
-    void parseQuantifierLine(const std::string& line, char quantifier, const std::vector<int> & literalsTerminatedWithZero) override;
-    void parseClause(const std::string& line, const std::vector<int> & literalsTerminatedWithZero) override;
+    void parseComment(std::string_view line) override;
+    void parsePHeader(std::string_view line, int numVars, int numClauses) override;
+    void parseQuantifierLine(std::string_view line, char quantifier, jan_24::LiteralSpan literalsTerminatedWithZero) override;
+    void parseClause(std::string_view line, jan_24::LiteralSpan literalsTerminatedWithZero) override;
 
 };
 
@@ -173,10 +174,8 @@ int bfss_input_equals_kissat_output(char const * const bfss_input_path, char con
 {
     blif_solve_log(DEBUG, "Comparing " << bfss_input_path << " and " << kissat_output_path);
     try {
-        std::ifstream bfss_input(bfss_input_path);
-        auto bfss_parsed = QDimacsParser::parseFile(bfss_input);
-        std::ifstream kissat_output(kissat_output_path);
-        auto kissat_parsed = QDimacsParser::parseFile(kissat_output);
+        auto bfss_parsed = QDimacsParser::parseFile(bfss_input_path);
+        auto kissat_parsed = QDimacsParser::parseFile(kissat_output_path);
         bool match = (bfss_parsed->qdimacs == kissat_parsed->qdimacs);
         return match ? 1 : 0;
     } 
@@ -213,15 +212,8 @@ void diagnostics(char const * const cnf_input_path,
 {
     error = false;
     try {
-        std::ifstream fin(cnf_input_path);
-        if (!fin.good())
-        {
-            error = true;
-            blif_solve_log(ERROR, "Exception in call to diagnostics: error reading cnf file '" << cnf_input_path << '\'');
-            return;
-        }
         DiagnosticsSaxParser dsp;
-        dsp.parse(fin);
+        dsp.parseFile(cnf_input_path);
         dsp.summarize(numHeaderVars, numHeaderQuantifiedVars, numHeaderClauses, numActualVars, numActualQuantifiedVars, numActualClauses);
     }
     catch (const std::bad_alloc&)
@@ -263,26 +255,26 @@ bool QDimacs::operator==(const QDimacs& that) const
 
 
 
-QDimacsParser::UPtr QDimacsParser::parseFile(std::istream& file)
+QDimacsParser::UPtr QDimacsParser::parseFile(const std::string& path)
 {
-    return std::unique_ptr<QDimacsParser const>(new QDimacsParser(file));
+    return std::unique_ptr<QDimacsParser const>(new QDimacsParser(path));
 }
 
-QDimacsParser::QDimacsParser(std::istream& file)
+QDimacsParser::QDimacsParser(const std::string& path)
 {
-    this->parse(file);
+    this->ICnfSaxParser::parseFile(path);
 }
 
-void QDimacsParser::parseComment(const std::string& ) { }
-void QDimacsParser::parsePHeader(const std::string& , int numVars, int)
+void QDimacsParser::parseComment(std::string_view) { }
+void QDimacsParser::parsePHeader(std::string_view, int numVars, int)
 {
     qdimacs.numVars = numVars;
 }
-void QDimacsParser::parseQuantifierLine(const std::string&, char quantifier, const std::vector<int> & literalsTerminatedWithZero)
+void QDimacsParser::parseQuantifierLine(std::string_view, char quantifier, jan_24::LiteralSpan literalsTerminatedWithZero)
 {
     qdimacs.quantifiers.emplace_back(quantifier, std::set<int>(literalsTerminatedWithZero.cbegin(), literalsTerminatedWithZero.cend()));
 }
-void QDimacsParser::parseClause(const std::string& , const std::vector<int> & literalsTerminatedWithZero)
+void QDimacsParser::parseClause(std::string_view, jan_24::LiteralSpan literalsTerminatedWithZero)
 {
     qdimacs.clauses.insert(std::set<int>(literalsTerminatedWithZero.cbegin(), literalsTerminatedWithZero.cend()));
 }
@@ -292,13 +284,13 @@ void QDimacsParser::parseClause(const std::string& , const std::vector<int> & li
 
 
 
-void DiagnosticsSaxParser::parseComment(const std::string& line) { }
-void DiagnosticsSaxParser::parsePHeader(const std::string& line, int numVars, int numClauses)
+void DiagnosticsSaxParser::parseComment(std::string_view line) { }
+void DiagnosticsSaxParser::parsePHeader(std::string_view line, int numVars, int numClauses)
 {
     m_numHeaderVars = numVars;
     m_numHeaderClauses = numClauses;
 }
-void DiagnosticsSaxParser::parseQuantifierLine(const std::string& line, char quantifier, const std::vector<int> & literalsTerminatedWithZero)
+void DiagnosticsSaxParser::parseQuantifierLine(std::string_view line, char quantifier, jan_24::LiteralSpan literalsTerminatedWithZero)
 {
     if (quantifier == 'e')
     {
@@ -308,7 +300,7 @@ void DiagnosticsSaxParser::parseQuantifierLine(const std::string& line, char qua
         m_numHeaderQuantifiedVars = m_innermostExistentialVariables.size();
     }
 }
-void DiagnosticsSaxParser::parseClause(const std::string& line, const std::vector<int> & literalsTerminatedWithZero)
+void DiagnosticsSaxParser::parseClause(std::string_view line, jan_24::LiteralSpan literalsTerminatedWithZero)
 {
     for (auto l: literalsTerminatedWithZero)
         if (l != 0)
@@ -53,10 +53,10 @@ struct BddParser: public jan_24::ICnfSaxParser
     dd::BddWrapper m_bdd;
     DdManager* m_ddm;
     BddParser(DdManager* ddm);
-    virtual void parseComment(const std::string& line) override {}
-    virtual void parsePHeader(const std::string& line, int numVars, int numClauses) override {}
-    virtual void parseQuantifierLine(const std::string& line, char quantifier, const std::vector<int> & literalsTerminatedWithZero) override {}
-    virtual void parseClause(const std::string& line, const std::vector<int> & literalsTerminatedWithZero) override;
+    virtual void parseComment(std::string_view line) override {}
+    virtual void parsePHeader(std::string_view line, int numVars, int numClauses) override {}
+    virtual void parseQuantifierLine(std::string_view line, char quantifier, jan_24::LiteralSpan literalsTerminatedWithZero) override {}
+    virtual void parseClause(std::string_view line, jan_24::LiteralSpan literalsTerminatedWithZero) override;
 };
 
 
@@ -113,9 +113,8 @@ std::unique_ptr<dd::ManagerWrapper> ddm_init()
 
 dd::BddWrapper parse_bdd(const std::string& file, DdManager* ddm)
 {
-    std::ifstream fin(file);
     BddParser parser(ddm);
-    parser.parse(fin);
+    parser.parseFile(file);
     return parser.m_bdd;
 }
 
@@ -130,7 +129,7 @@ BddParser::BddParser(DdManager* ddm):
 
 
 
-void BddParser::parseClause(const std::string& , const std::vector<int> & literalsTerminatedWithZero)
+void BddParser::parseClause(std::string_view, jan_24::LiteralSpan literalsTerminatedWithZero)
 {
     auto clause = m_bdd.zero();
     for (const auto& l: literalsTerminatedWithZero)
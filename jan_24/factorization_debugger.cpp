@@ -47,10 +47,10 @@ struct CommandLineOptions {
 
 class CnfToBdd: public jan_24::ICnfSaxParser {
     public:
-        void parseComment(const std::string& line) override;
-        void parsePHeader(const std::string& line, int numVars, int numClauses) override;
-        void parseQuantifierLine(const std::string& line, char quantifier, const std::vector<int> & literalsTerminatedWithZero) override;
-        void parseClause(const std::string& line, const std::vector<int> & literalsTerminatedWithZero) override;
+        void parseComment(std::string_view line) override;
+        void parsePHeader(std::string_view line, int numVars, int numClauses) override;
+        void parseQuantifierLine(std::string_view line, char quantifier, jan_24::LiteralSpan literalsTerminatedWithZero) override;
+        void parseClause(std::string_view line, jan_24::LiteralSpan literalsTerminatedWithZero) override;
         
         CnfToBdd(DdManager* v_ddm);
         DdManager* ddm;
@@ -100,13 +100,13 @@ int main(int const argc, char const * const * const argv)
 
 
 
-void CnfToBdd::parseComment(const std::string& )
+void CnfToBdd::parseComment(std::string_view)
 { }
-void CnfToBdd::parsePHeader(const std::string& , int , int )
+void CnfToBdd::parsePHeader(std::string_view, int , int )
 { }
-void CnfToBdd::parseQuantifierLine(const std::string& , char , const std::vector<int> & )
+void CnfToBdd::parseQuantifierLine(std::string_view, char , jan_24::LiteralSpan)
 { }
-void CnfToBdd::parseClause(const std::string& line, const std::vector<int> & literalsTerminatedWithZero)
+void CnfToBdd::parseClause(std::string_view line, jan_24::LiteralSpan literalsTerminatedWithZero)
 {
     dd::BddWrapper clause(bdd_zero(ddm), ddm);
     for (int lit: literalsTerminatedWithZero)
@@ -227,8 +227,7 @@ dd::BddWrapper parseCnfBdd(const std::string& qdimacsFile, DdManager* ddm)
 {
     blif_solve_log(DEBUG, "Parsing cnf bdd");
     CnfToBdd parser(ddm);
-    std::ifstream fin(qdimacsFile);
-    parser.parse(fin);
+    parser.parseFile(qdimacsFile);
     blif_solve_log(INFO, "Parsed cnf bdd");
     return parser.cnfBdd;
 }
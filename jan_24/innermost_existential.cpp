@@ -56,10 +56,10 @@ class InnermostExistentialSaxParser: public jan_24::ICnfSaxParser
         m_existentiallyQuantifiedVariables()
     { }
 
-    void parseComment(const std::string& line) override;
-    void parsePHeader(const std::string& line, int numVars, int numClauses) override;
-    void parseQuantifierLine(const std::string& line, char quantifier, const std::vector<int> & literalsTerminatedWithZero) override;
-    void parseClause(const std::string& line, const std::vector<int> & literalsTerminatedWithZero) override;
+    void parseComment(std::string_view line) override;
+    void parsePHeader(std::string_view line, int numVars, int numClauses) override;
+    void parseQuantifierLine(std::string_view line, char quantifier, jan_24::LiteralSpan literalsTerminatedWithZero) override;
+    void parseClause(std::string_view line, jan_24::LiteralSpan literalsTerminatedWithZero) override;
 
     private:
     std::ofstream m_fout;
@@ -82,8 +82,7 @@ int main(int argc, char const * const * const argv) {
     blif_solve_log(INFO, "Starting innermost_existential (" << clo.inputFile << " -> " << clo.outputFile << ")");
     
     InnermostExistentialSaxParser cnfParser(clo.outputFile, clo.addUniversalQuantifier);
-    std::ifstream fin(clo.inputFile);
-    cnfParser.parse(fin);
+    cnfParser.parseFile(clo.inputFile);
 
     blif_solve_log(INFO, "Finished innermost_existential");
     return 0;
@@ -98,11 +97,11 @@ int main(int argc, char const * const * const argv) {
 
 
 
-void InnermostExistentialSaxParser::parseComment(const std::string& line) { 
+void InnermostExistentialSaxParser::parseComment(std::string_view line) { 
     m_fout << line << '\n'; 
 }
 void InnermostExistentialSaxParser::parsePHeader(
-    const std::string& line, 
+    std::string_view line, 
     int numVars, 
     int numClauses
 ) { 
@@ -110,7 +109,7 @@ void InnermostExistentialSaxParser::parsePHeader(
     m_fout << line << '\n';
     blif_solve_log(DEBUG, "innermost_existential writing result with " << numVars << " vars and " << numClauses << " clauses");
 }
-void InnermostExistentialSaxParser::parseQuantifierLine(const std::string& line, char quantifier, const std::vector<int>& literalsTerminatedWithZero) {
+void InnermostExistentialSaxParser::parseQuantifierLine(std::string_view line, char quantifier, jan_24::LiteralSpan literalsTerminatedWithZero) {
     if (quantifier == 'e')
     {
         m_existentiallyQuantifiedVariables.insert(literalsTerminatedWithZero.cbegin(), literalsTerminatedWithZero.cend());
@@ -124,8 +123,8 @@ void InnermostExistentialSaxParser::parseQuantifierLine(const std::string& line,
 }
 
 void InnermostExistentialSaxParser::parseClause(
-    const std::string& line, 
-    const std::vector<int>& // literalsTerminatedWithZero unused parameter
+    std::string_view line, 
+    jan_24::LiteralSpan // literalsTerminatedWithZero unused parameter
 ) {
     if (!m_quantifiersPrinted)
     {
@@ -53,10 +53,10 @@ class KissatWrapper: public jan_24::ICnfSaxParser
     KissatWrapper();
     ~KissatWrapper();
 
-    void parseComment(const std::string& line) override { }
-    void parsePHeader(const std::string& line, int numVars, int numClauses) override;
-    void parseQuantifierLine(const std::string& line, char quantifier, const std::vector<int> & literalsTerminatedWithZero) override;
-    void parseClause(const std::string& line, const std::vector<int> & literalsTerminatedWithZero) override;
+    void parseComment(std::string_view line) override { }
+    void parsePHeader(std::string_view line, int numVars, int numClauses) override;
+    void parseQuantifierLine(std::string_view line, char quantifier, jan_24::LiteralSpan literalsTerminatedWithZero) override;
+    void parseClause(std::string_view line, jan_24::LiteralSpan literalsTerminatedWithZero) override;
 
     void dumpToFile(const std::string& fileName);
 
@@ -76,10 +76,7 @@ int main(int argc, char const * const * const argv)
     KissatWrapper kw;
     auto solver = kw.solver;
     kissat_set_option(solver, "verbose", get_kissat_verbosity());
-    {
-        std::ifstream fin(clo.inputFile);
-        kw.parse(fin);
-    }
+    kw.parseFile(clo.inputFile);
 
     auto kissat_result = kissat_eliminate_variables(kw.solver, kw.quantifiedVars.data(), kw.quantifiedVars.size());
     blif_solve_log(DEBUG, "kissat_preprocess result: " << kissat_result);
@@ -176,23 +173,22 @@ KissatWrapper::~KissatWrapper()
     kissat_release(solver);
 }
 
-void KissatWrapper::parsePHeader(const std::string&, int parsedNumVars, int parsedNumClauses)
+void KissatWrapper::parsePHeader(std::string_view, int parsedNumVars, int parsedNumClauses)
 {
     blif_solve_log(INFO, "kissat_preprocess processing problem with " << parsedNumVars << " total variables and " << parsedNumClauses << " clauses.");
     numVars = parsedNumVars;
 }
 
-void KissatWrapper::parseQuantifierLine(const std::string&, char quantifier, const std::vector<int> & literalsTerminatedWithZero)
+void KissatWrapper::parseQuantifierLine(std::string_view, char quantifier, jan_24::LiteralSpan literalsTerminatedWithZero)
 {
     if (quantifier == 'e')
     {
         blif_solve_log(INFO, "kissat_preprocess processing problem with " << (literalsTerminatedWithZero.size() - 1) << " quantified variables.");
-        quantifiedVars = literalsTerminatedWithZero;
-        quantifiedVars.pop_back();
+        quantifiedVars.assign(literalsTerminatedWithZero.begin(), literalsTerminatedWithZero.end() - 1);
     }
 }
 
-void KissatWrapper::parseClause(const std::string&, const std::vector<int> & literalsTerminatedWithZero)
+void KissatWrapper::parseClause(std::string_view, jan_24::LiteralSpan literalsTerminatedWithZero)
 {
     for (auto lit: literalsTerminatedWithZero)
         kissat_add(solver, lit);
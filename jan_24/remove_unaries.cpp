@@ -38,10 +38,10 @@ SOFTWARE.
 class UnaryCollector: public jan_24::ICnfSaxParser
 {
     public:
-    void parseComment(const std::string& line) override { }
-    void parsePHeader(const std::string& line, int numVars, int numClauses) override { }
-    void parseQuantifierLine(const std::string& line, char quantifier, const std::vector<int> & literalsTerminatedWithZero) override { }
-    void parseClause(const std::string& line, const std::vector<int> & literalsTerminatedWithZero) override;
+    void parseComment(std::string_view line) override { }
+    void parsePHeader(std::string_view line, int numVars, int numClauses) override { }
+    void parseQuantifierLine(std::string_view line, char quantifier, jan_24::LiteralSpan literalsTerminatedWithZero) override { }
+    void parseClause(std::string_view line, jan_24::LiteralSpan literalsTerminatedWithZero) override;
 
     std::unordered_set<int> unaries;
 };
@@ -56,10 +56,10 @@ class ClauseCounter: public jan_24::ICnfSaxParser
     public:
     using LiteralSetRef = std::unordered_set<int> const &;
     ClauseCounter(LiteralSetRef v_unaries);
-    void parseComment(const std::string& line) override { }
-    void parsePHeader(const std::string& line, int numVars, int numClauses) override { }
-    void parseQuantifierLine(const std::string& line, char quantifier, const std::vector<int> & literalsTerminatedWithZero) override { }
-    void parseClause(const std::string& line, const std::vector<int> & literalsTerminatedWithZero) override;
+    void parseComment(std::string_view line) override { }
+    void parsePHeader(std::string_view line, int numVars, int numClauses) override { }
+    void parseQuantifierLine(std::string_view line, char quantifier, jan_24::LiteralSpan literalsTerminatedWithZero) override { }
+    void parseClause(std::string_view line, jan_24::LiteralSpan literalsTerminatedWithZero) override;
     size_t getNumClauses() const;
 
     private:
@@ -78,10 +78,10 @@ class ResultWriter: public jan_24::ICnfSaxParser
     public:
     using LiteralSetRef = std::unordered_set<int> const &;
     ResultWriter(LiteralSetRef unaries, size_t numClauses, const std::string& outputFileName);
-    void parseComment(const std::string& line) override;
-    void parsePHeader(const std::string& line, int numVars, int numClauses) override;
-    void parseQuantifierLine(const std::string& line, char quantifier, const std::vector<int> & literalsTerminatedWithZero) override;
-    void parseClause(const std::string& line, const std::vector<int> & literalsTerminatedWithZero) override;
+    void parseComment(std::string_view line) override;
+    void parsePHeader(std::string_view line, int numVars, int numClauses) override;
+    void parseQuantifierLine(std::string_view line, char quantifier, jan_24::LiteralSpan literalsTerminatedWithZero) override;
+    void parseClause(std::string_view line, jan_24::LiteralSpan literalsTerminatedWithZero) override;
 
     private:
     LiteralSetRef m_unaries;
@@ -118,25 +118,18 @@ int main(int argc, char const * const * const argv)
     blif_solve_log(INFO, "Starting remove_unaries on " << clo.inputFile << " to " << clo.outputFile);
 
     UnaryCollector uc;
-    {
-        std::ifstream fin(clo.inputFile);
-        uc.parse(fin);
-    }
+    uc.parseFile(clo.inputFile);
     blif_solve_log(DEBUG, "Found " << uc.unaries.size() << " unaries.");
 
     size_t numClauses = 0;
     {
         ClauseCounter cc(uc.unaries);
-        std::ifstream fin(clo.inputFile);
-        cc.parse(fin);
+        cc.parseFile(clo.inputFile);
         numClauses = cc.getNumClauses();
     }
 
     ResultWriter rw(uc.unaries, numClauses, clo.outputFile);
-    {
-        std::ifstream fin(clo.inputFile);
-        rw.parse(fin);
-    }
+    rw.parseFile(clo.inputFile);
 
     blif_solve_log(INFO, "Finished remove_uniaries on " << clo.inputFile << " to " << clo.outputFile);
     return 0;
@@ -176,8 +169,8 @@ CommandLineOptions CommandLineOptions::parse(int argc, char const * const * cons
 
 
 void UnaryCollector::parseClause(
-    const std::string& line, 
-    const std::vector<int> & literalsTerminatedWithZero)
+    std::string_view line, 
+    jan_24::LiteralSpan literalsTerminatedWithZero)
 {
     if (literalsTerminatedWithZero.size() != 2 || literalsTerminatedWithZero[1] != 0)
         return;
@@ -198,7 +191,7 @@ ClauseCounter::ClauseCounter(LiteralSetRef v_unaries) :
         unaries(v_unaries),
         clauses()
 { }
-void ClauseCounter::parseClause(const std::string& line, const std::vector<int> & literalsTerminatedWithZero)
+void ClauseCounter::parseClause(std::string_view line, jan_24::LiteralSpan literalsTerminatedWithZero)
 {
     std::set<int> resultingClause;
     for (const auto l: literalsTerminatedWithZero)
@@ -229,20 +222,20 @@ ResultWriter::ResultWriter(LiteralSetRef unaries, size_t numClauses, const std::
         m_clauses(),
         m_fout(outputFileName)
 { }
-void ResultWriter::parseComment(const std::string& line)
+void ResultWriter::parseComment(std::string_view line)
 {
     m_fout << line << '\n';
 }
-void ResultWriter::parsePHeader(const std::string& line, int numVars, int)
+void ResultWriter::parsePHeader(std::string_view line, int numVars, int)
 {
     m_fout << "p cnf " << numVars << ' ' << m_numClauses << '\n';
     blif_solve_log(DEBUG, "Remove Unaries writing result with " << numVars << " vars and " << m_numClauses << " clauses");
 }
-void ResultWriter::parseQuantifierLine(const std::string& line, char quantifier, const std::vector<int> & literalsTerminatedWithZero)
+void ResultWriter::parseQuantifierLine(std::string_view line, char quantifier, jan_24::LiteralSpan literalsTerminatedWithZero)
 {
     m_fout << line << '\n';
 }
-void ResultWriter::parseClause(const std::string&, const std::vector<int> & literalsTerminatedWithZero)
+void ResultWriter::parseClause(std::string_view, jan_24::LiteralSpan literalsTerminatedWithZero)
 {
     std::set<int> resultingClauseSet;
     std::vector <int> resultingClauseVec;
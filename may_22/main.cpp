@@ -27,6 +27,7 @@ SOFTWARE.
 #include <blif_solve_lib/clo.hpp>
 #include <blif_solve_lib/log.h>
 
+#include <dd/manager_factory.h>
 #include <dd/qdimacs.h>
 #include <dd/qdimacs_to_bdd.h>
 
@@ -52,6 +53,7 @@ struct CommandLineOptions {
   std::string inputFile;
   bool computeExact;
   double mucMergeWeight;
+  size_t maxMemory;
 };
 
 
@@ -105,7 +107,7 @@ struct May22MucCallback: public MucCallback
 // function declarations
 CommandLineOptions parseClo(int argc, char const * const * const argv);
 int main(int argc, char const * const * const argv);
-std::shared_ptr<DdManager> ddm_init();
+std::shared_ptr<DdManager> ddm_init(const dd::Qdimacs& qdimacs, size_t maxMemory);
 void getFactorsAndVariables(DdManager* ddm, const dd::QdimacsToBdd& qdimacsToBdd, dd::BddVectorWrapper& factors, dd::BddVectorWrapper& variables);
 std::shared_ptr<dd::Qdimacs> parseQdimacs(const std::string & inputFilePath);
 std::shared_ptr<Master> createMustMaster(const dd::Qdimacs& qdimacs,
@@ -135,7 +137,7 @@ int main(int argc, char const * const * const argv)
 
   auto start = blif_solve::now();
   auto qdimacs = parseQdimacs(clo.inputFile);                           // parse input file
-  auto ddm = ddm_init();                                                // init cudd
+  auto ddm = ddm_init(*qdimacs, clo.maxMemory);                         // init cudd
   auto bdds = dd::QdimacsToBdd::createFromQdimacs(ddm.get(), *qdimacs); // create bdds
   dd::BddVectorWrapper factors(ddm.get()), variables(ddm.get());
   getFactorsAndVariables(ddm.get(), *bdds, factors, variables);         // parse factors and variables
@@ -170,6 +172,7 @@ int main(int argc, char const * const * const argv)
                                      clo.largestSupportSet, clo.largestBddSize);
   mustMaster->enumerate();
 
+  blif_solve_log(INFO, "Cudd: " << dd::readManagerStats(ddm.get()));
   blif_solve_log(INFO, "Done");
   return 0;
 }
@@ -206,8 +209,7 @@ void mergeAllPairs(const FVec& fvec, blif_solve::MergeHints& mergeHints, const d
 // parse qdimacs file
 std::shared_ptr<dd::Qdimacs> parseQdimacs(const std::string& inputFilePath)
 {
-  std::ifstream fin(inputFilePath);
-  return dd::Qdimacs::parseQdimacs(fin);
+  return dd::Qdimacs::parseQdimacsFile(inputFilePath);
 }
 
 
@@ -221,9 +223,9 @@ void getFactorsAndVariables(DdManager* ddm, const dd::QdimacsToBdd& bdds, dd::Bd
 {
   dd::BddWrapper one(bdd_one(ddm), ddm);
   dd::BddWrapper allVars = one;
-  for (const auto& factorKv: bdds.clauses)
+  for (auto factorBdd: bdds.clauses.bdds())
   {
-    dd::BddWrapper factor(bdd_dup(factorKv.second), ddm);
+    dd::BddWrapper factor(bdd_dup(factorBdd), ddm);
     factors.push_back(factor);
     allVars = allVars * factor.support();
   }
@@ -287,10 +289,17 @@ CommandLineOptions parseClo(int argc, char const * const * const argv)
       false,
       0.5
     );
+  auto maxMemory =
+    std::make_shared<CommandLineOption<std::string> >(
+      "--maxMemory",
+      "memory limit for cudd in bytes, with an optional K/M/G suffix (default 0, no limit)",
+      false,
+      std::string("0")
+    );
   
   // parse the command line
   blif_solve::parse(
-      {  largestSupportSet, largestBddSize, maxMucSize, inputFile, verbosity, computeExact, mucMergeWeight },
+      {  largestSupportSet, largestBddSize, maxMucSize, inputFile, verbosity, computeExact, mucMergeWeight, maxMemory },
       argc,
       argv);
 
@@ -305,7 +314,8 @@ CommandLineOptions parseClo(int argc, char const * const * const argv)
     *(maxMucSize->value),
     *(inputFile->value),
     *(computeExact->value),
-    *(mucMergeWeight->value)
+    *(mucMergeWeight->value),
+    dd::parseMemorySize(*(maxMemory->value))
   };
 }
 
@@ -313,14 +323,14 @@ CommandLineOptions parseClo(int argc, char const * const * const argv)
 
 
 
-// initialize cudd with some defaults
-std::shared_ptr<DdManager> ddm_init()
+// initialize cudd, sized for the problem
+std::shared_ptr<DdManager> ddm_init(const dd::Qdimacs& qdimacs, size_t maxMemory)
 {
-  //UNIQUE_SLOTS = 256
-  //CACHE_SLOTS = 262144
-  std::shared_ptr<DdManager> m(Cudd_Init(0, 0, 256, 262144, 0));
-  if (!m) throw std::runtime_error("Could not initialize cudd");
-  return m;
+  dd::ManagerOptions managerOptions;
+  managerOptions.numVariables = size_t(qdimacs.numVariables);
+  managerOptions.numFactors = qdimacs.clauses.size();
+  managerOptions.maxMemory = maxMemory;
+  return std::shared_ptr<DdManager>(dd::createManager(managerOptions));
 }
 
 
@@ -603,8 +613,8 @@ dd::BddWrapper getFactorGraphResult(DdManager* ddm, const fgpp::FactorGraph& fg,
 dd::BddWrapper getExactResult(DdManager* ddm, const dd::QdimacsToBdd& qdimacsToBdd)
 {
   bdd_ptr f = bdd_one(ddm);
-  for(const auto & kv: qdimacsToBdd.clauses)
-    bdd_and_accumulate(ddm, &f, kv.second);
+  for(auto factor: qdimacsToBdd.clauses.bdds())
+    bdd_and_accumulate(ddm, &f, factor);
   bdd_ptr result = bdd_forsome(ddm, f, qdimacsToBdd.quantifications[0]->quantifiedVariables);
   bdd_free(ddm, f);
   return dd::BddWrapper(result, ddm);
@@ -40,13 +40,36 @@ int main(int argc, char const * const * const argv)
                         << qdimacs->numVariables << " variables in "
                         << blif_solve::duration(start) << " sec");
 
+  // Report the independent clause components. Only reported: the factor
+  // graph of a disconnected instance is disconnected too, so its messages
+  // never cross components, and computeExact splits the quantified
+  // clauses into components of its own.
   start = blif_solve::now();
-  auto ddm = oct_22::ddm_init();                                                // init cudd
+  auto components = dd::partitionClauses(*qdimacs);
+  size_t largestComponent = 0;
+  for (const auto & component: components)
+    largestComponent = std::max(largestComponent, component.size());
+  blif_solve_log(INFO, "Found " << components.size() << " clause components, the largest with "
+                        << largestComponent << " clauses, in " << blif_solve::duration(start) << " sec");
+
+  start = blif_solve::now();
+  auto managerOptions = clo.managerOptions;
+  managerOptions.numVariables = size_t(qdimacs->numVariables);
+  managerOptions.numFactors = qdimacs->clauses.size();
+  auto ddm = oct_22::ddm_init(managerOptions);                                  // init cudd
   std::shared_ptr<dd::QdimacsToBdd> bdds;
   if (clo.runFg || clo.computeExactUsingBdd)
   {
+    if (clo.variableOrdering != dd::VariableOrdering::None)
+    {
+      auto orderStats = dd::orderVariables(ddm.get(), dd::VariableHypergraph::fromClauses(*qdimacs), clo.variableOrdering);
+      blif_solve_log(INFO, "Applied " << dd::toString(clo.variableOrdering) << " variable order in "
+                            << orderStats.seconds << " sec, clause span "
+                            << orderStats.spanBefore << " -> " << orderStats.spanAfter);
+    }
     bdds = dd::QdimacsToBdd::createFromQdimacs(ddm.get(), *qdimacs); // create bdds
-    blif_solve_log(INFO, "Created bdds in " << blif_solve::duration(start) << " sec");
+    blif_solve_log(INFO, "Created bdds with " << dd::sharedSize(bdds->clauses.bdds()) << " nodes in "
+                          << blif_solve::duration(start) << " sec");
   }
   else
   {
@@ -58,12 +81,25 @@ int main(int argc, char const * const * const argv)
   if (clo.runFg)
   {
     auto fg = oct_22::createFactorGraph(ddm.get(), *bdds, clo.largestSupportSet, clo.largestBddSize); // merge factors and create factor graph
+    fg->setMessageComputation(clo.fgMessages);
 
     start = blif_solve::now();
-    auto numIterations = fg->converge();                                  // converge factor graph
-    blif_solve_log(INFO, "Factor graph converged after " 
-        << numIterations << " iterations in "
-        << blif_solve::duration(start) << " secs");
+    if (clo.fgSchedule == fgpp::Schedule::Flood && clo.fgMaxUpdates <= 0)
+    {
+      auto numIterations = fg->convergeParallel(clo.fgThreads, managerOptions); // converge factor graph
+      blif_solve_log(INFO, "Factor graph converged after " 
+          << numIterations << " iterations in "
+          << blif_solve::duration(start) << " secs");
+    }
+    else
+    {
+      if (clo.fgThreads > 1)
+        blif_solve_log(WARNING, "Ignoring --fgThreads, only the unbounded flood schedule runs in parallel");
+      auto numUpdates = fg->convergeScheduled(clo.fgSchedule, clo.fgMaxUpdates); // converge factor graph
+      blif_solve_log(INFO, "Factor graph converged with the " << fgpp::toString(clo.fgSchedule)
+          << " schedule after " << numUpdates << " node updates in "
+          << blif_solve::duration(start) << " secs");
+    }
 
     start = blif_solve::now();                                            // factor graph result to CNF
     auto factorGraphResults = oct_22::getFactorGraphResults(ddm.get(), *fg, *bdds);
@@ -88,6 +124,7 @@ int main(int argc, char const * const * const argv)
     {
       blif_solve_log(INFO, "Some factor graph result was ZERO.");
       oct_22::writeResult(*factorGraphCnf, *qdimacs, clo.outputFile.value());
+      blif_solve_log(INFO, "Cudd: " << dd::readManagerStats(ddm.get()));
       return 0;
     }
   }
@@ -130,8 +167,8 @@ int main(int argc, char const * const * const argv)
 
   if (clo.computeExactUsingBdd)
   {
-    auto exactResult = oct_22::computeExact(*bdds);
-    auto fgMustResult = oct_22::cnfToBdd(*bdds, *factorGraphCnf);
+    auto exactResult = oct_22::computeExact(*bdds, clo.maxClusterSize);
+    auto fgMustResult = oct_22::cnfToBdd(*bdds, *factorGraphCnf, clo.maxClusterSize);
     if (exactResult == fgMustResult) {
       blif_solve_log(INFO, "Factor Graph and/or Must result is EXACT.");
     } else {
@@ -140,6 +177,7 @@ int main(int argc, char const * const * const argv)
     bdd_free(ddm.get(), fgMustResult);
     bdd_free(ddm.get(), exactResult);
   }
+  blif_solve_log(INFO, "Cudd: " << dd::readManagerStats(ddm.get()));
   blif_solve_log(INFO, "Done");
   return 0;
 }
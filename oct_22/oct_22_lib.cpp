@@ -352,12 +352,12 @@ namespace oct_22 {
 
 
 
-  bdd_ptr cnfToBdd(const dd::QdimacsToBdd& qdimacsToBdd, const Oct22MucCallback::Cnf& cnf)
+  bdd_ptr cnfToBdd(const dd::QdimacsToBdd& qdimacsToBdd, const Oct22MucCallback::Cnf& cnf, int maxClusterSize)
   {
     auto ddm = qdimacsToBdd.ddManager;
     auto one = dd::BddWrapper(bdd_one(ddm), ddm);
     auto zero = dd::BddWrapper(bdd_zero(ddm), ddm);
-    auto result = one;
+    dd::BddVectorWrapper resultClauses(ddm);
     auto tseytinVarCube = one;
     for (const auto & cnfClause: cnf)
     {
@@ -369,19 +369,16 @@ namespace oct_22 {
         if (cnfVar > qdimacsToBdd.numVariables)
           tseytinVarCube = tseytinVarCube.cubeUnion(qdimacsToBdd.getBdd(cnfVar));
       }
-      result = result * resultClause;
+      resultClauses.push_back(resultClause);
     }
-    if (tseytinVarCube != one)
-        result = result.existentialQuantification(tseytinVarCube);
-    return result.getCountedBdd();
+    return dd::andExistsScheduled(ddm, *resultClauses, tseytinVarCube.getUncountedBdd(), maxClusterSize);
   }
   
   
   // parse qdimacs file
   std::shared_ptr<dd::Qdimacs> parseQdimacs(const std::string& inputFilePath)
   {
-    std::ifstream fin(inputFilePath);
-    return dd::Qdimacs::parseQdimacs(fin);
+    return dd::Qdimacs::parseQdimacsFile(inputFilePath);
   }
   
   
@@ -401,12 +398,13 @@ namespace oct_22 {
     std::set<bdd_ptr> quantifiedVariableSet;
   
     // get factors and variables
-    for (const auto & kv: bdds.clauses)
+    for (size_t ci = 0; ci < bdds.clauses.size(); ++ci)
     {
-        factors.push_back(kv.second);
+        factors.push_back(bdds.clauses.bdd(ci));
         std::stringstream factorNameSs;
-        for (auto v: kv.first)
+        for (auto vi = bdds.clauses.literalsBegin(ci); vi != bdds.clauses.literalsEnd(ci); ++vi)
         {
+            auto v = *vi;
             auto av = v > 0 ? v : -v;
             variableWrapperSet.insert(std::make_pair(av, bdds.getBdd(av)));
             factorNameSs << v << " OR ";
@@ -436,7 +434,8 @@ namespace oct_22 {
     // merge factors and variables
     auto mergeResults = blif_solve::merge(ddm, factors, variables, largestSupportSet, largestBddSize, blif_solve::MergeHints(ddm), quantifiedVariableSet, factorNames, variableNames);
     blif_solve_log(INFO, "Merged to " 
-                         << mergeResults.factors->size() << " factors and "
+                         << mergeResults.factors->size() << " factors ("
+                         << dd::sharedSize(*mergeResults.factors) << " nodes) and "
                          << mergeResults.variables->size() << "variables in "
                          << blif_solve::duration(start) << " sec");
 #ifdef DEBUG_MERGE
@@ -530,18 +529,89 @@ namespace oct_22 {
         false,
         std::optional<bool>(true)
       );
+    auto maxClusterSize =
+      std::make_shared<CommandLineOption<int> >(
+        "--maxClusterSize",
+        "largest allowed bdd size while clustering cnf factors for the exact result",
+        false,
+        dd::DefaultMaxClusterSize
+      );
+    auto variableOrdering =
+      std::make_shared<CommandLineOption<std::string> >(
+        "--variableOrdering",
+        "static variable order applied before creating bdds (none/cluster/force, default none)",
+        false,
+        std::string("none")
+      );
+    auto maxMemory =
+      std::make_shared<CommandLineOption<std::string> >(
+        "--maxMemory",
+        "memory limit for cudd in bytes, with an optional K/M/G suffix (default 0, no limit)",
+        false,
+        std::string("0")
+      );
+    auto dynamicReordering =
+      std::make_shared<CommandLineOption<std::string> >(
+        "--dynamicReordering",
+        "dynamic reordering done by cudd (none/sift/symmsift/groupsift, default none)",
+        false,
+        std::string("none")
+      );
+    auto gcPolicy =
+      std::make_shared<CommandLineOption<std::string> >(
+        "--gcPolicy",
+        "when cudd collects garbage instead of growing its tables (default/eager/lazy/off, default default)",
+        false,
+        std::string("default")
+      );
+    auto fgThreads =
+      std::make_shared<CommandLineOption<int> >(
+        "--fgThreads",
+        "number of threads converging the factor graph, each with its own cudd manager, the workers sharing --maxMemory (default 1)",
+        false,
+        1
+      );
+    auto fgSchedule =
+      std::make_shared<CommandLineOption<std::string> >(
+        "--fgSchedule",
+        "order in which factor graph nodes are re-run (flood/size/minterms, default flood)",
+        false,
+        std::string("flood")
+      );
+    auto fgMaxUpdates =
+      std::make_shared<CommandLineOption<long long> >(
+        "--fgMaxUpdates",
+        "stop factor graph convergence after these many node updates (default 0, no limit)",
+        false,
+        0LL
+      );
+    auto fgMessages =
+      std::make_shared<CommandLineOption<std::string> >(
+        "--fgMessages",
+        "how factor graph messages are computed (conjoin/andabstract/shared, default conjoin)",
+        false,
+        std::string("conjoin")
+      );
     
     // parse the command line
     blif_solve::parse(
         {  largestSupportSet, largestBddSize, inputFile, verbosity, 
            computeExactUsingBdd, outputFile, runMusTool, runFg,
-           minimalizeAssignments },
+           minimalizeAssignments, maxClusterSize, variableOrdering,
+           maxMemory, dynamicReordering, gcPolicy, fgThreads,
+           fgSchedule, fgMaxUpdates, fgMessages },
         argc,
         argv);
   
     
     // set log verbosity
     blif_solve::setVerbosity(blif_solve::parseVerbosity(*(verbosity->value)));
+
+    // the problem size is filled in once the input is parsed
+    dd::ManagerOptions managerOptions;
+    managerOptions.maxMemory = dd::parseMemorySize(*(maxMemory->value));
+    managerOptions.reordering = dd::parseDynamicReordering(*(dynamicReordering->value));
+    managerOptions.gcPolicy = dd::parseGcPolicy(*(gcPolicy->value));
   
     // return the rest of the options
     return CommandLineOptions{
@@ -552,7 +622,14 @@ namespace oct_22 {
       outputFile->value,
       *(runMusTool->value),
       *(runFg->value),
-      *(minimalizeAssignments->value)
+      *(minimalizeAssignments->value),
+      *(maxClusterSize->value),
+      dd::parseVariableOrdering(*(variableOrdering->value)),
+      managerOptions,
+      *(fgThreads->value),
+      fgpp::parseSchedule(*(fgSchedule->value)),
+      *(fgMaxUpdates->value),
+      fgpp::parseMessageComputation(*(fgMessages->value))
     };
   }
   
@@ -560,14 +637,10 @@ namespace oct_22 {
   
   
   
-  // initialize cudd with some defaults
-  std::shared_ptr<DdManager> ddm_init()
+  // initialize cudd, sized for the problem in the options
+  std::shared_ptr<DdManager> ddm_init(dd::ManagerOptions const & managerOptions)
   {
-    //UNIQUE_SLOTS = 256
-    //CACHE_SLOTS = 262144
-    std::shared_ptr<DdManager> m(Cudd_Init(0, 0, 256, 262144, 0));
-    if (!m) throw std::runtime_error("Could not initialize cudd");
-    return m;
+    return std::shared_ptr<DdManager>(dd::createManager(managerOptions));
   }
   
   
@@ -698,13 +771,9 @@ namespace oct_22 {
   
   
   
-  dd::BddWrapper getExactResult(DdManager* ddm, const dd::QdimacsToBdd& qdimacsToBdd)
+  dd::BddWrapper getExactResult(DdManager* ddm, const dd::QdimacsToBdd& qdimacsToBdd, int maxClusterSize)
   {
-    bdd_ptr f = bdd_one(ddm);
-    for(const auto & kv: qdimacsToBdd.clauses)
-      bdd_and_accumulate(ddm, &f, kv.second);
-    bdd_ptr result = bdd_forsome(ddm, f, qdimacsToBdd.quantifications[0]->quantifiedVariables);
-    bdd_free(ddm, f);
+    bdd_ptr result = dd::andExistsScheduled(ddm, qdimacsToBdd.clauses.bdds(), qdimacsToBdd.quantifications[0]->quantifiedVariables, maxClusterSize);
     return dd::BddWrapper(result, ddm);
   }
   
@@ -797,40 +866,64 @@ namespace oct_22 {
                          << " in " << blif_solve::duration(start) << " sec.");
   }
   
-  bdd_ptr computeExact(const dd::QdimacsToBdd& bdds)
+  bdd_ptr computeExact(const dd::QdimacsToBdd& bdds, int maxClusterSize)
   {
     auto startTime = blif_solve::now();
     blif_solve_log(INFO, "Computing exact result using Bdds");
     auto ddm = bdds.ddManager;
-    dd::BddWrapper conjunction(bdd_one(ddm), ddm);
-
 
-    std::unordered_map<int, std::unordered_set<bdd_ptr>> varToClauseMap;
-    std::unordered_set<bdd_ptr> alreadyConjoinedClauses;
-    for (const auto & clause: bdds.clauses)
-    {
-      for (auto lit : clause.first)
-          varToClauseMap[std::abs(lit)].insert(clause.second);
-    }
     if (bdds.quantifications.size() != 1 || bdds.quantifications[0]->quantifierType != dd::Quantifier::Exists)
       throw std::runtime_error("Expecting exactly one quantifier in qdimacs, which has to be Existential.");
     const auto & quantifiedVarIndices = bdds.quantifications[0]->quantifiedVarIndices;
-    for (const auto varIndex: quantifiedVarIndices)
+
+    // only the clauses with some quantified variable take part
+    std::vector<size_t> quantifiedClauses;
+    dd::VariableHypergraph quantifiedClauseVars;
+    std::vector<int> vars;
+    for (size_t ci = 0; ci < bdds.clauses.size(); ++ci)
     {
-      for (const auto quantifiedClause: varToClauseMap[varIndex])
+      bool isQuantified = false;
+      vars.clear();
+      for (auto lit = bdds.clauses.literalsBegin(ci); lit != bdds.clauses.literalsEnd(ci); ++lit)
+      {
+        vars.push_back(std::abs(*lit));
+        isQuantified = isQuantified || quantifiedVarIndices.count(vars.back()) > 0;
+      }
+      if (isQuantified)
       {
-        if (alreadyConjoinedClauses.count(quantifiedClause) > 0)
-          continue;
-        alreadyConjoinedClauses.insert(quantifiedClause);
-        blif_solve_log(DEBUG, "Conjoining clause");
-        conjunction = conjunction * dd::BddWrapper(bdd_dup(quantifiedClause), ddm);
+        quantifiedClauses.push_back(ci);
+        quantifiedClauseVars.addEdge(vars.data(), vars.data() + vars.size());
       }
-      blif_solve_log(DEBUG, "Eliminating variable " << varIndex);
-      conjunction = conjunction.existentialQuantification(dd::BddWrapper(bdd_new_var_with_index(ddm, varIndex), ddm));
     }
 
+    // clauses in different components share no variable,
+    // so each component can be quantified on its own
+    auto components = dd::partitionHypergraph(quantifiedClauseVars);
+    bdd_ptr result = bdd_one(ddm);
+    size_t numClusters = 0;
+    int peakBddSize = 0;
+    for (const auto & component: components)
+    {
+      std::vector<bdd_ptr> componentClauses;
+      componentClauses.reserve(component.size());
+      for (auto e: component)
+        componentClauses.push_back(bdds.clauses.bdd(quantifiedClauses[e]));
+      dd::AndExistsScheduleStats stats;
+      auto componentResult = dd::andExistsScheduled(ddm, componentClauses, bdds.quantifications[0]->quantifiedVariables, maxClusterSize, &stats);
+      numClusters += stats.numClusters;
+      peakBddSize = std::max(peakBddSize, stats.peakBddSize);
+      auto conjunction = bdd_and(ddm, result, componentResult);
+      bdd_free(ddm, result);
+      bdd_free(ddm, componentResult);
+      result = conjunction;
+      if (bdd_is_zero(ddm, result))
+        break;
+    }
+    blif_solve_log(DEBUG, "Conjoined " << quantifiedClauses.size() << " clauses in " << components.size()
+                          << " components and " << numClusters << " clusters, peak bdd size " << peakBddSize);
+
     blif_solve_log(INFO, "Computed exact result in " << blif_solve::duration(startTime) << " sec");
-    return conjunction.getCountedBdd();
+    return result;
   }
 
   class VerbosityCapture {
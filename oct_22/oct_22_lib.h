@@ -29,7 +29,11 @@ SOFTWARE.
 #include <blif_solve_lib/cnf_dump.h>
 #include <blif_solve_lib/log.h>
 
+#include <dd/and_exists_schedule.h>
+#include <dd/bdd_partition.h>
+#include <dd/manager_factory.h>
 #include <dd/qdimacs_to_bdd.h>
+#include <dd/variable_order.h>
 
 #include <factor_graph/fgpp.h>
 
@@ -53,6 +57,13 @@ namespace oct_22 {
         bool runMusTool;
         bool runFg;
         bool mustMinimalizeAssignments;
+        int maxClusterSize;
+        dd::VariableOrdering variableOrdering;
+        dd::ManagerOptions managerOptions;
+        int fgThreads;
+        fgpp::Schedule fgSchedule;
+        long long fgMaxUpdates;
+        fgpp::MessageComputation fgMessages;
         std::optional<std::string> musResultFile() const;
     };
 
@@ -106,7 +117,7 @@ namespace oct_22 {
     // function declarations
     CommandLineOptions parseClo(int argc, char const * const * const argv);
 
-    std::shared_ptr<DdManager> ddm_init();
+    std::shared_ptr<DdManager> ddm_init(dd::ManagerOptions const & managerOptions);
     fgpp::FactorGraph::Ptr createFactorGraph(DdManager* ddm, const dd::QdimacsToBdd& qdimacsToBdd, int largestSupportSet, int largestBddSize);
     std::shared_ptr<dd::Qdimacs> parseQdimacs(const std::string & inputFilePath);
     std::shared_ptr<Master> createMustMaster(const dd::Qdimacs& qdimacs,
@@ -114,7 +125,7 @@ namespace oct_22 {
                                              bool mustMinimalizeAssignments,
                                              std::optional<std::string> const& musResultFile);
     std::vector<dd::BddWrapper> getFactorGraphResults(DdManager* ddm, const fgpp::FactorGraph& fg, const dd::QdimacsToBdd& qdimacsToBdd);
-    dd::BddWrapper getExactResult(DdManager* ddm, const dd::QdimacsToBdd& qdimacsToBdd);
+    dd::BddWrapper getExactResult(DdManager* ddm, const dd::QdimacsToBdd& qdimacsToBdd, int maxClusterSize = dd::DefaultMaxClusterSize);
     Oct22MucCallback::CnfPtr convertToCnf(DdManager* ddm, 
                                           int numVariables, 
                                           const std::vector<dd::BddWrapper> & funcs);
@@ -122,8 +133,8 @@ namespace oct_22 {
     void writeResult(const Oct22MucCallback::Cnf& cnf,
                      const dd::Qdimacs& qdimacs,
                      const std::string& outputFile);
-    bdd_ptr computeExact(const dd::QdimacsToBdd& qdimacsToBdd);
-    bdd_ptr cnfToBdd(const dd::QdimacsToBdd& qdimacsToBdd, const Oct22MucCallback::Cnf& fgMustResult);
+    bdd_ptr computeExact(const dd::QdimacsToBdd& qdimacsToBdd, int maxClusterSize = dd::DefaultMaxClusterSize);
+    bdd_ptr cnfToBdd(const dd::QdimacsToBdd& qdimacsToBdd, const Oct22MucCallback::Cnf& fgMustResult, int maxClusterSize = dd::DefaultMaxClusterSize);
 
 
     template<typename TVecOfVecIt, typename TVec, typename TFunc>
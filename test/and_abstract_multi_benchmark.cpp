@@ -0,0 +1,174 @@
+/*
+
+Copyright 2026 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+
+// std includes
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+
+// dd includes
+#include <dd/dd.h>
+#include <dd/cuddAndAbsMulti.h>
+
+
+// blif_solve_lib includes
+#include <blif_solve_lib/command_line_options.h>
+#include <blif_solve_lib/log.h>
+
+
+// test includes
+#include "random_bdd_generator.h"
+
+
+
+// ******************************************
+// *** global allocation counting support ***
+// ******************************************
+namespace {
+  std::atomic<unsigned long long> numAllocations(0);
+} // end anonymous namespace
+
+void * operator new(size_t size)
+{
+  ++numAllocations;
+  if (void * p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void * p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void * p, size_t) noexcept
+{
+  std::free(p);
+}
+
+
+
+
+// Measures heap allocations and run time of
+// Cudd_bddAndMulti and Cudd_bddAndAbstractMulti
+// on random factors.
+int main(int argc, char const * const * const argv)
+{
+  using blif_solve::CommandLineOptionValue;
+
+  auto numFactorsClo = CommandLineOptionValue<int>::create("--num_factors", "Number of factors (default 40)", 40);
+  auto numVarsClo = CommandLineOptionValue<int>::create("--num_vars", "Number of vars (default 20)", 20);
+  auto seedClo = CommandLineOptionValue<int>::create("--seed", "Seed for randomization", 20200123);
+  auto probVarInClauseClo  = CommandLineOptionValue<double>::create("--prob_var_in_clause", "Probability for selecting a variable into a clause (default 0.3)",  0.3);
+  auto avgSupportSetSizeClo  = CommandLineOptionValue<int>::create("--avg_support_set_size", "Average size of factor support sets (default 6)", 6);
+  auto numClausesInFunctionClo = CommandLineOptionValue<int>::create("--num_clauses_in_function", "Number of clauses in each function (default 4)", 4);
+  auto numVarsToQuantifyClo = CommandLineOptionValue<int>::create("--num_vars_to_quantify", "Number of vars to existentially quantify away (default num_vars / 2)", -1);
+  auto cacheSizeClo = CommandLineOptionValue<int>::create("--cache_size", "Cap on the number of memo table slots (default 100000)", 100 * 1000);
+  auto repetitionsClo = CommandLineOptionValue<int>::create("--repetitions", "Number of times each operation is timed (default 5)", 5);
+  auto persistentCacheClo = CommandLineOptionValue<int>::create("--persistent_cache", "1 to share one memo table across the repetitions (default 0)", 0);
+  auto verbosityClo = CommandLineOptionValue<std::string>::create("--verbosity", "QUIET/ERROR/WARN/INFO/DEBUG (default INFO)", "INFO");
+
+  std::vector<std::shared_ptr<blif_solve::ICommandLineOption> > options{ numFactorsClo, numVarsClo, seedClo,
+                                                                         probVarInClauseClo, avgSupportSetSizeClo,
+                                                                         numClausesInFunctionClo, numVarsToQuantifyClo,
+                                                                         cacheSizeClo, repetitionsClo, persistentCacheClo,
+                                                                         verbosityClo };
+  blif_solve::parseCommandLineOptions(argc - 1, argv + 1, options);
+
+  int numVars = numVarsClo->getValue();
+  int numVarsToQuantify = numVarsToQuantifyClo->getValue();
+  if (numVarsToQuantify < 0) numVarsToQuantify = numVars / 2;
+  int numClausesInFunction = numClausesInFunctionClo->getValue();
+  int cacheSize = cacheSizeClo->getValue();
+  int repetitions = std::max(1, repetitionsClo->getValue());
+  blif_solve::setVerbosity(blif_solve::parseVerbosity(verbosityClo->getValue()));
+
+  blif_solve_log(INFO, "generating factors");
+  DdManager * manager = Cudd_Init(0, 0, 256, 262144, 0);
+  test::RandomBddGenerator bddGen(manager, numVars, seedClo->getValue(), probVarInClauseClo->getValue(),
+                                  avgSupportSetSizeClo->getValue(), numClausesInFunction,
+                                  numClausesInFunction);
+  auto factors = bddGen.generateFactors(numFactorsClo->getValue());
+  bdd_ptr varsToQuantify = bddGen.getVarsToQuantify(numVarsToQuantify);
+  blif_solve_log(INFO, "generated " << factors.size() << " factors");
+  if (persistentCacheClo->getValue() && !Cudd_MultiCacheEnable(manager, cacheSize))
+    throw std::runtime_error("Could not enable the persistent multi cache");
+
+  auto measure = [&](std::string const & name, bool isAbstract, bool decompose) {
+    double totalSeconds = 0;
+    unsigned long long allocations = 0;
+    Cudd_MultiStats stats;
+    bdd_ptr result = NULL;
+    for (int i = 0; i < repetitions; ++i)
+    {
+      auto start = blif_solve::now();
+      auto allocationsBefore = numAllocations.load();
+      result = isAbstract
+        ? Cudd_bddAndAbstractMulti(manager, factors, varsToQuantify, cacheSize, decompose ? 1 : 0, &stats)
+        : Cudd_bddAndMulti(manager, factors, cacheSize, &stats);
+      allocations = numAllocations.load() - allocationsBefore;
+      totalSeconds += blif_solve::duration(start);
+      if (NULL == result)
+        throw std::runtime_error(name + " failed");
+      Cudd_Ref(result);
+      bdd_free(manager, result);
+    }
+    std::cout << name << ":\n"
+              << "  time per call (s)           = " << totalSeconds / repetitions << "\n"
+              << "  recursions                  = " << stats.recursions << "\n"
+              << "  component decompositions    = " << stats.decompositions << "\n"
+              << "  memo table slots            = " << stats.cacheSlots << "\n"
+              << "  memo table hit rate         = " << (stats.cacheLookups ? static_cast<double>(stats.cacheHits) / stats.cacheLookups : 0.0) << "\n"
+              << "  heap allocations per call   = " << allocations << "\n"
+              << "  heap allocations/recursion  = " << (stats.recursions ? static_cast<double>(allocations) / stats.recursions : 0.0) << std::endl;
+  };
+
+  measure("Cudd_bddAndMulti", false, false);
+  measure("Cudd_bddAndAbstractMulti", true, false);
+  measure("Cudd_bddAndAbstractMulti (decompose components)", true, true);
+
+  Cudd_MultiCacheStats cacheStats;
+  if (Cudd_MultiCacheReadStats(manager, &cacheStats))
+  {
+    std::cout << "persistent cache:\n"
+              << "  and hits / lookups          = " << cacheStats.andHits << " / " << cacheStats.andLookups << "\n"
+              << "  flushes on gc/reordering    = " << cacheStats.hookFlushes << std::endl;
+    Cudd_MultiCacheDisable(manager);
+  }
+
+  bdd_free(manager, varsToQuantify);
+  for (auto factor: factors)
+    bdd_free(manager, factor);
+
+  blif_solve_log(INFO, "DONE");
+  return 0;
+}
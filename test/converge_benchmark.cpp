@@ -0,0 +1,154 @@
+/*
+
+Copyright 2026 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+
+
+// std includes
+#include <atomic>
+#include <dlfcn.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+// dd includes
+#include <dd/dd.h>
+#include <dd/bdd_factory.h>
+
+
+// factor_graph includes
+#include <factor_graph/fgpp.h>
+
+
+// blif_solve_lib includes
+#include <blif_solve_lib/command_line_options.h>
+#include <blif_solve_lib/log.h>
+
+
+// test includes
+#include "random_bdd_generator.h"
+
+
+
+// ************************************************
+// *** reference count traffic counting support ***
+// ************************************************
+// Cudd_Ref and Cudd_RecursiveDeref are interposed,
+// counted, and forwarded to the cudd library.
+namespace {
+  // atomic, since convergeParallel refs bdds from several threads
+  std::atomic<unsigned long long> numRefs(0);
+  std::atomic<unsigned long long> numDerefs(0);
+} // end anonymous namespace
+
+void Cudd_Ref(DdNode * n)
+{
+  typedef void (*RefFunc)(DdNode *);
+  static RefFunc real = reinterpret_cast<RefFunc>(dlsym(RTLD_NEXT, "Cudd_Ref"));
+  ++numRefs;
+  real(n);
+}
+
+void Cudd_RecursiveDeref(DdManager * manager, DdNode * n)
+{
+  typedef void (*DerefFunc)(DdManager *, DdNode *);
+  static DerefFunc real = reinterpret_cast<DerefFunc>(dlsym(RTLD_NEXT, "Cudd_RecursiveDeref"));
+  ++numDerefs;
+  real(manager, n);
+}
+
+
+
+
+// Measures the run time and the reference count traffic
+// of fgpp::FactorGraph::converge (or convergeParallel, with --threads)
+// on random factors, with the messages computed as chosen by --messages.
+int main(int argc, char const * const * const argv)
+{
+  using blif_solve::CommandLineOptionValue;
+
+  auto numFactorsClo = CommandLineOptionValue<int>::create("--num_factors", "Number of factors (default 60)", 60);
+  auto numVarsClo = CommandLineOptionValue<int>::create("--num_vars", "Number of vars (default 40)", 40);
+  auto seedClo = CommandLineOptionValue<int>::create("--seed", "Seed for randomization", 20200123);
+  auto probVarInClauseClo  = CommandLineOptionValue<double>::create("--prob_var_in_clause", "Probability for selecting a variable into a clause (default 0.3)",  0.3);
+  auto avgSupportSetSizeClo  = CommandLineOptionValue<int>::create("--avg_support_set_size", "Average size of factor support sets (default 5)", 5);
+  auto numClausesInFunctionClo = CommandLineOptionValue<int>::create("--num_clauses_in_function", "Number of clauses in each function (default 3)", 3);
+  auto repetitionsClo = CommandLineOptionValue<int>::create("--repetitions", "Number of times converge is timed (default 5)", 5);
+  auto threadsClo = CommandLineOptionValue<int>::create("--threads", "Number of threads converging the factor graph (default 1)", 1);
+  auto messagesClo = CommandLineOptionValue<std::string>::create("--messages", "How messages are computed: conjoin/andabstract/shared (default conjoin)", "conjoin");
+  auto verbosityClo = CommandLineOptionValue<std::string>::create("--verbosity", "QUIET/ERROR/WARN/INFO/DEBUG (default INFO)", "INFO");
+
+  std::vector<std::shared_ptr<blif_solve::ICommandLineOption> > options{ numFactorsClo, numVarsClo, seedClo,
+                                                                         probVarInClauseClo, avgSupportSetSizeClo,
+                                                                         numClausesInFunctionClo, repetitionsClo,
+                                                                         threadsClo, messagesClo, verbosityClo };
+  blif_solve::parseCommandLineOptions(argc - 1, argv + 1, options);
+  int repetitions = std::max(1, repetitionsClo->getValue());
+  blif_solve::setVerbosity(blif_solve::parseVerbosity(verbosityClo->getValue()));
+
+  blif_solve_log(INFO, "generating factors");
+  DdManager * manager = Cudd_Init(0, 0, 256, 262144, 0);
+  int numClausesInFunction = numClausesInFunctionClo->getValue();
+  {
+    test::RandomBddGenerator bddGen(manager, numVarsClo->getValue(), seedClo->getValue(), probVarInClauseClo->getValue(),
+                                    avgSupportSetSizeClo->getValue(), numClausesInFunction,
+                                    numClausesInFunction);
+    std::vector<dd::BddWrapper> factors;
+    for (auto f: bddGen.generateFactors(numFactorsClo->getValue()))
+      factors.emplace_back(f, manager);
+    blif_solve_log(INFO, "generated " << factors.size() << " factors");
+
+    auto fg = fgpp::FactorGraph::createFactorGraph(factors);
+    fg->setMessageComputation(fgpp::parseMessageComputation(messagesClo->getValue()));
+    double totalSeconds = 0;
+    unsigned long long refs = 0, derefs = 0;
+    int numIterations = 0;
+    int numThreads = threadsClo->getValue();
+    for (int i = 0; i < repetitions; ++i)
+    {
+      auto refsBefore = numRefs.load(), derefsBefore = numDerefs.load();
+      auto start = blif_solve::now();
+      numIterations = numThreads > 1 ? fg->convergeParallel(numThreads) : fg->converge();
+      totalSeconds += blif_solve::duration(start);
+      refs += numRefs - refsBefore;
+      derefs += numDerefs - derefsBefore;
+    }
+    if (numThreads > 1)
+      std::cout << "FactorGraph::convergeParallel (" << numThreads << " threads):\n";
+    else
+      std::cout << "FactorGraph::converge:\n";
+    std::cout
+              << "  iterations                  = " << numIterations << "\n"
+              << "  time per call (s)           = " << totalSeconds / repetitions << "\n"
+              << "  Cudd_Ref per call           = " << refs / repetitions << "\n"
+              << "  Cudd_RecursiveDeref per call= " << derefs / repetitions << "\n"
+              << "  peak live nodes             = " << Cudd_ReadPeakLiveNodeCount(manager) << std::endl;
+  }
+
+  blif_solve_log(INFO, "DONE");
+  return 0;
+}
@@ -0,0 +1,166 @@
+/*
+
+Copyright 2026 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+
+
+// std includes
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+// dd includes
+#include <dd/dd.h>
+#include <dd/lru_cache.h>
+#include <dd/node_set_cache.h>
+
+
+// blif_solve_lib includes
+#include <blif_solve_lib/command_line_options.h>
+#include <blif_solve_lib/log.h>
+
+
+
+namespace {
+
+  typedef std::vector<DdNode *> NodeVector;
+
+  struct NodeVectorHash
+  {
+    size_t operator()(NodeVector const & v) const
+    {
+      size_t h = v.size();
+      for (auto n: v)
+        h = h * 0x9e3779b97f4a7c15ull + reinterpret_cast<uintptr_t>(n);
+      return h ^ (h >> 29);
+    }
+  };
+
+} // end anonymous namespace
+
+
+
+
+// Measures lookups and inserts of the memo tables
+// (LruCache bounded by entries or by bytes, and NodeSetCache)
+// on a skewed stream of node set keys, like the ones
+// of the multi-operand bdd operations.
+int main(int argc, char const * const * const argv)
+{
+  using blif_solve::CommandLineOptionValue;
+
+  auto numKeysClo = CommandLineOptionValue<int>::create("--num_keys", "Number of distinct keys (default 200000)", 200 * 1000);
+  auto maxKeyLengthClo = CommandLineOptionValue<int>::create("--max_key_length", "Largest number of nodes in a key (default 32)", 32);
+  auto numOperationsClo = CommandLineOptionValue<int>::create("--num_operations", "Number of lookups (default 2000000)", 2 * 1000 * 1000);
+  auto capacityClo = CommandLineOptionValue<int>::create("--capacity", "Number of entries / slots of each cache (default 50000)", 50 * 1000);
+  auto skewClo = CommandLineOptionValue<double>::create("--skew", "Mean of the geometric key distribution, as a fraction of num_keys (default 0.1)", 0.1);
+  auto seedClo = CommandLineOptionValue<int>::create("--seed", "Seed for randomization", 20200123);
+  auto verbosityClo = CommandLineOptionValue<std::string>::create("--verbosity", "QUIET/ERROR/WARN/INFO/DEBUG (default INFO)", "INFO");
+
+  std::vector<std::shared_ptr<blif_solve::ICommandLineOption> > options{ numKeysClo, maxKeyLengthClo, numOperationsClo,
+                                                                         capacityClo, skewClo, seedClo, verbosityClo };
+  blif_solve::parseCommandLineOptions(argc - 1, argv + 1, options);
+  blif_solve::setVerbosity(blif_solve::parseVerbosity(verbosityClo->getValue()));
+
+  int const numKeys = std::max(1, numKeysClo->getValue());
+  int const capacity = std::max(1, capacityClo->getValue());
+
+  blif_solve_log(INFO, "generating keys");
+  std::default_random_engine randEng(seedClo->getValue());
+  std::uniform_int_distribution<int> lengthGen(2, std::max(2, maxKeyLengthClo->getValue()));
+  std::uniform_int_distribution<uintptr_t> nodeGen(1, 1 << 20);
+  std::vector<NodeVector> keys(numKeys);
+  for (auto & key: keys)
+  {
+    key.resize(lengthGen(randEng));
+    for (auto & node: key)
+      node = reinterpret_cast<DdNode *>(nodeGen(randEng) * 16);
+    std::sort(key.begin(), key.end());
+  }
+  std::geometric_distribution<int> keyGen(1.0 / std::max(1.0, skewClo->getValue() * numKeys));
+  std::vector<int> stream(numOperationsClo->getValue());
+  for (auto & k: stream)
+    k = keyGen(randEng) % numKeys;
+
+  auto report = [&](std::string const & name, double seconds, unsigned long long hits) {
+    std::cout << name << ":\n"
+              << "  time per operation (ns)     = " << 1e9 * seconds / stream.size() << "\n"
+              << "  hit rate                    = " << static_cast<double>(hits) / stream.size() << std::endl;
+  };
+
+  // values are the keys' first nodes, so that hits can be checked
+  auto runLru = [&](std::string const & name, int maxEntries, size_t byteBudget) {
+    parakram::LruCache<NodeVector, DdNode *, NodeVectorHash> cache(maxEntries, byteBudget);
+    unsigned long long hits = 0;
+    auto start = blif_solve::now();
+    for (int k: stream)
+    {
+      auto cached = cache.tryGet(keys[k]);
+      if (cached.isPresent())
+      {
+        if (cached.get() != keys[k][0])
+          throw std::runtime_error(name + " returned a wrong value");
+        ++hits;
+      }
+      else
+        cache.insert(keys[k], keys[k][0]);
+    }
+    report(name, blif_solve::duration(start), hits);
+    std::cout << "  entries / bytes             = " << cache.size() << " / " << cache.numBytes() << std::endl;
+  };
+
+  runLru("LruCache (bounded by entries)", capacity, 0);
+  parakram::LruCacheSizer<NodeVector, DdNode *> sizer;
+  size_t const averageBytes = sizer(NodeVector((2 + maxKeyLengthClo->getValue()) / 2), NULL);
+  runLru("LruCache (bounded by bytes)", -1, capacity * averageBytes);
+
+  {
+    parakram::NodeSetCache<DdNode *, DdNode *> cache(capacity);
+    unsigned long long hits = 0;
+    auto start = blif_solve::now();
+    for (int k: stream)
+    {
+      auto cached = cache.tryGet(keys[k].data(), keys[k].size(), NULL);
+      if (cached.isPresent())
+      {
+        if (cached.get() != keys[k][0])
+          throw std::runtime_error("NodeSetCache returned a wrong value");
+        ++hits;
+      }
+      else
+        cache.insert(keys[k].data(), keys[k].size(), NULL, keys[k][0]);
+    }
+    report("NodeSetCache", blif_solve::duration(start), hits);
+  }
+
+  blif_solve_log(INFO, "DONE");
+  return 0;
+}
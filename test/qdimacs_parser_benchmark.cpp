@@ -0,0 +1,177 @@
+/*
+
+Copyright 2026 Parakram Majumdar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+// std includes
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+// dd includes
+#include <dd/qdimacs.h>
+
+
+// blif_solve_lib includes
+#include <blif_solve_lib/command_line_options.h>
+#include <blif_solve_lib/log.h>
+
+
+// jan_24 includes
+#include <jan_24/cnf_sax_parser.h>
+
+
+
+// Counts the clauses and hashes the literals in the order they are delivered,
+// to check that the sax parsing modes agree with each other.
+class ClauseHasher: public jan_24::ICnfSaxParser
+{
+  public:
+    size_t numClauses = 0;
+    size_t hash = 0;
+
+    void parseComment(std::string_view) override { }
+    void parsePHeader(std::string_view, int, int) override { }
+    void parseQuantifierLine(std::string_view, char, jan_24::LiteralSpan) override { }
+    void parseClause(std::string_view, jan_24::LiteralSpan literalsTerminatedWithZero) override
+    {
+      ++numClauses;
+      for (int literal: literalsTerminatedWithZero)
+        hash = hash * 1000003 + static_cast<size_t>(literal);
+    }
+};
+
+
+// Compares the throughput of the stream based Qdimacs parser
+// with the memory mapped flat parser, and of the sax parser
+// on a stream with the chunked parser on one and on all threads, on each input file
+// (a comma separated list, defaulting to the test/data inputs).
+int main(int argc, char const * const * const argv)
+{
+  using blif_solve::CommandLineOptionValue;
+
+  auto inputsClo = CommandLineOptionValue<std::string>::create("--inputs", "Comma separated list of qdimacs files (default: the test/data inputs)",
+      "test/data/adder.qdimacs,test/data/Factorization_factorization8_factor_graph_input.qdimacs,test/data/simplify_qdimacs.qdimacs");
+  auto numRepeatsClo = CommandLineOptionValue<int>::create("--num_repeats", "Number of times each file is parsed by each parser (default 10)", 10);
+  auto numThreadsClo = CommandLineOptionValue<int>::create("--num_threads", "Number of threads for the chunked sax parser (default 0, one per hardware thread)", 0);
+  auto verbosityClo = CommandLineOptionValue<std::string>::create("--verbosity", "QUIET/ERROR/WARN/INFO/DEBUG (default INFO)", "INFO");
+
+  std::vector<std::shared_ptr<blif_solve::ICommandLineOption> > options{ inputsClo, numRepeatsClo, numThreadsClo, verbosityClo };
+  blif_solve::parseCommandLineOptions(argc - 1, argv + 1, options);
+  blif_solve::setVerbosity(blif_solve::parseVerbosity(verbosityClo->getValue()));
+
+  int const numRepeats = std::max(1, numRepeatsClo->getValue());
+  std::stringstream inputsSs(inputsClo->getValue());
+  std::string path;
+  while (std::getline(inputsSs, path, ','))
+  {
+    if (path.empty())
+      continue;
+    std::ifstream sizeStream(path, std::ios::binary | std::ios::ate);
+    if (!sizeStream)
+      throw std::runtime_error("Could not open file '" + path + "'");
+    double const megaBytes = sizeStream.tellg() / 1e6;
+
+    std::shared_ptr<dd::Qdimacs> expected;
+    auto start = blif_solve::now();
+    for (int i = 0; i < numRepeats; ++i)
+    {
+      std::ifstream fin(path);
+      expected = dd::Qdimacs::parseQdimacs(fin);
+    }
+    double const streamSeconds = blif_solve::duration(start) / numRepeats;
+
+    std::shared_ptr<dd::FlatQdimacs> flat;
+    start = blif_solve::now();
+    for (int i = 0; i < numRepeats; ++i)
+      flat = dd::FlatQdimacs::parseFile(path);
+    double const flatSeconds = blif_solve::duration(start) / numRepeats;
+
+    std::shared_ptr<dd::Qdimacs> adapted;
+    start = blif_solve::now();
+    for (int i = 0; i < numRepeats; ++i)
+      adapted = dd::Qdimacs::parseQdimacsFile(path);
+    double const adaptedSeconds = blif_solve::duration(start) / numRepeats;
+
+    if (adapted->numVariables != expected->numVariables
+        || !(adapted->quantifiers == expected->quantifiers)
+        || adapted->clauses != expected->clauses)
+      throw std::runtime_error("The parsers disagree on '" + path + "'");
+
+    ClauseHasher saxStream;
+    start = blif_solve::now();
+    for (int i = 0; i < numRepeats; ++i)
+    {
+      saxStream = ClauseHasher();
+      std::ifstream fin(path);
+      saxStream.parse(fin);
+    }
+    double const saxStreamSeconds = blif_solve::duration(start) / numRepeats;
+
+    ClauseHasher saxSequential;
+    start = blif_solve::now();
+    for (int i = 0; i < numRepeats; ++i)
+    {
+      saxSequential = ClauseHasher();
+      saxSequential.parseFile(path, 1);
+    }
+    double const saxSequentialSeconds = blif_solve::duration(start) / numRepeats;
+
+    ClauseHasher saxParallel;
+    start = blif_solve::now();
+    for (int i = 0; i < numRepeats; ++i)
+    {
+      saxParallel = ClauseHasher();
+      saxParallel.parseFile(path, numThreadsClo->getValue());
+    }
+    double const saxParallelSeconds = blif_solve::duration(start) / numRepeats;
+
+    if (saxStream.numClauses != flat->numClauses()
+        || saxSequential.numClauses != saxStream.numClauses || saxSequential.hash != saxStream.hash
+        || saxParallel.numClauses != saxStream.numClauses || saxParallel.hash != saxStream.hash)
+      throw std::runtime_error("The sax parsing modes disagree on '" + path + "'");
+
+    auto report = [&](std::string const & name, double seconds) {
+      std::cout << "  " << name << ": " << seconds << " sec, "
+                << megaBytes / seconds << " MB/sec, "
+                << flat->numClauses() / seconds << " clauses/sec" << std::endl;
+    };
+    std::cout << path << " (" << megaBytes << " MB, " << flat->numClauses() << " clauses, "
+              << flat->literals.size() << " literals):" << std::endl;
+    report("Qdimacs::parseQdimacs     ", streamSeconds);
+    report("FlatQdimacs::parseFile    ", flatSeconds);
+    report("Qdimacs::parseQdimacsFile ", adaptedSeconds);
+    report("ICnfSaxParser::parse      ", saxStreamSeconds);
+    report("ICnfSaxParser::parseFile 1", saxSequentialSeconds);
+    report("ICnfSaxParser::parseFile N", saxParallelSeconds);
+  }
+
+  blif_solve_log(INFO, "DONE");
+  return 0;
+}
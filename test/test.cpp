@@ -24,23 +24,42 @@ SOFTWARE.
 
 
 #include <dd/dd.h>
+#include <dd/and_exists_schedule.h>
 #include <dd/bdd_factory.h>
+#include <dd/cuddAndAbsMulti.h>
 #include <blif_solve_lib/cnf_dump.h>
 #include <dd/optional.h>
 #include <dd/lru_cache.h>
+#include <dd/manager_factory.h>
+#include <dd/multi_cache_scope.h>
+#include <dd/node_set_cache.h>
+#include <dd/small_vector.h>
+#include <dd/support_cache.h>
+#include <dd/var_set.h>
+#include <dd/variable_order.h>
+#include <dd/big_unsigned.h>
 #include <dd/max_heap.h>
 #include <blif_solve_lib/clo.hpp>
 #include <dd/dotty.h>
 #include <factor_graph/factor_graph.h>
 #include <dd/bdd_partition.h>
+#include <dd/disjoint_set.h>
 #include <factor_graph/fgpp.h>
 #include <dd/qdimacs.h>
 #include <dd/qdimacs_to_bdd.h>
+#include <jan_24/cnf_sax_parser.h>
 #include <oct_22/oct_22_lib.h>
+#include <blif_solve/divide_and_conquer.h>
 
+#include <algorithm>
+#include <numeric>
+#include <iterator>
 #include <memory>
+#include <set>
 #include <vector>
+#include <cstdio>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <random>
 #include <sstream>
@@ -52,12 +71,30 @@ SOFTWARE.
 
 void testOct22(DdManager * manager);
 void testCuddBddAndAbstractMulti(DdManager * manager);
+void testCuddBddAndMultiManyOperands(DdManager * manager);
+void testCuddBddAndAbstractMultiComponents(DdManager * manager);
+void testAndExistsScheduled(DdManager * manager);
+void testConjoinAll(DdManager * manager);
+void testBddWrapperMoves();
+void testCuddMultiCachePersistent(DdManager * manager);
+void testSupportCache(DdManager * manager);
+void testCuddBddAndAbstractMultiBudgeted(DdManager * manager);
+void testCuddBddClippingAndAbstractMultiAdaptive(DdManager * manager);
 void testCnfDump(DdManager * manager);
 void testIsConnectedComponent(DdManager * manager);
 void testCuddBddCountMintermsMulti(DdManager * manager);
+void testCuddBddCountMintermsMultiExactAndLog(DdManager * manager);
 void testOptional();
 void testLruCache();
+void testSmallVector();
+void testBigUnsigned();
+void testVarSet(DdManager * manager);
+void testVariableOrder();
+void testManagerFactory();
+void testSolveConcurrently();
+void testNodeSetCache();
 void testDisjointSet(DdManager * manager);
+void testIndexPartition();
 void testMaxHeap();
 void testClo();
 void testVarScoreQuantificationAlgo(DdManager * manager);
@@ -65,6 +102,7 @@ void testVarScoreFactorGraphInternals(DdManager * manager);
 void testDotty(DdManager * manager);
 void testFactorGraphImpl(DdManager * manager);
 void testQdimacsParser(DdManager* manager);
+void testCnfSaxParser();
 
 DdNode * makeFunc(DdManager * manager, int const numVars, int const funcAsIntger);
 
@@ -77,12 +115,30 @@ int main()
     testAve2(manager);
     testApproxVarElim(manager);
     testCuddBddCountMintermsMulti(manager);
+    testCuddBddCountMintermsMultiExactAndLog(manager);
     testCuddBddAndAbstractMulti(manager);
+    testCuddBddAndMultiManyOperands(manager);
+    testCuddBddAndAbstractMultiComponents(manager);
+    testAndExistsScheduled(manager);
+    testConjoinAll(manager);
+    testBddWrapperMoves();
+    testCuddMultiCachePersistent(manager);
+    testSupportCache(manager);
+    testCuddBddAndAbstractMultiBudgeted(manager);
+    testCuddBddClippingAndAbstractMultiAdaptive(manager);
     testCnfDump(manager);
     testIsConnectedComponent(manager);
     testOptional();
     testLruCache();
+    testSmallVector();
+    testBigUnsigned();
+    testVarSet(manager);
+    testVariableOrder();
+    testManagerFactory();
+    testSolveConcurrently();
+    testNodeSetCache();
     testDisjointSet(manager);
+    testIndexPartition();
     testMaxHeap();
     testApproxMerge(manager);
     testClo();
@@ -92,6 +148,7 @@ int main()
     testDotty(manager);
     testFactorGraphImpl(manager);
     testQdimacsParser(manager);
+    testCnfSaxParser();
     testOct22(manager);
 
     std::cout << "SUCCESS" << std::endl;
@@ -152,6 +209,109 @@ void testQdimacsParser(DdManager* manager)
          { -2, 4 }
        };
   assert(qd->clauses == expectedClauses);
+
+  // the flat parser agrees with the stream parser
+  auto flat = FlatQdimacs::parse(cnf1.data(), cnf1.data() + cnf1.size());
+  assert(flat->numVariables == 4 && flat->numClauses() == 7 && flat->clauseSize(3) == 3);
+  assert(flat->quantifiers == qd->quantifiers);
+  assert(flat->toQdimacs()->clauses == expectedClauses);
+
+  // crlf line ends, blank lines, and a missing final newline
+  std::string cnf2 = "c crlf\r\np cnf 3 2\r\n\r\ne 1 2 0\r\n1 -2 0\r\n  3 0";
+  auto flat2 = FlatQdimacs::parse(cnf2.data(), cnf2.data() + cnf2.size());
+  assert(flat2->numVariables == 3 && flat2->quantifiers.size() == 1);
+  assert((flat2->toQdimacs()->clauses == std::vector<std::vector<int> >{ { 1, -2 }, { 3 } }));
+
+  // malformed literals are rejected
+  for (std::string bad: { std::string("p cnf 2 1\n1 x 0\n"), std::string("p cnf 2 1\n1 99999999999 0\n"), std::string("p dnf 2 1\n") })
+  {
+    bool threw = false;
+    try { FlatQdimacs::parse(bad.data(), bad.data() + bad.size()); }
+    catch (std::invalid_argument const &) { threw = true; }
+    if (!threw)
+      throw std::runtime_error("FlatQdimacs::parse accepted malformed input '" + bad + "'");
+  }
+
+  // memory mapped files give the same result as streams
+  for (std::string path: { "test/data/adder.qdimacs", "test/data/Factorization_factorization8_factor_graph_input.qdimacs" })
+  {
+    std::ifstream fin(path);
+    auto expected = Qdimacs::parseQdimacs(fin);
+    auto actual = Qdimacs::parseQdimacsFile(path);
+    if (actual->numVariables != expected->numVariables
+        || !(actual->quantifiers == expected->quantifiers)
+        || actual->clauses != expected->clauses)
+      throw std::runtime_error("Qdimacs::parseQdimacsFile does not match Qdimacs::parseQdimacs on " + path);
+  }
+
+  // the sidecar cache round trips, and is ignored once the text changes
+  {
+    const char * tmpDir = std::getenv("TMPDIR");
+    std::string path = std::string(tmpDir ? tmpDir : "/tmp") + "/testQdimacsParser.qdimacs";
+    std::string cachePath = FlatQdimacs::cachePath(path);
+    { std::ofstream fout(path); fout << cnf1; }
+    auto written = FlatQdimacs::parseFileAndWriteCache(path);
+    auto cached = FlatQdimacs::loadCache(cachePath, cnf1.data(), cnf1.data() + cnf1.size());
+    assert(cached);
+    assert(cached->numVariables == 4 && cached->quantifiers == qd->quantifiers);
+    assert(cached->literals == flat->literals && cached->clauseOffsets == flat->clauseOffsets);
+    assert(Qdimacs::parseQdimacsFile(path)->clauses == expectedClauses);
+
+    // a corrupt payload behind a valid header is rejected, and the text parsed instead
+    {
+      std::string cacheBytes;
+      { std::ifstream fin(cachePath, std::ios::binary); cacheBytes.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>()); }
+      std::string offsetBytes(reinterpret_cast<const char *>(flat->clauseOffsets.data()), flat->clauseOffsets.size() * sizeof(size_t));
+      size_t offsetsPos = cacheBytes.find(offsetBytes);
+      assert(offsetsPos != std::string::npos);
+      auto writeCacheBytes = [&](std::string const & bytes) {
+        std::ofstream fout(cachePath, std::ios::binary | std::ios::trunc);
+        fout << bytes;
+      };
+      auto corrupt = [&](size_t pos, const void * bytes, size_t numBytes) {
+        std::string corrupted(cacheBytes);
+        corrupted.replace(pos, numBytes, static_cast<const char *>(bytes), numBytes);
+        writeCacheBytes(corrupted);
+      };
+      // a middle clause offset past the literals
+      size_t badOffset = 1000;
+      corrupt(offsetsPos + 3 * sizeof(size_t), &badOffset, sizeof(size_t));
+      assert(!FlatQdimacs::loadCache(cachePath, cnf1.data(), cnf1.data() + cnf1.size()));
+      assert(Qdimacs::parseQdimacsFile(path)->clauses == expectedClauses);
+      // a middle clause offset going backwards
+      badOffset = 1;
+      corrupt(offsetsPos + 3 * sizeof(size_t), &badOffset, sizeof(size_t));
+      assert(!FlatQdimacs::loadCache(cachePath, cnf1.data(), cnf1.data() + cnf1.size()));
+      // a zero literal, which the text can never give
+      int badLiteral = 0;
+      corrupt(offsetsPos + offsetBytes.size() + 2 * sizeof(int), &badLiteral, sizeof(int));
+      assert(!FlatQdimacs::loadCache(cachePath, cnf1.data(), cnf1.data() + cnf1.size()));
+      // the untouched cache is still accepted
+      writeCacheBytes(cacheBytes);
+      assert(FlatQdimacs::loadCache(cachePath, cnf1.data(), cnf1.data() + cnf1.size()));
+    }
+
+    // literals beyond the header's number of variables are accepted
+    // by the text parser, and so by the cache
+    {
+      std::string cnf4 = "p cnf 2 2\ne 3 0\n1 -5 0\n3 0\n";
+      { std::ofstream fout(path); fout << cnf4; }
+      auto parsed = FlatQdimacs::parseFileAndWriteCache(path);
+      auto reloaded = FlatQdimacs::loadCache(cachePath, cnf4.data(), cnf4.data() + cnf4.size());
+      assert(reloaded);
+      assert(reloaded->numVariables == 2 && reloaded->quantifiers == parsed->quantifiers);
+      assert(reloaded->literals == parsed->literals && reloaded->clauseOffsets == parsed->clauseOffsets);
+    }
+
+    std::string cnf3 = cnf1 + "1 -3 0\n";
+    { std::ofstream fout(path); fout << cnf3; }
+    assert(!FlatQdimacs::loadCache(cachePath, cnf3.data(), cnf3.data() + cnf3.size()));
+    assert(FlatQdimacs::parseFile(path)->numClauses() == 8);
+    assert(!FlatQdimacs::loadCache(path + ".missing", cnf1.data(), cnf1.data() + cnf1.size()));
+    std::remove(path.c_str());
+    std::remove(cachePath.c_str());
+  }
+
   auto qtb = QdimacsToBdd::createFromQdimacs(manager, *qd);
   assert(qtb->numVariables == 4);
   assert(qtb->quantifications.size() == 3);
@@ -166,13 +326,155 @@ void testQdimacsParser(DdManager* manager)
   for (const auto & ecv: expectedClauses)
   {
     std::set<int> ecs(ecv.cbegin(), ecv.cend());
-    assert(qtb->clauses.count(ecs) == 1);
+    auto ci = qtb->clauses.find(ecs);
+    assert(ci != BddClauses::npos);
     BddWrapper ebc = c1.zero();
     for (auto v: ecv)
       ebc = ebc + (v > 0? VV(v) : -VV(-v));
-    assert(qtb->clauses[ecs] == ebc.getUncountedBdd());
+    assert(qtb->clauses.bdd(ci) == ebc.getUncountedBdd());
   }
 
+  // repeated literals, tautologies, repeated clauses and the empty clause
+  Qdimacs qd2{3, {}, {{2, 2, -3}, {1, -1, 2}, {}, {-3, 2}}};
+  auto qtb2 = QdimacsToBdd::createFromQdimacs(manager, qd2);
+  assert(qtb2->clauses.size() == 3);
+  assert(qtb2->clauses.bdd(0) == (VV(2) + -VV(3)).getUncountedBdd());
+  assert(qtb2->clauses.bdd(1) == c1.one().getUncountedBdd());
+  assert(qtb2->clauses.bdd(2) == c1.zero().getUncountedBdd());
+  assert(qtb2->clauses.find(std::set<int>{ 1, 2 }) == BddClauses::npos);
+
+}
+
+
+namespace {
+
+  // records every callback of a cnf sax parser as one line of text
+  class CnfSaxRecorder: public jan_24::ICnfSaxParser
+  {
+    public:
+      std::vector<std::string> events;
+
+      void parseComment(std::string_view line) override
+      {
+        events.push_back("c{" + std::string(line) + "}");
+      }
+      void parsePHeader(std::string_view line, int numVars, int numClauses) override
+      {
+        events.push_back("p{" + std::string(line) + "} " + std::to_string(numVars) + " " + std::to_string(numClauses));
+      }
+      void parseQuantifierLine(std::string_view line, char quantifier, jan_24::LiteralSpan literals) override
+      {
+        events.push_back(std::string(1, quantifier) + "{" + std::string(line) + "}" + literalsToString(literals));
+      }
+      void parseClause(std::string_view line, jan_24::LiteralSpan literals) override
+      {
+        events.push_back("l{" + std::string(line) + "}" + literalsToString(literals));
+      }
+
+    private:
+      static std::string literalsToString(jan_24::LiteralSpan literals)
+      {
+        std::string result;
+        for (int literal: literals)
+          result += " " + std::to_string(literal);
+        return result;
+      }
+  };
+
+  // the events of parseFile on text, and the error it raised, if any
+  std::pair<std::vector<std::string>, std::string> parseCnfFile(std::string const & text, int numThreads, size_t chunkSize)
+  {
+    const char * tmpDir = std::getenv("TMPDIR");
+    std::string path = std::string(tmpDir ? tmpDir : "/tmp") + "/testCnfSaxParser.qdimacs";
+    { std::ofstream fout(path, std::ios::binary); fout << text; }
+    CnfSaxRecorder recorder;
+    std::string error;
+    try { recorder.parseFile(path, numThreads, chunkSize); }
+    catch (std::runtime_error const & e) { error = e.what(); }
+    std::remove(path.c_str());
+    return std::make_pair(recorder.events, error);
+  }
+
+} // end anonymous namespace
+
+void testCnfSaxParser()
+{
+  // many lines, one longer than a chunk, with crlf and lf endings
+  std::string text = "c comment\r\np cnf 300 402 \r\na 1 2 0\ne 3 4 5 0\r\n";
+  std::vector<std::string> expected{ "c{c comment}", "p{p cnf 300 402} 300 402", "a{a 1 2 0} 1 2 0", "e{e 3 4 5 0} 3 4 5 0" };
+  std::string longLine, longEvent;
+  for (int i = 1; i <= 300; ++i)
+  {
+    longLine += std::to_string(i % 2 ? i : -i) + " ";
+    longEvent += " " + std::to_string(i % 2 ? i : -i);
+  }
+  text += longLine + "0\n";
+  expected.push_back("l{" + longLine + "0}" + longEvent + " 0");
+  for (int i = 1; i <= 400; ++i)
+  {
+    std::string clause = std::to_string(-i) + " " + std::to_string(i + 1) + " 0";
+    text += clause + (i % 3 ? "\n" : "\r\n");
+    expected.push_back("l{" + clause + "}" + " " + std::to_string(-i) + " " + std::to_string(i + 1) + " 0");
+  }
+  text += "\n-1 2 0"; // a blank line, and no final line break
+  expected.push_back("l{-1 2 0} -1 2 0");
+
+  {
+    CnfSaxRecorder recorder;
+    std::istringstream stream(text);
+    recorder.parse(stream);
+    assert(recorder.events == expected);
+  }
+  // chunks of a few lines, lexed on the calling thread or on a pool,
+  // cut right after every line break or well inside the lines
+  for (int numThreads: { 1, 3 })
+    for (size_t chunkSize: { size_t(1), size_t(7), size_t(64), jan_24::ICnfSaxParser::DefaultChunkSize })
+    {
+      auto result = parseCnfFile(text, numThreads, chunkSize);
+      assert(result.second.empty());
+      assert(result.first == expected);
+    }
+
+  // an error is raised only after all the lines before it have been delivered,
+  // even when later chunks have already been lexed
+  {
+    std::string bad = text.substr(0, text.find("-200 201 0")) + "x bad line\n" + text.substr(text.find("-200 201 0"));
+    size_t numBefore = std::find(expected.begin(), expected.end(), "l{-200 201 0} -200 201 0") - expected.begin();
+    std::vector<std::string> expectedBefore(expected.begin(), expected.begin() + numBefore);
+    for (int numThreads: { 1, 3 })
+      for (size_t chunkSize: { size_t(7), size_t(64), jan_24::ICnfSaxParser::DefaultChunkSize })
+      {
+        auto result = parseCnfFile(bad, numThreads, chunkSize);
+        assert(result.second == "Could not parse qdimacs line {x bad line}");
+        assert(result.first == expectedBefore);
+      }
+  }
+
+  // numbers that do not fit in an int are errors, the extremes are not
+  {
+    auto result = parseCnfFile("1 -2147483648 2147483647 0\n", 3, 4);
+    assert(result.second.empty());
+    assert((result.first == std::vector<std::string>{ "l{1 -2147483648 2147483647 0} 1 -2147483648 2147483647 0" }));
+    for (std::string bad: { "1 2147483648 0", "1 -2147483649 0", "1 99999999999999999999 0", "p cnf 2147483648 1", "e 1 4294967297 0" })
+    {
+      result = parseCnfFile("c before\n" + bad + "\n1 0\n", 3, 4);
+      assert(result.second == "Integer out of range in qdimacs line {" + bad + "}");
+      assert((result.first == std::vector<std::string>{ "c{c before}" }));
+    }
+  }
+
+  // p headers as the regex "p cnf ([0-9]*) ([0-9]*)" (case insensitive)
+  // matched them, empty numbers reading as 0
+  {
+    auto result = parseCnfFile("p CNF 3 2\np cnf  5 \n", 1, jan_24::ICnfSaxParser::DefaultChunkSize);
+    assert(result.second.empty());
+    assert((result.first == std::vector<std::string>{ "p{p CNF 3 2} 3 2", "p{p cnf  5} 0 5" }));
+    for (std::string bad: { "p cnf 3", "p cnf 3 2 1", "p dnf 3 2", "p cnf -3 2" })
+    {
+      result = parseCnfFile(bad + "\n", 1, jan_24::ICnfSaxParser::DefaultChunkSize);
+      assert(result.second == "Could not match p header line {" + bad + "}");
+    }
+  }
 }
 
 
@@ -457,6 +759,47 @@ void testDisjointSet(DdManager * manager)
 }
 
 
+void testIndexPartition()
+{
+  parakram::FlatDisjointSet ds(6);
+  assert(ds.find(4) == 4);
+  ds.computeUnion(1, 4);
+  ds.computeUnion(4, 5);
+  assert(ds.find(5) == ds.find(1));
+  assert(ds.find(0) != ds.find(1));
+
+  // clauses 0, 2, 4 share variables through 2 and 3, clause 3 is empty
+  std::string text = "p cnf 6 5\n"
+                     "1 -2 0\n"
+                     "5 6 0\n"
+                     "-3 2 0\n"
+                     "0\n"
+                     "3 4 0\n";
+  auto flat = dd::FlatQdimacs::parse(text.data(), text.data() + text.size());
+  std::vector<std::vector<size_t>> expected{ { 0, 2, 4 }, { 1 }, { 3 } };
+  assert(dd::partitionClauses(*flat) == expected);
+  assert(dd::partitionClauses(*flat->toQdimacs()) == expected);
+
+  // a long chain broken in a few places, big enough to be split across threads
+  std::mt19937 rng(7);
+  std::vector<int> names(300 * 1000);
+  std::iota(names.begin(), names.end(), 1);
+  std::shuffle(names.begin(), names.end(), rng);
+  dd::VariableHypergraph chain;
+  for (size_t i = 0; i + 1 < names.size(); ++i)
+  {
+    if (i % 100000 == 99999)
+      continue;
+    int link[] = { names[i], names[i + 1] };
+    chain.addEdge(link, link + 2);
+  }
+  auto sequential = dd::partitionHypergraph(chain, 1);
+  assert(sequential.size() == 3);
+  assert(sequential[0].size() == 99999);
+  assert(dd::partitionHypergraph(chain, 4) == sequential);
+}
+
+
 void testLruCache()
 {
   using namespace parakram;
@@ -484,6 +827,379 @@ void testLruCache()
     if (i > 0) assert(lc.tryGet(i).get() == ctos('a' + i - 1));
     assert(lc.tryGet(i + 1).get() == ctos('a' + i));
   }
+  assert(lc.size() == 3);
+  assert(!lc.insert(26, "z"));
+
+  // bounded by bytes: variable length keys take more room
+  typedef std::vector<int> Key;
+  struct KeyHash { size_t operator()(Key const & k) const { return k.size() * 31 + (k.empty() ? 0 : k[0]); } };
+  LruCacheSizer<Key, int> sizer;
+  Key shortKey{ 1 }, longKey(100, 2), otherKey{ 3 };
+  size_t const budget = sizer(shortKey, 0) + sizer(longKey, 0);
+  LruCache<Key, int, KeyHash> bc(-1, budget);
+  assert(bc.insert(shortKey, 1));
+  assert(bc.insert(longKey, 2));
+  assert(bc.size() == 2 && bc.numBytes() == budget);
+  assert(bc.tryGet(shortKey).get() == 1);
+  // the long key is now the least recently used, and makes room
+  assert(bc.insert(otherKey, 3));
+  assert(!bc.tryGet(longKey).isPresent());
+  assert(bc.tryGet(shortKey).get() == 1);
+  assert(bc.tryGet(otherKey).get() == 3);
+  assert(bc.numEvictions() == 1);
+  // an entry larger than the budget is still kept, on its own
+  assert(bc.insert(Key(1000, 4), 4));
+  assert(bc.size() == 1);
+  assert(bc.numEvictions() == 3);
+  bc.clear();
+  assert(bc.size() == 0 && bc.numBytes() == 0 && bc.numEvictions() == 0 && !bc.tryGet(otherKey).isPresent());
+
+  // many entries, forcing the hash table to grow
+  LruCache<int, int> big(1000);
+  for (int i = 0; i < 5000; ++i)
+    big.insert(i, -i);
+  assert(big.size() == 1000);
+  for (int i = 0; i < 5000; ++i)
+    assert(big.tryGet(i).isPresent() == (i >= 4000));
+
+  // capacity 0 caches nothing, a negative capacity is unbounded
+  LruCache<int, int> none(0);
+  assert(none.insert(1, 1));
+  assert(none.size() == 0 && !none.tryGet(1).isPresent());
+  LruCache<int, int> unbounded(-1);
+  for (int i = 0; i < 5000; ++i)
+    unbounded.insert(i, -i);
+  assert(unbounded.size() == 5000 && unbounded.numEvictions() == 0);
+}
+
+void testCuddBddCountMintermsMultiExactAndLog(DdManager * manager)
+{
+  const int numVars = 8;
+  const int numTests = 500;
+  const int numFuncsPerTest = 3;
+  std::default_random_engine randEng(24680);
+  std::uniform_int_distribution<int> funcGen(0, 0x7fffffff);
+  for (int itest = 0; itest < numTests; ++itest)
+  {
+    std::set<DdNode *> funcs;
+    for (int ifunc = 0; ifunc < numFuncsPerTest; ++ifunc)
+      funcs.insert(makeFunc(manager, numVars, funcGen(randEng) | funcGen(randEng)));
+
+    bdd_ptr conj = bdd_and_multi(manager, funcs, 100*1000);
+    const auto expected = bdd_count_minterm(manager, conj, numVars);
+    const auto exact = bdd_exact_count_minterm_multi(manager, funcs, numVars, 100*1000);
+    const auto logCount = bdd_log_count_minterm_multi(manager, funcs, numVars, 100*1000);
+    if (exact.toLongDouble() != expected || exact != bdd_exact_count_minterm(manager, conj, numVars))
+    {
+      std::stringstream ss;
+      ss << "bdd_exact_count_minterm_multi gave an answer (" << exact
+         << ") different from the expected answer (" << expected << ")";
+      throw std::runtime_error(ss.str());
+    }
+    if (expected == 0 ? logCount != -HUGE_VAL : std::abs(logCount - std::log2((double)expected)) > 1e-9)
+    {
+      std::stringstream ss;
+      ss << "bdd_log_count_minterm_multi gave an answer (" << logCount
+         << ") different from the expected answer (log2 of " << expected << ")";
+      throw std::runtime_error(ss.str());
+    }
+    bdd_free(manager, conj);
+    for (auto f: funcs)
+      bdd_free(manager, f);
+  }
+
+  // far more variables than a long double can count
+  const int manyVars = 40000;
+  auto x0 = bdd_new_var_with_index(manager, 0);
+  auto x1 = bdd_new_var_with_index(manager, 1);
+  auto notX1 = bdd_not(x1);
+  bdd_ptr_set funcs{ x0, notX1 };
+  if (bdd_exact_count_minterm_multi(manager, funcs, manyVars, 1000) != parakram::BigUnsigned::power2(manyVars - 2))
+    throw std::runtime_error("bdd_exact_count_minterm_multi failed for many variables");
+  if (bdd_log_count_minterm_multi(manager, funcs, manyVars, 1000) != manyVars - 2)
+    throw std::runtime_error("bdd_log_count_minterm_multi failed for many variables");
+  bdd_free(manager, x0);
+  bdd_free(manager, x1);
+  bdd_free(manager, notX1);
+}
+
+void testSmallVector()
+{
+  using namespace parakram;
+  SmallVector<int, 4> sv;
+  assert(sv.empty());
+  for (int i = 10; i > 0; --i)
+  {
+    sv.push_back(i % 7);
+    assert(sv.isInline() == (sv.size() <= 4));
+  }
+  assert(sv.size() == 10);
+  sv.sortUnique();
+  assert((std::vector<int>(sv.begin(), sv.end()) == std::vector<int>{0, 1, 2, 3, 4, 5, 6}));
+  sv.erase(3);
+  assert((std::vector<int>(sv.begin(), sv.end()) == std::vector<int>{0, 1, 2, 4, 5, 6}));
+
+  auto copy = sv;
+  copy[0] = 100;
+  assert(sv[0] == 0);
+  assert(copy.size() == sv.size());
+
+  // capacity is kept across clear, so re-filling does not spill again
+  sv.clear();
+  assert(sv.empty() && !sv.isInline());
+  sv.push_back(42);
+  assert(sv.size() == 1 && sv.back() == 42);
+}
+
+void testBigUnsigned()
+{
+  using parakram::BigUnsigned;
+  assert(BigUnsigned().isZero());
+  assert(BigUnsigned(0).toString() == "0");
+  assert(BigUnsigned(1234567890123ull).toString() == "1234567890123");
+  assert(BigUnsigned(0xffffffffull) + BigUnsigned(1) == BigUnsigned(0x100000000ull));
+  assert(BigUnsigned::power2(64).toString() == "18446744073709551616");
+  assert(BigUnsigned::power2(100).toString() == "1267650600228229401496703205376");
+  assert(BigUnsigned::power2(100).numBits() == 101);
+  assert((BigUnsigned::power2(100) >> 99) == BigUnsigned(2));
+  assert((BigUnsigned(5) << 33 >> 33) == BigUnsigned(5));
+  assert((BigUnsigned(5) >> 3).isZero());
+  assert(BigUnsigned(7) < BigUnsigned::power2(40));
+  assert(!(BigUnsigned::power2(40) < BigUnsigned(7)));
+  assert(BigUnsigned::power2(20000).log2() == 20000);
+  assert(std::abs((BigUnsigned::power2(3000) + BigUnsigned::power2(2999)).log2() - (3000 + std::log2(1.5))) < 1e-9);
+  assert(BigUnsigned(1000).toLongDouble() == 1000);
+  assert(BigUnsigned(1000000000).toString() == "1000000000");
+}
+
+void testVarSet(DdManager * manager)
+{
+  int const numVars = 130;
+  int const numTests = 100;
+  std::default_random_engine randEng(11235);
+  std::uniform_int_distribution<int> varGen(0, numVars - 1), numVarsGen(0, 20);
+  for (int itest = 0; itest < numTests; ++itest)
+  {
+    // two random sets, as VarSets, std::sets and cubes
+    dd::VarSet vs[2];
+    std::set<int> ss[2];
+    bdd_ptr cubes[2];
+    for (int i = 0; i < 2; ++i)
+    {
+      cubes[i] = bdd_one(manager);
+      for (int n = numVarsGen(randEng); n > 0; --n)
+      {
+        int index = varGen(randEng);
+        vs[i].insert(index);
+        ss[i].insert(index);
+        auto var = bdd_new_var_with_index(manager, index);
+        auto temp = bdd_cube_union(manager, cubes[i], var);
+        bdd_free(manager, cubes[i]);
+        bdd_free(manager, var);
+        cubes[i] = temp;
+      }
+      if (vs[i].size() != ss[i].size()
+          || vs[i].indices() != std::vector<int>(ss[i].cbegin(), ss[i].cend())
+          || vs[i] != dd::VarSet::fromCube(manager, cubes[i]))
+        throw std::runtime_error("VarSet does not match the set of inserted variables");
+      auto cube = vs[i].toCube(manager);
+      if (cube != cubes[i])
+        throw std::runtime_error("VarSet::toCube did not give the expected cube");
+      bdd_free(manager, cube);
+    }
+
+    std::set<int> intersection, sunion, difference;
+    std::set_intersection(ss[0].cbegin(), ss[0].cend(), ss[1].cbegin(), ss[1].cend(), std::inserter(intersection, intersection.end()));
+    std::set_union(ss[0].cbegin(), ss[0].cend(), ss[1].cbegin(), ss[1].cend(), std::inserter(sunion, sunion.end()));
+    std::set_difference(ss[0].cbegin(), ss[0].cend(), ss[1].cbegin(), ss[1].cend(), std::inserter(difference, difference.end()));
+    if (vs[0].intersectionSize(vs[1]) != intersection.size()
+        || vs[0].unionSize(vs[1]) != sunion.size()
+        || vs[0].differenceSize(vs[1]) != difference.size()
+        || vs[0].intersects(vs[1]) == intersection.empty())
+      throw std::runtime_error("VarSet set sizes do not match std::set");
+    if ((vs[0] & vs[1]).indices() != std::vector<int>(intersection.cbegin(), intersection.cend())
+        || (vs[0] | vs[1]).indices() != std::vector<int>(sunion.cbegin(), sunion.cend())
+        || (vs[0] - vs[1]).indices() != std::vector<int>(difference.cbegin(), difference.cend()))
+      throw std::runtime_error("VarSet set operations do not match std::set");
+
+    for (int i = 0; i < 2; ++i)
+      bdd_free(manager, cubes[i]);
+  }
+
+  // trailing empty words do not affect equality
+  dd::VarSet small, large;
+  small.insert(3);
+  large.insert(3);
+  large.insert(200);
+  large.erase(200);
+  assert(small == large && !large.contains(200) && large.contains(3));
+  assert(dd::VarSet().empty() && !small.empty());
+} // end testVarSet
+
+void testNodeSetCache()
+{
+  using namespace parakram;
+  int nodes[8];
+  int const * keys[3] = {&nodes[0], &nodes[1], &nodes[2]};
+  NodeSetCache<int const *, int> cache(16);
+  assert(cache.numSlots() == 16);
+  assert(!cache.tryGet(keys, 3, &nodes[7]).isPresent());
+  cache.insert(keys, 3, &nodes[7], 5);
+  assert(cache.tryGet(keys, 3, &nodes[7]).get() == 5);
+  // tag and length are part of the key
+  assert(!cache.tryGet(keys, 3, &nodes[6]).isPresent());
+  assert(!cache.tryGet(keys, 2, &nodes[7]).isPresent());
+  cache.insert(keys, 2, &nodes[7], 6);
+  assert(cache.tryGet(keys, 2, &nodes[7]).get() == 6);
+  assert(cache.tryGet(keys, 3, &nodes[7]).get() == 5);
+  // overwrite
+  cache.insert(keys, 3, &nodes[7], 7);
+  assert(cache.tryGet(keys, 3, &nodes[7]).get() == 7);
+  assert(cache.numHits() == 4);
+
+  // overflowing the key pool flushes the table instead of growing it
+  for (int i = 0; i < 100; ++i)
+  {
+    int const * key[1] = {&nodes[i % 8]};
+    cache.insert(key, 1, reinterpret_cast<int const *>(i), i);
+    assert(cache.tryGet(key, 1, reinterpret_cast<int const *>(i)).get() == i);
+  }
+  assert(cache.numSlots() == 16);
+  assert(cache.numFlushes() > 0);
+
+  cache.clear();
+  assert(!cache.tryGet(keys, 2, &nodes[7]).isPresent());
+}
+
+
+
+void testVariableOrder()
+{
+  using namespace dd;
+  assert(parseVariableOrdering("FORCE") == VariableOrdering::Force);
+  assert(toString(parseVariableOrdering("cluster")) == "cluster");
+  bool threw = false;
+  try { parseVariableOrdering("sift"); } catch (std::invalid_argument const &) { threw = true; }
+  assert(threw);
+
+  // the chain 1 - 7 - 3 - 9 - 2 - 5, with its links out of order
+  VariableHypergraph chain;
+  std::vector<std::vector<int> > links{ { 3, 9 }, { 1, 7 }, { 2, 5 }, { 7, 3 }, { 9, 2 } };
+  for (auto const & link: links)
+    chain.addEdge(link.data(), link.data() + link.size());
+  assert(hypergraphSpan(chain, { 1, 2, 3, 5, 7, 9 }) == 15);
+  assert(computeVariableOrder(chain, VariableOrdering::None).empty());
+  auto cluster = computeVariableOrder(chain, VariableOrdering::Cluster);
+  assert((cluster == std::vector<int>{ 3, 9, 7, 2, 1, 5 }));
+  assert(hypergraphSpan(chain, cluster) == 9);
+  auto force = computeVariableOrder(chain, VariableOrdering::Force);
+  std::vector<int> sortedForce(force);
+  std::sort(sortedForce.begin(), sortedForce.end());
+  assert((sortedForce == std::vector<int>{ 1, 2, 3, 5, 7, 9 }));
+  assert(hypergraphSpan(chain, force) <= hypergraphSpan(chain, cluster));
+
+  // the listed variables move to the top, the others keep their relative order
+  DdManager * fresh = Cudd_Init(0, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+  applyVariableOrder(fresh, { 5, 2 });
+  assert(Cudd_ReadSize(fresh) == 6);
+  assert((currentVariableOrder(fresh) == std::vector<int>{ 5, 2, 0, 1, 3, 4 }));
+  Cudd_Quit(fresh);
+}
+
+
+
+void testManagerFactory()
+{
+  using namespace dd;
+  assert(parseMemorySize("4096") == 4096);
+  assert(parseMemorySize("64k") == (size_t(64) << 10));
+  assert(parseMemorySize("2G") == (size_t(2) << 30));
+  for (auto bad: { "", "M", "12MB", "1.5G", "-1" })
+  {
+    bool threw = false;
+    try { parseMemorySize(bad); } catch (std::invalid_argument const &) { threw = true; }
+    assert(threw);
+  }
+  assert(parseDynamicReordering("SymmSift") == DynamicReordering::SymmSift);
+  assert(toString(parseGcPolicy("lazy")) == "lazy");
+  bool threw = false;
+  try { parseGcPolicy("never"); } catch (std::invalid_argument const &) { threw = true; }
+  assert(threw);
+
+  // without any information, the manager gets cudd's defaults
+  ManagerOptions options;
+  auto sizing = computeManagerSizing(options);
+  assert(sizing.uniqueSlots == CUDD_UNIQUE_SLOTS);
+  assert(sizing.cacheSlots == CUDD_CACHE_SLOTS);
+  assert(sizing.maxLive == 0);
+
+  // a big instance gets bigger tables, which shrink under a memory limit
+  options.numVariables = 1000;
+  options.numFactors = 1000 * 1000;
+  auto big = computeManagerSizing(options);
+  assert(big.uniqueSlots > CUDD_UNIQUE_SLOTS);
+  assert(big.cacheSlots > CUDD_CACHE_SLOTS);
+  options.maxMemory = size_t(16) << 20;
+  auto limited = computeManagerSizing(options);
+  assert(limited.uniqueSlots < big.uniqueSlots);
+  assert(limited.cacheSlots < big.cacheSlots);
+  assert(limited.maxLive > 0);
+
+  options.reordering = DynamicReordering::Sift;
+  options.gcPolicy = GcPolicy::Eager;
+  DdManager * manager = createManager(options);
+  assert(Cudd_ReadMaxMemory(manager) == options.maxMemory);
+  assert(Cudd_ReadMaxLive(manager) == limited.maxLive);
+  bdd_ptr x = bdd_new_var_with_index(manager, 3);
+  auto stats = readManagerStats(manager);
+  assert(stats.peakNodes > 0);
+  assert(stats.maxMemory == options.maxMemory);
+  bdd_free(manager, x);
+  Cudd_Quit(manager);
+}
+
+
+
+void testSolveConcurrently()
+{
+  using namespace blif_solve;
+  DdManager * manager = Cudd_Init(0, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+  {
+    // four latches that share no variables, so four partitions
+    BlifFactors blifFactors("test/data/partitions.blif", 0, manager);
+    blifFactors.createBdds();
+    auto partitions = blifFactors.partitionFactors();
+    assert(partitions.size() == 4);
+
+    char const * sequentialArgs[] = { "test1" };
+    char const * concurrentArgs[] = { "test1", "--threads", "3" };
+    char const * persistentArgs[] = { "test1", "--threads", "8", "--persistent_multi_cache" };
+    CommandLineOptions sequential(1, sequentialArgs);
+    CommandLineOptions concurrent(3, concurrentArgs);
+    CommandLineOptions persistent(4, persistentArgs);
+
+    for (auto method: { BlifSolveMethod::createExactAndAccumulate(dd::DefaultMaxClusterSize),
+                        BlifSolveMethod::createExactAndAbstractMulti(sequential.cacheSize, false, 0, 0, dd::DefaultMaxClusterSize) })
+    {
+      auto expected = divideAndConquer(partitions, method, sequential);
+      assert(!expected.empty());
+      for (auto const * clo: { &concurrent, &persistent })
+      {
+        auto actual = solveConcurrently(partitions, method, *clo);
+        assert(actual == expected);
+        for (auto r: actual)
+          bdd_free(manager, r);
+        actual = divideAndConquer(partitions, method, *clo);
+        assert(actual == expected);
+        for (auto r: actual)
+          bdd_free(manager, r);
+      }
+      for (auto r: expected)
+        bdd_free(manager, r);
+    }
+  }
+  assert(Cudd_CheckZeroRef(manager) == 0);
+  Cudd_Quit(manager);
 }
 
 void testOptional() {
@@ -692,6 +1408,597 @@ void testCuddBddAndAbstractMulti(DdManager * manager)
   return;
 } // end testCuddBddAndAbstractMulti
 
+void testCuddBddAndMultiManyOperands(DdManager * manager)
+{
+  // more operands than fit inline in the and-multi operand sets
+  int const numVars = 5;
+  int const numTests = 200;
+  int const numFuncsPerTest = 40;
+  std::default_random_engine randEng(1234);
+  std::uniform_int_distribution<int> minTermGen(0, (1 << numVars) - 1), varGen(0, numVars - 1);
+  for (int itest = 0; itest < numTests; ++itest)
+  {
+    // functions with a few minterms missing, so that the conjunction is rarely zero
+    std::set<DdNode *> funcs;
+    for (int ifunc = 0; ifunc < numFuncsPerTest; ++ifunc)
+    {
+      unsigned int funcAsInteger = ~0u;
+      for (int ibit = 0; ibit < itest % 3; ++ibit)
+        funcAsInteger &= ~(1u << minTermGen(randEng));
+      funcs.insert(makeFunc(manager, numVars, static_cast<int>(funcAsInteger)));
+    }
+    DdNode * cube = bdd_one(manager);
+    for (int iqv = 0; iqv < itest % numVars; ++iqv)
+    {
+      auto var = bdd_new_var_with_index(manager, varGen(randEng));
+      auto temp = bdd_cube_union(manager, cube, var);
+      bdd_free(manager, cube);
+      bdd_free(manager, var);
+      cube = temp;
+    }
+
+    auto manualConjunction = bdd_one(manager);
+    for (auto f: funcs)
+      bdd_and_accumulate(manager, &manualConjunction, f);
+    auto manualResult = bdd_forsome(manager, manualConjunction, cube);
+
+    Cudd_MultiStats stats;
+    auto autoConjunction = Cudd_bddAndMulti(manager, funcs, 1000, &stats);
+    Cudd_Ref(autoConjunction);
+    assert(stats.cacheSlots == 1024);
+    auto autoResult = Cudd_bddAndAbstractMulti(manager, funcs, cube, 1000, 0, &stats);
+    Cudd_Ref(autoResult);
+    assert(stats.recursions > 0);
+
+    if (autoConjunction != manualConjunction)
+      throw std::runtime_error("Cudd_bddAndMulti with many operands did not give expected result");
+    if (autoResult != manualResult)
+      throw std::runtime_error("Cudd_bddAndAbstractMulti with many operands did not give expected result");
+
+    for (auto f: funcs)
+      bdd_free(manager, f);
+    bdd_free(manager, cube);
+    bdd_free(manager, manualConjunction);
+    bdd_free(manager, manualResult);
+    bdd_free(manager, autoConjunction);
+    bdd_free(manager, autoResult);
+  }
+} // end testCuddBddAndMultiManyOperands
+
+void testCuddBddAndAbstractMultiComponents(DdManager * manager)
+{
+  int const numGroups = 4;
+  int const varsPerGroup = 3;
+  int const funcsPerGroup = 3;
+  int const numTests = 100;
+  std::default_random_engine randEng(4321);
+  std::uniform_int_distribution<int> coin(0, 1), litGen(0, 2);
+  unsigned long long numDecompositions = 0;
+  for (int itest = 0; itest < numTests; ++itest)
+  {
+    // random disjunctions of cubes, each over the vars of one group,
+    // so that the factors fall apart into numGroups components
+    std::set<DdNode *> funcs;
+    for (int igroup = 0; igroup < numGroups; ++igroup)
+    {
+      for (int ifunc = 0; ifunc < funcsPerGroup; ++ifunc)
+      {
+        auto func = bdd_zero(manager);
+        for (int icube = 0; icube < 3; ++icube)
+        {
+          auto cube = bdd_one(manager);
+          for (int ivar = 0; ivar < varsPerGroup; ++ivar)
+          {
+            int lit = litGen(randEng);
+            if (lit == 2)
+              continue;
+            auto var = bdd_new_var_with_index(manager, igroup * varsPerGroup + ivar);
+            if (lit == 1)
+            {
+              auto nvar = bdd_not(var);
+              bdd_free(manager, var);
+              var = nvar;
+            }
+            bdd_and_accumulate(manager, &cube, var);
+            bdd_free(manager, var);
+          }
+          bdd_or_accumulate(manager, &func, cube);
+          bdd_free(manager, cube);
+        }
+        if (funcs.count(func) > 0)
+          bdd_free(manager, func);
+        else
+          funcs.insert(func);
+      }
+    }
+    auto cube = bdd_one(manager);
+    for (int ivar = 0; ivar < numGroups * varsPerGroup; ++ivar)
+    {
+      if (coin(randEng) == 0)
+        continue;
+      auto var = bdd_new_var_with_index(manager, ivar);
+      auto temp = bdd_cube_union(manager, cube, var);
+      bdd_free(manager, cube);
+      bdd_free(manager, var);
+      cube = temp;
+    }
+
+    auto manualConjunction = bdd_one(manager);
+    for (auto f: funcs)
+      bdd_and_accumulate(manager, &manualConjunction, f);
+    auto manualResult = bdd_forsome(manager, manualConjunction, cube);
+
+    Cudd_MultiStats plainStats, decomposedStats;
+    auto plainResult = Cudd_bddAndAbstractMulti(manager, funcs, cube, 1000, 0, &plainStats);
+    Cudd_Ref(plainResult);
+    auto decomposedResult = Cudd_bddAndAbstractMulti(manager, funcs, cube, 1000, 1, &decomposedStats);
+    Cudd_Ref(decomposedResult);
+    assert(plainStats.decompositions == 0);
+
+    if (plainResult != manualResult)
+      throw std::runtime_error("Cudd_bddAndAbstractMulti without decomposition did not give expected result");
+    if (decomposedResult != manualResult)
+      throw std::runtime_error("Cudd_bddAndAbstractMulti with decomposition did not give expected result");
+    numDecompositions += decomposedStats.decompositions;
+
+    for (auto f: funcs)
+      bdd_free(manager, f);
+    bdd_free(manager, cube);
+    bdd_free(manager, manualConjunction);
+    bdd_free(manager, manualResult);
+    bdd_free(manager, plainResult);
+    bdd_free(manager, decomposedResult);
+  }
+  if (numDecompositions == 0)
+    throw std::runtime_error("Cudd_bddAndAbstractMulti did not decompose independent factors");
+} // end testCuddBddAndAbstractMultiComponents
+
+void testAndExistsScheduled(DdManager * manager)
+{
+  int const numVars = 12;
+  int const numTests = 100;
+  std::default_random_engine randEng(2468);
+  std::uniform_int_distribution<int> varGen(0, numVars - 1), coin(0, 1), numClausesGen(1, 25);
+  for (int itest = 0; itest < numTests; ++itest)
+  {
+    // random 3-literal clauses
+    std::vector<bdd_ptr> clauses;
+    int numClauses = numClausesGen(randEng);
+    for (int iclause = 0; iclause < numClauses; ++iclause)
+    {
+      auto clause = bdd_zero(manager);
+      for (int ilit = 0; ilit < 3; ++ilit)
+      {
+        auto var = bdd_new_var_with_index(manager, varGen(randEng));
+        if (coin(randEng))
+        {
+          auto nvar = bdd_not(var);
+          bdd_free(manager, var);
+          var = nvar;
+        }
+        bdd_or_accumulate(manager, &clause, var);
+        bdd_free(manager, var);
+      }
+      clauses.push_back(clause);
+    }
+    auto cube = bdd_one(manager);
+    for (int ivar = 0; ivar < numVars; ++ivar)
+    {
+      if (coin(randEng) == 0)
+        continue;
+      auto var = bdd_new_var_with_index(manager, ivar);
+      auto temp = bdd_cube_union(manager, cube, var);
+      bdd_free(manager, cube);
+      bdd_free(manager, var);
+      cube = temp;
+    }
+
+    auto conjunction = bdd_one(manager);
+    for (auto clause: clauses)
+      bdd_and_accumulate(manager, &conjunction, clause);
+    auto expected = bdd_forsome(manager, conjunction, cube);
+
+    for (int maxClusterSize: {0, 1, 10, dd::DefaultMaxClusterSize})
+    {
+      dd::AndExistsScheduleStats stats;
+      auto result = dd::andExistsScheduled(manager, clauses, cube, maxClusterSize, &stats);
+      if (result != expected)
+        throw std::runtime_error("andExistsScheduled did not give expected result with cluster size "
+                                 + std::to_string(maxClusterSize));
+      if (stats.numClusters > clauses.size())
+        throw std::runtime_error("andExistsScheduled made more clusters than factors");
+      bdd_free(manager, result);
+    }
+
+    for (auto clause: clauses)
+      bdd_free(manager, clause);
+    bdd_free(manager, cube);
+    bdd_free(manager, conjunction);
+    bdd_free(manager, expected);
+  }
+} // end testAndExistsScheduled
+
+void testConjoinAll(DdManager * manager)
+{
+  using dd::BddWrapper;
+  int const numVars = 10;
+  int const numTests = 100;
+  std::default_random_engine randEng(1357);
+  std::uniform_int_distribution<int> varGen(0, numVars - 1), coin(0, 1), numOperandsGen(0, 12);
+  for (int itest = 0; itest < numTests; ++itest)
+  {
+    // random 3-literal clauses and cubes
+    std::vector<BddWrapper> clauses, cubes;
+    int numOperands = numOperandsGen(randEng);
+    for (int iop = 0; iop < numOperands; ++iop)
+    {
+      BddWrapper clause(bdd_zero(manager), manager), cube(bdd_one(manager), manager);
+      for (int ilit = 0; ilit < 3; ++ilit)
+      {
+        BddWrapper var(bdd_new_var_with_index(manager, varGen(randEng)), manager);
+        if (coin(randEng))
+          var = -var;
+        clause = clause + var;
+        cube = cube * var;
+      }
+      clauses.push_back(clause);
+      cubes.push_back(cube);
+    }
+    BddWrapper projectOn(bdd_one(manager), manager);
+    for (int ivar = 0; ivar < numVars; ++ivar)
+      if (coin(randEng))
+        projectOn = projectOn.cubeUnion(BddWrapper(bdd_new_var_with_index(manager, ivar), manager));
+
+    BddWrapper expectedAnd(bdd_one(manager), manager), expectedOr(bdd_zero(manager), manager);
+    BddWrapper support(bdd_one(manager), manager);
+    for (const auto & clause: clauses)
+    {
+      expectedAnd = expectedAnd * clause;
+      support = support.cubeUnion(clause.support());
+    }
+    for (const auto & cube: cubes)
+      expectedOr = expectedOr + cube;
+    BddWrapper expectedProjection = expectedAnd.existentialQuantification(support.cubeDiff(projectOn));
+
+    if (dd::conjoinAll(manager, clauses) != expectedAnd)
+      throw std::runtime_error("conjoinAll did not match the left fold in test " + std::to_string(itest));
+    if (dd::disjoinAll(manager, cubes) != expectedOr)
+      throw std::runtime_error("disjoinAll did not match the left fold in test " + std::to_string(itest));
+    if (dd::conjoinAndProject(manager, clauses, projectOn) != expectedProjection)
+      throw std::runtime_error("conjoinAndProject did not match and-then-quantify in test " + std::to_string(itest));
+  }
+} // end testConjoinAll
+
+void testBddWrapperMoves()
+{
+  using dd::BddWrapper;
+  using dd::BddVectorWrapper;
+  DdManager * manager = Cudd_Init(0, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+  auto refs = [](bdd_ptr f) { return Cudd_Regular(f)->ref; };
+  {
+    BddWrapper a(bdd_new_var_with_index(manager, 0), manager), b(bdd_new_var_with_index(manager, 1), manager);
+    bdd_ptr x0 = a.getUncountedBdd(), x1 = b.getUncountedBdd();
+    // made first, since the nodes above x1 hold references to it
+    bdd_ptr conjunction = bdd_and(manager, x0, x1);
+    bdd_ptr disjunction = bdd_or(manager, x0, x1);
+    auto x0Refs = refs(x0), x1Refs = refs(x1);
+
+    // moves hand the reference over, leaving the source empty
+    BddWrapper moved(std::move(a));
+    assert(a.getUncountedBdd() == NULL && moved.getUncountedBdd() == x0 && refs(x0) == x0Refs);
+    BddWrapper target(bdd_dup(x1), manager);
+    target = std::move(moved);
+    assert(moved.getUncountedBdd() == NULL && target.getUncountedBdd() == x0);
+    assert(refs(x0) == x0Refs && refs(x1) == x1Refs);
+    target = std::move(target);
+    assert(target.getUncountedBdd() == x0 && refs(x0) == x0Refs);
+
+    // the rvalue operators give what the lvalue ones do, in the expiring operand
+    {
+      BddWrapper lhs(bdd_dup(x0), manager);
+      BddWrapper product = std::move(lhs) * b;
+      assert(lhs.getUncountedBdd() == NULL && product.getUncountedBdd() == conjunction);
+      assert(product == target * b);
+      BddWrapper sum = BddWrapper(bdd_dup(x0), manager) + b;
+      assert(sum.getUncountedBdd() == disjunction && sum == target + b);
+      BddWrapper negation = -std::move(sum);
+      assert(sum.getUncountedBdd() == NULL && negation.getUncountedBdd() == Cudd_Not(disjunction));
+      assert(negation == -(target + b));
+      BddWrapper cube = BddWrapper(bdd_dup(x0), manager).cubeUnion(b);
+      assert(cube == target.cubeUnion(b) && cube.getUncountedBdd() == conjunction);
+      BddWrapper diff = std::move(cube).cubeDiff(b);
+      assert(cube.getUncountedBdd() == NULL && diff == target);
+      BddWrapper quantified = std::move(product).existentialQuantification(b);
+      assert(product.getUncountedBdd() == NULL && quantified == target);
+    }
+    assert(refs(conjunction) == 1 && refs(disjunction) == 1);
+    assert(refs(x0) == x0Refs && refs(x1) == x1Refs);
+
+    // release hands the reference to the caller
+    BddWrapper released(bdd_dup(conjunction), manager);
+    bdd_ptr counted = released.release();
+    assert(released.getUncountedBdd() == NULL && counted == conjunction && refs(conjunction) == 2);
+    bdd_free(manager, counted);
+
+    // so do the moves of BddVectorWrapper, and the rvalue push_back / set
+    {
+      BddVectorWrapper v(manager);
+      v.push_back(BddWrapper(bdd_dup(conjunction), manager));
+      v.push_back(b);
+      assert(refs(conjunction) == 2 && refs(x1) == x1Refs + 1);
+      BddVectorWrapper w(std::move(v));
+      assert(v->empty() && w->size() == 2 && (*w)[0] == conjunction && (*w)[1] == x1);
+      BddVectorWrapper u(manager);
+      u.push_back(target);
+      u = std::move(w);
+      assert(w->empty() && u->size() == 2 && refs(x0) == x0Refs);
+      u.set(1, BddWrapper(bdd_dup(disjunction), manager));
+      assert((*u)[1] == disjunction && refs(disjunction) == 2 && refs(x1) == x1Refs);
+      assert(refs(conjunction) == 2);
+    }
+    assert(refs(conjunction) == 1 && refs(disjunction) == 1);
+    assert(refs(x0) == x0Refs && refs(x1) == x1Refs);
+    bdd_free(manager, conjunction);
+    bdd_free(manager, disjunction);
+  }
+  assert(Cudd_CheckZeroRef(manager) == 0);
+  Cudd_Quit(manager);
+} // end testBddWrapperMoves
+
+void testCuddMultiCachePersistent(DdManager * manager)
+{
+  int const numVars = 5;
+  std::set<DdNode *> funcs;
+  for (int funcAsInteger: {0x7fffffff, 0x3ffffbff, 0x7ff7ffef, 0x6ffffffd})
+    funcs.insert(makeFunc(manager, numVars, funcAsInteger));
+  auto cube = bdd_new_var_with_index(manager, 0);
+
+  auto expectedConjunction = Cudd_bddAndMulti(manager, funcs, 1000);
+  Cudd_Ref(expectedConjunction);
+  auto expectedResult = Cudd_bddAndAbstractMulti(manager, funcs, cube, 1000);
+  Cudd_Ref(expectedResult);
+  auto expectedCount = Cudd_LdblCountMintermMulti(manager, funcs, numVars, 1000);
+
+  if (1 != Cudd_MultiCacheEnable(manager, 1000))
+    throw std::runtime_error("Could not enable the persistent multi cache");
+
+  // the second round of calls is answered by the persistent cache
+  Cudd_MultiStats stats;
+  for (int round = 0; round < 2; ++round)
+  {
+    auto conjunction = Cudd_bddAndMulti(manager, funcs, 1000, &stats);
+    Cudd_Ref(conjunction);
+    assert(round == 0 || stats.cacheHits > 0);
+    auto result = Cudd_bddAndAbstractMulti(manager, funcs, cube, 1000, 0, &stats);
+    Cudd_Ref(result);
+    assert(round == 0 || stats.cacheHits > 0);
+    auto count = Cudd_LdblCountMintermMulti(manager, funcs, numVars, 1000);
+    if (conjunction != expectedConjunction || result != expectedResult || count != expectedCount)
+      throw std::runtime_error("Persistent multi cache changed the result of a multi operation");
+    bdd_free(manager, conjunction);
+    bdd_free(manager, result);
+  }
+  Cudd_MultiCacheStats cacheStats;
+  if (1 != Cudd_MultiCacheReadStats(manager, &cacheStats))
+    throw std::runtime_error("Could not read the persistent multi cache stats");
+  assert(cacheStats.andHits > 0 && cacheStats.countHits > 0);
+  assert(cacheStats.slots == 1024);
+
+  // garbage collection flushes the cache
+  cuddGarbageCollect(manager, 1);
+  Cudd_MultiCacheReadStats(manager, &cacheStats);
+  assert(cacheStats.hookFlushes > 0);
+  auto conjunction = Cudd_bddAndMulti(manager, funcs, 1000, &stats);
+  Cudd_Ref(conjunction);
+  assert(stats.cacheHits == 0);
+  if (conjunction != expectedConjunction)
+    throw std::runtime_error("Persistent multi cache gave a wrong result after garbage collection");
+  bdd_free(manager, conjunction);
+
+  if (1 != Cudd_MultiCacheDisable(manager) || 0 != Cudd_MultiCacheReadStats(manager, &cacheStats))
+    throw std::runtime_error("Could not disable the persistent multi cache");
+
+  // the scope disables the cache when it goes away, even on an exception
+  try {
+    dd::PersistentMultiCacheScope scope(manager, 1000);
+    assert(1 == Cudd_MultiCacheReadStats(manager, &cacheStats));
+    throw std::logic_error("leaving the scope");
+  } catch (std::logic_error const &) {}
+  assert(0 == Cudd_MultiCacheReadStats(manager, &cacheStats));
+
+  for (auto f: funcs)
+    bdd_free(manager, f);
+  bdd_free(manager, cube);
+  bdd_free(manager, expectedConjunction);
+  bdd_free(manager, expectedResult);
+} // end testCuddMultiCachePersistent
+
+void testSupportCache(DdManager * manager)
+{
+  int const numVars = 5;
+  int const numFuncs = 20;
+  std::default_random_engine randEng(8642);
+  std::uniform_int_distribution<int> funcGen(0, 0x7fffffff);
+  std::vector<bdd_ptr> funcs;
+  for (int ifunc = 0; ifunc < numFuncs; ++ifunc)
+    funcs.push_back(makeFunc(manager, numVars, funcGen(randEng)));
+
+  if (!dd::enableSupportCache(manager, 4 * numFuncs))
+    throw std::runtime_error("Could not enable the support cache");
+
+  // the second round of calls is answered by the cache,
+  // and complemented functions share the entry of the regular one
+  for (int round = 0; round < 2; ++round)
+  {
+    for (auto f: funcs)
+    {
+      auto expected = bdd_support(manager, f);
+      auto notF = bdd_not(f);
+      auto cube = dd::supportCube(manager, f);
+      auto notCube = dd::supportCube(manager, notF);
+      if (cube != expected || notCube != expected)
+        throw std::runtime_error("Support cache gave a wrong support cube");
+      auto vars = dd::supportVars(manager, f);
+      if (vars.indices() != dd::supportIndices(manager, f) || vars != dd::VarSet::fromCube(manager, expected))
+        throw std::runtime_error("Support cache vars do not match the support cube");
+      bdd_free(manager, expected);
+      bdd_free(manager, notF);
+      bdd_free(manager, cube);
+      bdd_free(manager, notCube);
+    }
+  }
+  dd::SupportCacheStats stats;
+  if (!dd::readSupportCacheStats(manager, &stats))
+    throw std::runtime_error("Could not read the support cache stats");
+  assert(stats.hits >= stats.lookups / 2 && stats.entries <= size_t(numFuncs));
+  assert(stats.fullFlushes == 0);
+
+  // garbage collection flushes the cache
+  cuddGarbageCollect(manager, 1);
+  dd::readSupportCacheStats(manager, &stats);
+  assert(stats.hookFlushes > 0 && stats.entries == 0);
+
+  if (!dd::disableSupportCache(manager) || dd::readSupportCacheStats(manager, &stats))
+    throw std::runtime_error("Could not disable the support cache");
+
+  // a tiny cache is flushed when full, but still gives the right supports
+  {
+    dd::SupportCacheScope scope(manager, 2);
+    for (auto f: funcs)
+    {
+      auto expected = bdd_support(manager, f);
+      auto cube = dd::supportCube(manager, f);
+      if (cube != expected)
+        throw std::runtime_error("Support cache gave a wrong support cube after a full flush");
+      bdd_free(manager, expected);
+      bdd_free(manager, cube);
+    }
+    dd::readSupportCacheStats(manager, &stats);
+    assert(stats.fullFlushes > 0 && stats.entries <= 2);
+  }
+
+  for (auto f: funcs)
+    bdd_free(manager, f);
+} // end testSupportCache
+
+void testCuddBddAndAbstractMultiBudgeted(DdManager * manager)
+{
+  int const numVars = 5;
+  int const numTests = 200;
+  int const numFuncsPerTest = 6;
+  std::default_random_engine randEng(97531);
+  std::uniform_int_distribution<int> funcGen(0, 0x7fffffff), varGen(0, numVars - 1);
+  Cudd_MultiBudget const noBudget{ 0, 0 };
+  Cudd_MultiBudget const tinyBudget{ 0, 1 };
+  for (int itest = 0; itest < numTests; ++itest)
+  {
+    std::set<DdNode *> funcs;
+    for (int ifunc = 0; ifunc < numFuncsPerTest; ++ifunc)
+      funcs.insert(makeFunc(manager, numVars, funcGen(randEng) | funcGen(randEng)));
+    DdNode * cube = bdd_one(manager);
+    for (int iqv = 0; iqv < itest % numVars; ++iqv)
+    {
+      auto var = bdd_new_var_with_index(manager, varGen(randEng));
+      auto temp = bdd_cube_union(manager, cube, var);
+      bdd_free(manager, cube);
+      bdd_free(manager, var);
+      cube = temp;
+    }
+
+    auto expected = Cudd_bddAndAbstractMulti(manager, funcs, cube, 1000);
+    Cudd_Ref(expected);
+
+    Cudd_MultiStatus status;
+    auto result = Cudd_bddAndAbstractMultiBudgeted(manager, funcs, cube, 1000, &noBudget, &status);
+    if (NULL == result || CUDD_MULTI_SUCCESS != status)
+      throw std::runtime_error("Cudd_bddAndAbstractMultiBudgeted failed without a budget");
+    Cudd_Ref(result);
+    if (result != expected)
+      throw std::runtime_error("Cudd_bddAndAbstractMultiBudgeted did not give expected result");
+    bdd_free(manager, result);
+
+    // the manager already has more live nodes than the tiny budget allows
+    result = Cudd_bddAndAbstractMultiBudgeted(manager, funcs, cube, 1000, &tinyBudget, &status);
+    if (NULL != result || CUDD_MULTI_NODES_EXCEEDED != status)
+      throw std::runtime_error("Cudd_bddAndAbstractMultiBudgeted did not respect the node budget");
+
+    for (auto f: funcs)
+      bdd_free(manager, f);
+    bdd_free(manager, cube);
+    bdd_free(manager, expected);
+  }
+} // end testCuddBddAndAbstractMultiBudgeted
+
+void testCuddBddClippingAndAbstractMultiAdaptive(DdManager * manager)
+{
+  int const numVars = 6;
+  int const numTests = 100;
+  int const numFuncsPerTest = 5;
+  std::default_random_engine randEng(86420);
+  std::uniform_int_distribution<int> funcGen(0, 0x7fffffff), varGen(0, numVars - 1);
+  Cudd_ClippingBudget const noBudget{ 0, 0, 1 };
+  Cudd_ClippingBudget const largeSize{ 1000*1000, 0, 1 };
+  Cudd_ClippingBudget const smallSize{ 3, 0, 1 };
+  Cudd_ClippingBudget const tinyNodes{ 0, 1, 1 };
+  for (int itest = 0; itest < numTests; ++itest)
+  {
+    std::set<DdNode *> funcs;
+    for (int ifunc = 0; ifunc < numFuncsPerTest; ++ifunc)
+      funcs.insert(makeFunc(manager, numVars, funcGen(randEng) | funcGen(randEng)));
+    DdNode * cube = bdd_one(manager);
+    for (int iqv = 0; iqv < itest % numVars; ++iqv)
+    {
+      auto var = bdd_new_var_with_index(manager, varGen(randEng));
+      auto temp = bdd_cube_union(manager, cube, var);
+      bdd_free(manager, cube);
+      bdd_free(manager, var);
+      cube = temp;
+    }
+
+    auto expected = Cudd_bddAndAbstractMulti(manager, funcs, cube, 1000);
+    Cudd_Ref(expected);
+
+    for (auto budget: { &noBudget, &largeSize, &smallSize, &tinyNodes })
+    {
+      for (int direction: { dd_constants::Clip_Up, dd_constants::Clip_Down })
+      {
+        Cudd_ClippingStats stats;
+        auto result = Cudd_bddClippingAndAbstractMultiAdaptive(manager, funcs, cube, budget, direction, &stats);
+        if (NULL == result)
+          throw std::runtime_error("Cudd_bddClippingAndAbstractMultiAdaptive failed");
+        Cudd_Ref(result);
+        bool isSound = dd_constants::Clip_Up == direction
+          ? Cudd_bddLeq(manager, expected, result)
+          : Cudd_bddLeq(manager, result, expected);
+        if (!isSound)
+          throw std::runtime_error("Cudd_bddClippingAndAbstractMultiAdaptive broke the direction of approximation");
+        if (budget != &smallSize && budget != &tinyNodes && (result != expected || !stats.exact))
+          throw std::runtime_error("Cudd_bddClippingAndAbstractMultiAdaptive clipped within a large budget");
+        if (budget == &smallSize && stats.depth > 1 && Cudd_DagSize(result) > smallSize.maxResultSize)
+          throw std::runtime_error("Cudd_bddClippingAndAbstractMultiAdaptive exceeded the result size target");
+        bdd_free(manager, result);
+      }
+    }
+
+    // plain conjunction with the live node budget
+    auto conjunction = Cudd_bddAndMulti(manager, funcs, 1000);
+    Cudd_Ref(conjunction);
+    auto clipped = Cudd_bddClippingAndMultiAdaptive(manager, funcs, &tinyNodes, dd_constants::Clip_Down);
+    if (NULL == clipped)
+      throw std::runtime_error("Cudd_bddClippingAndMultiAdaptive failed");
+    Cudd_Ref(clipped);
+    if (!Cudd_bddLeq(manager, clipped, conjunction))
+      throw std::runtime_error("Cudd_bddClippingAndMultiAdaptive did not under approximate");
+    bdd_free(manager, clipped);
+    bdd_free(manager, conjunction);
+
+    for (auto f: funcs)
+      bdd_free(manager, f);
+    bdd_free(manager, cube);
+    bdd_free(manager, expected);
+  }
+} // end testCuddBddClippingAndAbstractMultiAdaptive
+
 void testCuddBddCountMintermsMulti(DdManager * manager)
 {
   const int numVars = 3;
@@ -29,6 +29,8 @@ SOFTWARE.
 #include <blif_solve_lib/blif_factors.h>
 #include <factor_graph/srt.h>
 #include <dd/bdd_factory.h>
+#include <dd/support_cache.h>
+#include <dd/variable_order.h>
 
 #include <memory>
 
@@ -49,6 +51,7 @@ struct VarScoreCommandLineOptions
   int maxBddSize;
   var_score::ApproximationMethod::CPtr approximationMethod;
   bool mustCountNumSolutions;
+  dd::VariableOrdering variableOrdering;
 };
 template<typename TValue>
 std::shared_ptr<blif_solve::CommandLineOptionValue<TValue> > 
@@ -73,10 +76,12 @@ int main(int argc, char const * const * const argv)
   auto start = blif_solve::now();
   auto clo = parseClo(argc, argv); // parse the command line options
   auto srt = std::make_shared<SRT>(); // initialize BDD
+  dd::SupportCacheScope supportCacheScope(srt->ddm); // memoize supports of factors and messages
   
   // parse the blif file
   blif_solve::BlifFactors bf(clo.blif, 0, srt->ddm);
   bf.createBdds();
+  bf.orderVariables(clo.variableOrdering);
   auto subProblems = bf.partitionFactors();
   blif_solve_log(INFO, "Parsed " << subProblems.size() << " sub problems in " << blif_solve::duration(start) << " sec");
   start = blif_solve::now();
@@ -101,9 +106,7 @@ int main(int argc, char const * const * const argv)
   {
     start = blif_solve::now();
     auto numVars = bf.getNonPiVars()->size();
-    BddWrapper conjoinedSolution(bdd_one(srt->ddm), srt->ddm);
-    for (const auto & result: resultVec)
-      conjoinedSolution = conjoinedSolution * result;
+    BddWrapper conjoinedSolution = dd::conjoinAll(srt->ddm, resultVec);
     blif_solve_log(INFO, "Computed conjoined solution in " << blif_solve::duration(start) << " sec");
     start = blif_solve::now();
     auto numSolutions = bdd_count_minterm(srt->ddm, conjoinedSolution.getUncountedBdd(), numVars);
@@ -113,9 +116,7 @@ int main(int argc, char const * const * const argv)
   // display final result
   if (blif_solve::getVerbosity() == blif_solve::DEBUG)
   {
-    BddWrapper finalResult(bdd_one(srt->ddm), srt->ddm);
-    for (const auto & r: resultVec)
-      finalResult = finalResult * r;
+    BddWrapper finalResult = dd::conjoinAll(srt->ddm, resultVec);
     blif_solve_log_bdd(DEBUG, "finalResult", srt->ddm, finalResult.getUncountedBdd());
   }
 
@@ -159,6 +160,7 @@ VarScoreCommandLineOptions
   auto factorGraphBddSize = addCommandLineOption<int>(clo, "--factorGraphBddSize", "largest bdd allowed in the factor graph during merging", 1*1000*1000*1000);
   auto mustCountNumSolutions = addCommandLineOption<bool>(clo, "--mustCountNumSolutions", "count and print the number of satisfying states", false);
   auto dottyFilePrefix = addCommandLineOption<std::string>(clo, "--dottyFilePrefix", "a path and file prefix for generating intermediate factor graphs", "");
+  auto variableOrdering = addCommandLineOption<std::string>(clo, "--variableOrdering", "static variable order applied to the factors (none / cluster / force)", "none");
 
 
   parseCommandLineOptions(argc - 1, argv + 1, clo);
@@ -177,10 +179,12 @@ VarScoreCommandLineOptions
   blif_solve_log(DEBUG, "factor graph bdd size: " << factorGraphBddSize->getValue());
   blif_solve_log(DEBUG, "must count num solutions: " << mustCountNumSolutions->getValue());
   blif_solve_log(DEBUG, "dotty file prefix: " << dottyFilePrefix->getValue());
+  blif_solve_log(DEBUG, "variable ordering: " << variableOrdering->getValue());
   result.verbosity = verbosity->getValue();
   result.blif = blif->getValue();
   result.maxBddSize = maxBddSize->getValue();
   result.mustCountNumSolutions = mustCountNumSolutions->getValue();
+  result.variableOrdering = dd::parseVariableOrdering(variableOrdering->getValue());
   std::string am = approximationMethod->getValue();
   for (auto amit = am.begin(); amit != am.end(); ++amit)
     *amit = std::tolower(*amit);
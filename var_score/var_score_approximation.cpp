@@ -28,6 +28,7 @@ SOFTWARE.
 #include <blif_solve_lib/log.h>
 #include <blif_solve_lib/approx_merge.h>
 #include <factor_graph/fgpp.h>
+#include <dd/support_cache.h>
 
 #include <algorithm>
 #include <sstream>
@@ -172,12 +173,9 @@ namespace {
         m_varsToBeProjectedOn.push_back(one);
         auto lastIndex = m_varsToBeProjectedOn->size() - 1;
         BddWrapper equalityFactor = one;
-        BddWrapper nfSup = factor.support();
-        while (nfSup != one)
+        for (auto index: dd::supportVars(m_manager, factor.getUncountedBdd()).indices())
         {
-          // get nextVar from support and remove it from support
-          BddWrapper nextVar = nfSup.varWithLowestIndex();
-          nfSup = nfSup.cubeDiff(nextVar);
+          BddWrapper nextVar(bdd_new_var_with_index(m_manager, index), m_manager);
 
           // skip q
           if (nextVar == m_q)
@@ -235,18 +233,13 @@ namespace {
       BddVectorWrapper getQuantifiedVars() const
       {
         BddVectorWrapper result(m_manager);
-        BddWrapper allVariables(bdd_one(m_manager), m_manager);
+        dd::VarSet allVariables;
         for (int ifactor = 0; ifactor < m_newFactors->size(); ++ifactor)
-          allVariables = allVariables.cubeUnion(m_newFactors.get(ifactor).support());
+          allVariables |= dd::supportVars(m_manager, m_newFactors->at(ifactor));
         for (int iv = 0; iv < m_varsToBeProjectedOn->size(); ++iv)
-          allVariables = allVariables.cubeDiff(m_varsToBeProjectedOn.get(iv));
-        BddWrapper one = allVariables.one();
-        while(allVariables != one)
-        {
-          auto next = allVariables.varWithLowestIndex();
-          result.push_back(next);
-          allVariables = allVariables.cubeDiff(next);
-        }
+          allVariables -= dd::VarSet::fromCube(m_manager, m_varsToBeProjectedOn->at(iv));
+        for (auto index: allVariables.indices())
+          result.push_back(BddWrapper(bdd_new_var_with_index(m_manager, index), m_manager));
         return result;
       }
 
@@ -328,18 +321,15 @@ namespace {
 
 #ifdef DEBUG_VAR_SCORE
         vsq.printState();
-        auto exactAns = BddWrapper(bdd_one(q.getManager()), q.getManager());
-        auto earlyQuantificationAns = exactAns;
         std::set<BddWrapper> neighborsWithQRemoved;
         for (const auto & qn: qneigh)
         {
-          exactAns = exactAns * qn;
           auto n = qn.existentialQuantification(q);
           neighborsWithQRemoved.insert(n);
           blif_solve_log(INFO, "neighbor " << qn.getUncountedBdd() << " has " << n.countMinterms() << " minterms once q is quantified out.");
-          earlyQuantificationAns = earlyQuantificationAns * n;
         }
-        exactAns = exactAns.existentialQuantification(q);
+        auto exactAns = dd::conjoinAll(manager, std::vector<BddWrapper>(qneigh.cbegin(), qneigh.cend())).existentialQuantification(q);
+        auto earlyQuantificationAns = dd::conjoinAll(manager, std::vector<BddWrapper>(neighborsWithQRemoved.cbegin(), neighborsWithQRemoved.cend()));
 #endif
 
         auto factors = vsq.getFactorCopies();
@@ -418,7 +408,7 @@ namespace {
         // collect messages, reverse substitute, and insert into vsq
         std::vector<BddWrapper> messageVec;
 #ifdef DEBUG_VAR_SCORE
-        BddWrapper fgAns = q.one();
+        std::vector<BddWrapper> fgMessages;
 #endif
         for (auto vtbg: *varsToBeProjectedOn)
         {
@@ -435,12 +425,13 @@ namespace {
               blif_solve_log(INFO, "message " << im << " is the same as a neighbor with Q removed");
             blif_solve_log(INFO, "message " << im << " has " << finalFactor.countMinterms() << " minterms");
             blif_solve_log(INFO, "message " << im << " has support set " << printSupportSet(finalFactor));
-            fgAns = fgAns * finalFactor;
+            fgMessages.push_back(finalFactor);
 #endif
             vsq.addFactor(finalFactor);
           }
         }
 #ifdef DEBUG_VAR_SCORE
+        auto fgAns = dd::conjoinAll(manager, std::move(fgMessages));
         blif_solve_log(INFO, "num terms for exact answer           = " << exactAns.countMinterms());
         blif_solve_log(INFO, "num terms for earlyQuantificationAns = " << earlyQuantificationAns.countMinterms());
         blif_solve_log(INFO, "num terms for factorGraphAns         = " << fgAns.countMinterms());
@@ -452,17 +443,11 @@ namespace {
       static int findLargestIndex(const std::vector<BddWrapper> & factors, DdManager* manager)
       {
         int largestIndex = 0;
-        BddWrapper one(bdd_one(manager), manager);
-        for (const auto f: factors)
+        for (const auto & f: factors)
         {
-          BddWrapper sup = f.support();
-          while (sup != one)
-          {
-            int idx = bdd_get_lowest_index(manager, sup.getUncountedBdd());
-            BddWrapper v(bdd_new_var_with_index(manager, idx), manager);
-            largestIndex = std::max(largestIndex, idx);
-            sup = sup.cubeDiff(v);
-          }
+          auto sup = dd::supportVars(manager, f.getUncountedBdd()).indices();
+          if (!sup.empty())
+            largestIndex = std::max(largestIndex, sup.back());
         }
         return largestIndex;
       }
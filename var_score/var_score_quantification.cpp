@@ -28,6 +28,7 @@ SOFTWARE.
 #include <blif_solve_lib/log.h>
 #include <factor_graph/srt.h>
 #include <blif_solve_lib/approx_merge.h>
+#include <dd/support_cache.h>
 
 #include <memory>
 #include <algorithm>
@@ -210,13 +211,10 @@ namespace var_score {
     if (m_factors.count(factor) > 0)
       return;
     m_factors.insert(factor);
-    BddWrapper fsup = factor.support();
-    BddWrapper one(bdd_one(m_ddm), m_ddm);
+    auto fsup = dd::supportVars(m_ddm, factor.getUncountedBdd());
     for(auto& vxfs: m_vars)
     {
-      BddWrapper q = vxfs.first;
-      BddWrapper intersection = q.cubeIntersection(fsup);
-      if (intersection != one)
+      if (fsup.intersects(dd::supportVars(m_ddm, vxfs.first.getUncountedBdd())))
         vxfs.second.insert(factor);
     }
   }
@@ -311,11 +309,9 @@ namespace var_score {
 
   bool VarScoreQuantification::isNeighbor(const BddWrapper & f, const BddWrapper & g) const
   {
-    auto fsup = f.support();
-    auto gsup = g.support();
-    auto common = fsup.cubeIntersection(gsup);
-    bool isNotNeighbor = bdd_is_one(m_ddm, common.getUncountedBdd());
-    return ! isNotNeighbor;
+    auto fsup = dd::supportVars(m_ddm, f.getUncountedBdd());
+    auto gsup = dd::supportVars(m_ddm, g.getUncountedBdd());
+    return fsup.intersects(gsup);
   }
 
 
@@ -367,16 +363,14 @@ namespace {
   double getBddSize(DdManager * manager, const BddWrapper & b1, const BddWrapper & b2)
   {
     // support sets
-    BddWrapper sp1 = b1.support();
-    BddWrapper sp2 = b2.support();
-    // intersection support set
-    BddWrapper intsn = sp1.cubeIntersection(sp2);
+    auto sp1 = dd::supportVars(manager, b1.getUncountedBdd());
+    auto sp2 = dd::supportVars(manager, b2.getUncountedBdd());
 
     double nb1 = bdd_size(b1.getUncountedBdd());
     double nb2 = bdd_size(b2.getUncountedBdd());
-    double nsp1 = bdd_size(sp1.getUncountedBdd()) - 1;
-    double nsp2 = bdd_size(sp2.getUncountedBdd()) - 1;
-    double nintsn = bdd_size(intsn.getUncountedBdd()) - 1;
+    double nsp1 = sp1.size();
+    double nsp2 = sp2.size();
+    double nintsn = sp1.intersectionSize(sp2);
 
     return 
       nb1 * (nsp1 - nintsn) / nsp1                  // vars unique to b1